@@ -13,8 +13,8 @@
 
 namespace AudioCore::Codec {
 
-StereoBuffer16 DecodeADPCM(const u8* const data, const std::size_t sample_count,
-                           const std::array<s16, 16>& adpcm_coeff, ADPCMState& state) {
+void DecodeADPCM(const u8* const data, const std::size_t sample_count,
+                 const std::array<s16, 16>& adpcm_coeff, ADPCMState& state, StereoBuffer16& out) {
     // GC-ADPCM with scale factor and variable coefficients.
     // Frames are 8 bytes long containing 14 samples each.
     // Samples are 4 bits (one nibble) long.
@@ -27,7 +27,9 @@ StereoBuffer16 DecodeADPCM(const u8* const data, const std::size_t sample_count,
 
     const std::size_t ret_size =
         sample_count % 2 == 0 ? sample_count : sample_count + 1; // Ensure multiple of two.
-    StereoBuffer16 ret(ret_size);
+    const std::size_t offset = out.size();
+    out.resize(offset + ret_size);
+    const auto ret = out.begin() + offset;
 
     int yn1 = state.yn1, yn2 = state.yn2;
 
@@ -75,19 +77,19 @@ StereoBuffer16 DecodeADPCM(const u8* const data, const std::size_t sample_count,
 
     state.yn1 = static_cast<s16>(yn1);
     state.yn2 = static_cast<s16>(yn2);
-
-    return ret;
 }
 
-StereoBuffer16 DecodePCM8(const unsigned num_channels, const u8* const data,
-                          const std::size_t sample_count) {
+void DecodePCM8(const unsigned num_channels, const u8* const data, const std::size_t sample_count,
+                StereoBuffer16& out) {
     ASSERT(num_channels == 1 || num_channels == 2);
 
     const auto decode_sample = [](u8 sample) {
         return static_cast<s16>(static_cast<u16>(sample) << 8);
     };
 
-    StereoBuffer16 ret(sample_count);
+    const std::size_t offset = out.size();
+    out.resize(offset + sample_count);
+    const auto ret = out.begin() + offset;
 
     if (num_channels == 1) {
         for (std::size_t i = 0; i < sample_count; i++) {
@@ -99,15 +101,15 @@ StereoBuffer16 DecodePCM8(const unsigned num_channels, const u8* const data,
             ret[i][1] = decode_sample(data[i * 2 + 1]);
         }
     }
-
-    return ret;
 }
 
-StereoBuffer16 DecodePCM16(const unsigned num_channels, const u8* const data,
-                           const std::size_t sample_count) {
+void DecodePCM16(const unsigned num_channels, const u8* const data, const std::size_t sample_count,
+                 StereoBuffer16& out) {
     ASSERT(num_channels == 1 || num_channels == 2);
 
-    StereoBuffer16 ret(sample_count);
+    const std::size_t offset = out.size();
+    out.resize(offset + sample_count);
+    const auto ret = out.begin() + offset;
 
     if (num_channels == 1) {
         for (std::size_t i = 0; i < sample_count; i++) {
@@ -115,12 +117,9 @@ StereoBuffer16 DecodePCM16(const unsigned num_channels, const u8* const data,
             std::memcpy(&sample, data + i * sizeof(s16), sizeof(s16));
             ret[i].fill(sample);
         }
-    } else {
-        for (std::size_t i = 0; i < sample_count; ++i) {
-            std::memcpy(&ret[i], data + i * sizeof(s16) * 2, 2 * sizeof(s16));
-        }
+    } else if (sample_count != 0) {
+        // The samples are already interleaved like the output
+        std::memcpy(&ret[0], data, sample_count * sizeof(s16) * 2);
     }
-
-    return ret;
 }
 } // namespace AudioCore::Codec
@@ -2,12 +2,43 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <mutex>
 #include <neaacdec.h>
 #include "audio_core/hle/aac_decoder.h"
+#include "common/hash.h"
+#include "common/static_lru_cache.h"
 
 namespace AudioCore::HLE {
 
+// Requests usually hold a single frame of 1024 samples per channel
+constexpr std::size_t RESERVED_SAMPLES = 4096;
+// Shared by every emulator instance in the process
+constexpr std::size_t CACHE_SIZE = 256;
+
+struct AACDecoder::SharedCache {
+    std::mutex mutex;
+    Common::StaticLRUCache<u64, DecodedAAC, CACHE_SIZE> entries;
+};
+
+AACDecoder::SharedCache& AACDecoder::GetSharedCache() {
+    static SharedCache cache;
+    return cache;
+}
+
+void AACDecoder::CopyDecoded(const DecodedAAC& src, DecodedAAC& dst) {
+    for (std::size_t ch = 0; ch < dst.out_streams.size(); ch++) {
+        dst.out_streams[ch].assign(src.out_streams[ch].begin(), src.out_streams[ch].end());
+    }
+    dst.sample_rate = src.sample_rate;
+    dst.num_channels = src.num_channels;
+}
+
 AACDecoder::AACDecoder(Memory::MemorySystem& memory) : memory(memory) {
+    for (auto& stream : scratch.out_streams) {
+        stream.reserve(RESERVED_SAMPLES);
+    }
+
     decoder = NeAACDecOpen();
     if (decoder == nullptr) {
         LOG_CRITICAL(Audio_DSP, "Could not open FAAD2 decoder.");
@@ -99,45 +130,43 @@ BinaryMessage AACDecoder::Decode(const BinaryMessage& request) {
                   request.decode_aac_request.src_addr);
         return response;
     }
-    u8* data = memory.GetFCRAMPointer(request.decode_aac_request.src_addr - Memory::FCRAM_PADDR);
-    u32 data_len = request.decode_aac_request.size;
-
-    unsigned long sample_rate;
-    u8 num_channels;
-    auto init_result = NeAACDecInit(decoder, data, data_len, &sample_rate, &num_channels);
-    if (init_result < 0) {
-        LOG_ERROR(Audio_DSP, "Could not initialize FAAD2 AAC decoder for request: {}", init_result);
-        return response;
+    const u8* data =
+        memory.GetFCRAMPointer(request.decode_aac_request.src_addr - Memory::FCRAM_PADDR);
+    const u32 data_len = request.decode_aac_request.size;
+
+    const u64 data_hash = Common::ComputeHash64(data, data_len);
+    const u64 key = Common::HashCombine(previous_hash, data_hash);
+
+    auto& shared_cache = GetSharedCache();
+    bool cached = false;
+    {
+        std::scoped_lock lock{shared_cache.mutex};
+        if (shared_cache.entries.contains(key)) {
+            CopyDecoded(shared_cache.entries.request(key).second, scratch);
+            cached = true;
+        }
+    }
+    if (!cached) {
+        // Bring FAAD2 into the state it would be in had the previous request not been a cache hit
+        if (decoder_hash != previous_hash && !previous_data.empty()) {
+            DecodeData(previous_data.data(), static_cast<u32>(previous_data.size()), scratch);
+        }
+        decoder_hash = data_hash;
     }
 
-    // Advance past the frame header if needed.
-    data += init_result;
-    data_len -= init_result;
-
-    std::array<std::vector<s16>, 2> out_streams;
+    previous_data.assign(data, data + data_len);
+    previous_hash = data_hash;
 
-    while (data_len > 0) {
-        NeAACDecFrameInfo frame_info;
-        auto curr_sample_buffer =
-            static_cast<s16*>(NeAACDecDecode(decoder, &frame_info, data, data_len));
-        if (curr_sample_buffer == nullptr || frame_info.error != 0) {
-            LOG_ERROR(Audio_DSP, "Failed to decode AAC buffer using FAAD2: {}", frame_info.error);
+    if (!cached) {
+        if (!DecodeData(data, data_len, scratch)) {
             return response;
         }
-
-        // Split the decode result into channels.
-        u32 num_samples = frame_info.samples / frame_info.channels;
-        for (u32 sample = 0; sample < num_samples; sample++) {
-            for (u32 ch = 0; ch < frame_info.channels; ch++) {
-                out_streams[ch].push_back(curr_sample_buffer[(sample * frame_info.channels) + ch]);
-            }
-        }
-
-        data += frame_info.bytesconsumed;
-        data_len -= frame_info.bytesconsumed;
+        std::scoped_lock lock{shared_cache.mutex};
+        CopyDecoded(scratch, shared_cache.entries.request(key).second);
     }
 
     // Transfer the decoded buffer from vector to the FCRAM.
+    const auto& out_streams = scratch.out_streams;
     for (std::size_t ch = 0; ch < out_streams.size(); ch++) {
         if (out_streams[ch].empty()) {
             continue;
@@ -155,11 +184,58 @@ BinaryMessage AACDecoder::Decode(const BinaryMessage& request) {
     }
 
     // Set the output frame info.
-    response.decode_aac_response.sample_rate = GetSampleRateEnum(sample_rate);
-    response.decode_aac_response.num_channels = num_channels;
+    response.decode_aac_response.sample_rate = GetSampleRateEnum(scratch.sample_rate);
+    response.decode_aac_response.num_channels = scratch.num_channels;
     response.decode_aac_response.num_samples = static_cast<u32_le>(out_streams[0].size());
 
     return response;
 }
 
+bool AACDecoder::DecodeData(const u8* data, u32 data_len, DecodedAAC& decoded) {
+    for (auto& stream : decoded.out_streams) {
+        stream.clear();
+    }
+
+    // FAAD2 takes non-const pointers but does not write through them
+    u8* input = const_cast<u8*>(data);
+    auto init_result =
+        NeAACDecInit(decoder, input, data_len, &decoded.sample_rate, &decoded.num_channels);
+    if (init_result < 0) {
+        LOG_ERROR(Audio_DSP, "Could not initialize FAAD2 AAC decoder for request: {}", init_result);
+        return false;
+    }
+
+    // Advance past the frame header if needed.
+    input += init_result;
+    data_len -= init_result;
+
+    while (data_len > 0) {
+        NeAACDecFrameInfo frame_info;
+        auto curr_sample_buffer =
+            static_cast<s16*>(NeAACDecDecode(decoder, &frame_info, input, data_len));
+        if (curr_sample_buffer == nullptr || frame_info.error != 0) {
+            LOG_ERROR(Audio_DSP, "Failed to decode AAC buffer using FAAD2: {}", frame_info.error);
+            return false;
+        }
+
+        // Split the decode result into channels.
+        const u32 num_samples = frame_info.samples / frame_info.channels;
+        const u32 num_channels =
+            std::min<u32>(frame_info.channels, static_cast<u32>(decoded.out_streams.size()));
+        for (u32 ch = 0; ch < num_channels; ch++) {
+            auto& stream = decoded.out_streams[ch];
+            const std::size_t offset = stream.size();
+            stream.resize(offset + num_samples);
+            for (u32 sample = 0; sample < num_samples; sample++) {
+                stream[offset + sample] = curr_sample_buffer[(sample * frame_info.channels) + ch];
+            }
+        }
+
+        input += frame_info.bytesconsumed;
+        data_len -= frame_info.bytesconsumed;
+    }
+
+    return true;
+}
+
 } // namespace AudioCore::HLE
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <array>
+#include <vector>
 #include "audio_core/hle/decoder.h"
 
 namespace AudioCore::HLE {
@@ -17,10 +19,36 @@ public:
     BinaryMessage ProcessRequest(const BinaryMessage& request) override;
 
 private:
+    struct DecodedAAC {
+        std::array<std::vector<s16>, 2> out_streams;
+        unsigned long sample_rate;
+        u8 num_channels;
+    };
+
+    /**
+     * Decoded requests keyed by a hash of their data and the data of the previous request. FAAD2
+     * carries the overlap of the last frame into the next decode, so the same data only decodes
+     * to the same samples after the same predecessor. The cache is shared by all decoders of the
+     * process, so it survives the DSP being recreated when a state is loaded.
+     */
+    struct SharedCache;
+    static SharedCache& GetSharedCache();
+    static void CopyDecoded(const DecodedAAC& src, DecodedAAC& dst);
+
     BinaryMessage Decode(const BinaryMessage& request);
 
+    /// Runs FAAD2 over the data, returns false if it could not be decoded.
+    bool DecodeData(const u8* data, u32 data_len, DecodedAAC& decoded);
+
     Memory::MemorySystem& memory;
     NeAACDecHandle decoder = nullptr;
+
+    DecodedAAC scratch;
+    /// Data of the last request which reached the decoder, and its hash
+    std::vector<u8> previous_data;
+    u64 previous_hash = 0;
+    /// Hash of the data FAAD2 decoded last, which differs from previous_hash after cache hits
+    u64 decoder_hash = 0;
 };
 
 } // namespace AudioCore::HLE
@@ -190,6 +190,10 @@ void Mixers::MixCurrentFrame() {
     // TODO(SachinV): This is probably not accurate, based on symbols from FE:Fates,
     // state.intermediate_mixer_volume[0] represents the master volume
     for (std::size_t mix = 0; mix < 3; mix++) {
+        // A muted mix would leave the frame unchanged
+        if (state.intermediate_mixer_volume[mix] == 0.0f) {
+            continue;
+        }
         DownmixAndMixIntoCurrentFrame(state.intermediate_mixer_volume[mix],
                                       state.intermediate_mix_buffer[mix]);
     }
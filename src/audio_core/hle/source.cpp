@@ -4,14 +4,22 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include "audio_core/codec.h"
 #include "audio_core/hle/common.h"
 #include "audio_core/hle/source.h"
 #include "audio_core/interpolate.h"
+#include "common/arch.h"
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "core/memory.h"
 
+#if ENCORE_ARCH(x86_64)
+#include <emmintrin.h>
+#elif ENCORE_ARCH(arm64)
+#include <arm_neon.h>
+#endif
+
 namespace AudioCore::HLE {
 
 SourceStatus::Status Source::Tick(SourceConfiguration::Configuration& config,
@@ -30,13 +38,45 @@ void Source::MixInto(QuadFrame32& dest, std::size_t intermediate_mix_id) const {
         return;
 
     const std::array<float, 4>& gains = state.gain.at(intermediate_mix_id);
+    // Sources usually only feed some of the intermediate mixes, the others would only get zeroes
+    if (gains == std::array<float, 4>{}) {
+        return;
+    }
+
+    // Conversion from stereo (current_frame) to quadraphonic (dest) occurs here.
+    // The SIMD paths process the four channels of a sample together, with the same rounding and
+    // truncation as the scalar code.
+#if ENCORE_ARCH(x86_64)
+    const __m128 gain = _mm_loadu_ps(gains.data());
+    for (std::size_t samplei = 0; samplei < samples_per_frame; samplei++) {
+        s32 stereo;
+        std::memcpy(&stereo, current_frame[samplei].data(), sizeof(stereo));
+        // {left, right, left, right}, sign extended to 32 bits
+        const __m128i pair = _mm_cvtsi32_si128(stereo);
+        const __m128i quad = _mm_unpacklo_epi32(pair, pair);
+        const __m128i samples = _mm_srai_epi32(_mm_unpacklo_epi16(quad, quad), 16);
+        const __m128i mixed = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(samples), gain));
+        auto* out = reinterpret_cast<__m128i*>(dest[samplei].data());
+        _mm_storeu_si128(out, _mm_add_epi32(_mm_loadu_si128(out), mixed));
+    }
+#elif ENCORE_ARCH(arm64)
+    const float32x4_t gain = vld1q_f32(gains.data());
+    for (std::size_t samplei = 0; samplei < samples_per_frame; samplei++) {
+        s32 stereo;
+        std::memcpy(&stereo, current_frame[samplei].data(), sizeof(stereo));
+        const int32x4_t samples = vmovl_s16(vreinterpret_s16_s32(vdup_n_s32(stereo)));
+        const int32x4_t mixed = vcvtq_s32_f32(vmulq_f32(vcvtq_f32_s32(samples), gain));
+        s32* out = dest[samplei].data();
+        vst1q_s32(out, vaddq_s32(vld1q_s32(out), mixed));
+    }
+#else
     for (std::size_t samplei = 0; samplei < samples_per_frame; samplei++) {
-        // Conversion from stereo (current_frame) to quadraphonic (dest) occurs here.
         dest[samplei][0] += static_cast<s32>(gains[0] * current_frame[samplei][0]);
         dest[samplei][1] += static_cast<s32>(gains[1] * current_frame[samplei][1]);
         dest[samplei][2] += static_cast<s32>(gains[2] * current_frame[samplei][0]);
         dest[samplei][3] += static_cast<s32>(gains[3] * current_frame[samplei][1]);
     }
+#endif
 }
 
 void Source::Reset() {
@@ -196,7 +236,8 @@ void Source::ParseConfig(SourceConfiguration::Configuration& config,
                 // state.current_buffer = Codec::DecodePCM8(num_channels, memory, config.length);
                 break;
             case Format::PCM16:
-                state.current_buffer = Codec::DecodePCM16(num_channels, memory, config.length);
+                ClearCurrentBuffer();
+                Codec::DecodePCM16(num_channels, memory, config.length, state.current_buffer);
                 valid = true;
                 break;
             case Format::ADPCM:
@@ -212,21 +253,19 @@ void Source::ParseConfig(SourceConfiguration::Configuration& config,
                 break;
             }
 
-            // Again, because our interpolation consumes samples instead of using an index, let's
-            // just re-consume the samples up to the current sample number. There may be some
-            // imprecision here with the current sample number, as Detective Pikachu sounds a little
-            // rough at times.
+            // Again, because our interpolation consumes samples, let's just re-consume the samples
+            // up to the current sample number. There may be some imprecision here with the current
+            // sample number, as Detective Pikachu sounds a little rough at times.
             if (valid) {
 
                 // TODO(xperia64): Tomodachi life apparently can decrease config.length when the
                 // user skips dialog. I don't know the correct behavior, but to avoid crashing, just
                 // reset the current sample number to 0 and don't try to truncate the buffer
-                if (state.current_buffer.size() < state.current_sample_number) {
+                if (state.current_buffer.size() - state.current_buffer_position <
+                    state.current_sample_number) {
                     state.current_sample_number = 0;
                 } else {
-                    state.current_buffer.erase(
-                        state.current_buffer.begin(),
-                        std::next(state.current_buffer.begin(), state.current_sample_number));
+                    state.current_buffer_position += state.current_sample_number;
                 }
             }
         }
@@ -321,7 +360,7 @@ void Source::ParseConfig(SourceConfiguration::Configuration& config,
 void Source::GenerateFrame() {
     current_frame.fill({});
 
-    if (state.current_buffer.empty()) {
+    if (IsCurrentBufferEmpty()) {
         // TODO(SachinV): Should dequeue happen at the end of the frame generation?
         if (DequeueBuffer()) {
             return;
@@ -335,23 +374,26 @@ void Source::GenerateFrame() {
 
     std::size_t frame_position = 0;
     while (frame_position < current_frame.size()) {
-        if (state.current_buffer.empty() && !DequeueBuffer()) {
+        if (IsCurrentBufferEmpty() && !DequeueBuffer()) {
             break;
         }
 
         switch (state.interpolation_mode) {
         case InterpolationMode::None:
-            AudioInterp::None(state.interp_state, state.current_buffer, state.rate_multiplier,
-                              current_frame, frame_position);
+            AudioInterp::None(state.interp_state, state.current_buffer,
+                              state.current_buffer_position, state.rate_multiplier, current_frame,
+                              frame_position);
             break;
         case InterpolationMode::Linear:
-            AudioInterp::Linear(state.interp_state, state.current_buffer, state.rate_multiplier,
-                                current_frame, frame_position);
+            AudioInterp::Linear(state.interp_state, state.current_buffer,
+                                state.current_buffer_position, state.rate_multiplier, current_frame,
+                                frame_position);
             break;
         case InterpolationMode::Polyphase:
             // TODO(merry): Implement polyphase interpolation
-            AudioInterp::Linear(state.interp_state, state.current_buffer, state.rate_multiplier,
-                                current_frame, frame_position);
+            AudioInterp::Linear(state.interp_state, state.current_buffer,
+                                state.current_buffer_position, state.rate_multiplier, current_frame,
+                                frame_position);
             break;
         default:
             UNIMPLEMENTED();
@@ -366,8 +408,7 @@ void Source::GenerateFrame() {
 }
 
 bool Source::DequeueBuffer() {
-    ASSERT_MSG(state.current_buffer.empty(),
-               "Shouldn't dequeue; we still have data in current_buffer");
+    ASSERT_MSG(IsCurrentBufferEmpty(), "Shouldn't dequeue; we still have data in current_buffer");
 
     if (state.input_queue.empty())
         return false;
@@ -385,17 +426,18 @@ bool Source::DequeueBuffer() {
     const u8* const memory = memory_system->GetPhysicalPointer(buf.physical_address & 0xFFFFFFFC);
     if (memory) {
         const unsigned num_channels = buf.mono_or_stereo == MonoOrStereo::Stereo ? 2 : 1;
+        ClearCurrentBuffer();
         switch (buf.format) {
         case Format::PCM8:
-            state.current_buffer = Codec::DecodePCM8(num_channels, memory, buf.length);
+            Codec::DecodePCM8(num_channels, memory, buf.length, state.current_buffer);
             break;
         case Format::PCM16:
-            state.current_buffer = Codec::DecodePCM16(num_channels, memory, buf.length);
+            Codec::DecodePCM16(num_channels, memory, buf.length, state.current_buffer);
             break;
         case Format::ADPCM:
             DEBUG_ASSERT(num_channels == 1);
-            state.current_buffer =
-                Codec::DecodeADPCM(memory, buf.length, state.adpcm_coeffs, state.adpcm_state);
+            Codec::DecodeADPCM(memory, buf.length, state.adpcm_coeffs, state.adpcm_state,
+                               state.current_buffer);
             break;
         default:
             UNIMPLEMENTED();
@@ -405,7 +447,7 @@ bool Source::DequeueBuffer() {
         LOG_WARNING(Audio_DSP,
                     "source_id={} buffer_id={} length={}: Invalid physical address {:#010x}",
                     source_id, buf.buffer_id, buf.length, buf.physical_address);
-        state.current_buffer.clear();
+        ClearCurrentBuffer();
         return true;
     }
 
@@ -421,20 +463,31 @@ bool Source::DequeueBuffer() {
         state.input_queue.push(buf);
     }
 
-    // Because our interpolation consumes samples instead of using an index,
-    // let's just consume the samples up to the current sample number.
-    state.current_buffer.erase(
-        state.current_buffer.begin(),
-        std::next(state.current_buffer.begin(), state.current_sample_number));
+    // Because our interpolation consumes samples, let's just consume the samples up to the
+    // current sample number.
+    const std::size_t num_samples = state.current_buffer.size() - state.current_buffer_position;
+    state.current_buffer_position +=
+        std::min<std::size_t>(state.current_sample_number, num_samples);
 
     LOG_TRACE(Audio_DSP,
               "source_id={} buffer_id={} from_queue={} current_buffer.size()={}, "
               "buf.has_played={}, buf.play_position={}",
-              source_id, buf.buffer_id, buf.from_queue, state.current_buffer.size(), buf.has_played,
+              source_id, buf.buffer_id, buf.from_queue,
+              state.current_buffer.size() - state.current_buffer_position, buf.has_played,
               buf.play_position);
     return true;
 }
 
+bool Source::IsCurrentBufferEmpty() const {
+    return state.current_buffer_position >= state.current_buffer.size();
+}
+
+void Source::ClearCurrentBuffer() {
+    // Shrinking keeps the allocation, so decoding the next buffer usually doesn't allocate
+    state.current_buffer.resize(AudioInterp::history_size);
+    state.current_buffer_position = AudioInterp::history_size;
+}
+
 SourceStatus::Status Source::GetCurrentStatus() {
     SourceStatus::Status ret;
 
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <deque>
 #include <vector>
 #include <boost/serialization/array.hpp>
 #include <boost/serialization/deque.hpp>
@@ -116,7 +117,7 @@ private:
         }
     };
 
-    struct {
+    struct State {
 
         // State variables
 
@@ -137,7 +138,10 @@ private:
 
         u32 current_sample_number = 0;
         PAddr current_buffer_physical_address = 0;
-        AudioInterp::StereoBuffer16 current_buffer = {};
+        // Decoded samples are consumed by advancing current_buffer_position, the samples in front
+        // of it are reused by the interpolation for its history
+        StereoBuffer16 current_buffer = {};
+        std::size_t current_buffer_position = AudioInterp::history_size;
 
         // buffer_id state
 
@@ -162,7 +166,7 @@ private:
 
     private:
         template <class Archive>
-        void serialize(Archive& ar, const unsigned int) {
+        void serialize(Archive& ar, const unsigned int file_version) {
             ar & enabled;
             ar & sync_count;
             ar & gain;
@@ -171,7 +175,17 @@ private:
             ar & format;
             ar & current_sample_number;
             ar & current_buffer_physical_address;
-            ar & current_buffer;
+            if (file_version >= 1) {
+                ar & current_buffer;
+                ar & current_buffer_position;
+            } else {
+                // Older states kept the samples in a deque, without the interpolation history
+                std::deque<std::array<s16, 2>> samples;
+                ar & samples;
+                current_buffer.resize(AudioInterp::history_size);
+                current_buffer.insert(current_buffer.end(), samples.begin(), samples.end());
+                current_buffer_position = AudioInterp::history_size;
+            }
             ar & buffer_update;
             ar & current_buffer_id;
             ar & adpcm_coeffs;
@@ -191,6 +205,10 @@ private:
     /// INTERNAL: Dequeues a buffer and does preprocessing on it (decoding, resampling). Puts it
     /// into current_buffer.
     bool DequeueBuffer();
+    /// INTERNAL: Returns true if all samples of current_buffer were consumed.
+    bool IsCurrentBufferEmpty() const;
+    /// INTERNAL: Empties current_buffer, leaving room for the interpolation history.
+    void ClearCurrentBuffer();
     /// INTERNAL: Generates a SourceStatus::Status based on our internal state.
     SourceStatus::Status GetCurrentStatus();
 
@@ -202,3 +220,5 @@ private:
 };
 
 } // namespace AudioCore::HLE
+
+BOOST_CLASS_VERSION(AudioCore::HLE::Source::State, 1)
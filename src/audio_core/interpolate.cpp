@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <span>
 #include "audio_core/interpolate.h"
 #include "common/assert.h"
 
@@ -16,51 +17,77 @@ constexpr u64 scale_mask = scale_factor - 1;
 /// Here we step over the input in steps of rate, until we consume all of the input.
 /// Three adjacent samples are passed to fn each step.
 template <typename Function>
-static void StepOverSamples(State& state, StereoBuffer16& input, float rate, StereoFrame16& output,
-                            std::size_t& outputi, Function fn) {
+static void StepOverSamples(State& state, StereoBuffer16& input, std::size_t& inputi, float rate,
+                            StereoFrame16& output, std::size_t& outputi, Function fn) {
     ASSERT(rate > 0);
+    ASSERT(inputi >= history_size);
 
-    if (input.empty())
+    if (inputi >= input.size())
         return;
 
-    input.insert(input.begin(), {state.xn2, state.xn1});
+    // The history is placed in front of the remaining samples, so they can be read contiguously
+    const std::size_t base = inputi - history_size;
+    input[base] = state.xn2;
+    input[base + 1] = state.xn1;
+    const std::span<const std::array<s16, 2>> samples{input.data() + base, input.size() - base};
 
     const u64 step_size = static_cast<u64>(rate * scale_factor);
     u64 fposition = state.fposition;
-    std::size_t inputi = 0;
+    std::size_t samplei = 0;
+    bool output_full = false;
+
+    if (step_size == scale_factor) {
+        // Without resampling every step uses the same fraction, so the loop doesn't need to
+        // compute positions and can be vectorized
+        const u64 fraction = fposition & scale_mask;
+        const std::size_t first = static_cast<std::size_t>(fposition / scale_factor);
+        const std::size_t available = samples.size() > first + 2 ? samples.size() - first - 2 : 0;
+        const std::size_t count = std::min(output.size() - outputi, available);
+        for (std::size_t i = 0; i < count; i++) {
+            output[outputi + i] =
+                fn(fraction, samples[first + i], samples[first + i + 1], samples[first + i + 2]);
+        }
+        outputi += count;
+        fposition += count * scale_factor;
+        if (count != 0 && outputi == output.size()) {
+            samplei = first + count - 1;
+            output_full = true;
+        }
+    }
 
-    while (outputi < output.size()) {
-        inputi = static_cast<std::size_t>(fposition / scale_factor);
+    while (!output_full && outputi < output.size()) {
+        samplei = static_cast<std::size_t>(fposition / scale_factor);
 
-        if (inputi + 2 >= input.size()) {
-            inputi = input.size() - 2;
+        if (samplei + 2 >= samples.size()) {
+            samplei = samples.size() - 2;
             break;
         }
 
         u64 fraction = fposition & scale_mask;
-        output[outputi++] = fn(fraction, input[inputi], input[inputi + 1], input[inputi + 2]);
+        output[outputi++] =
+            fn(fraction, samples[samplei], samples[samplei + 1], samples[samplei + 2]);
 
         fposition += step_size;
     }
 
-    state.xn2 = input[inputi];
-    state.xn1 = input[inputi + 1];
-    state.fposition = fposition - inputi * scale_factor;
+    state.xn2 = samples[samplei];
+    state.xn1 = samples[samplei + 1];
+    state.fposition = fposition - samplei * scale_factor;
 
-    input.erase(input.begin(), std::next(input.begin(), inputi + 2));
+    inputi = base + samplei + 2;
 }
 
-void None(State& state, StereoBuffer16& input, float rate, StereoFrame16& output,
-          std::size_t& outputi) {
+void None(State& state, StereoBuffer16& input, std::size_t& inputi, float rate,
+          StereoFrame16& output, std::size_t& outputi) {
     StepOverSamples(
-        state, input, rate, output, outputi,
+        state, input, inputi, rate, output, outputi,
         [](u64 fraction, const auto& x0, const auto& x1, const auto& x2) { return x0; });
 }
 
-void Linear(State& state, StereoBuffer16& input, float rate, StereoFrame16& output,
-            std::size_t& outputi) {
+void Linear(State& state, StereoBuffer16& input, std::size_t& inputi, float rate,
+            StereoFrame16& output, std::size_t& outputi) {
     // Note on accuracy: Some values that this produces are +/- 1 from the actual firmware.
-    StepOverSamples(state, input, rate, output, outputi,
+    StepOverSamples(state, input, inputi, rate, output, outputi,
                     [](u64 fraction, const auto& x0, const auto& x1, const auto& x2) {
                         // This is a saturated subtraction. (Verified by black-box fuzzing.)
                         s64 delta0 = std::clamp<s64>(x1[0] - x0[0], -32768, 32767);
@@ -5,14 +5,14 @@
 #pragma once
 
 #include <array>
-#include <deque>
 #include "audio_core/audio_types.h"
 #include "common/common_types.h"
 
 namespace AudioCore::AudioInterp {
 
-/// A variable length buffer of signed PCM16 stereo samples.
-using StereoBuffer16 = std::deque<std::array<s16, 2>>;
+/// Number of samples the interpolators need in front of the read position of their input, where
+/// they place the two historical samples.
+constexpr std::size_t history_size = 2;
 
 struct State {
     /// Two historical samples.
@@ -25,25 +25,29 @@ struct State {
 /**
  * No interpolation. This is equivalent to a zero-order hold. There is a two-sample predelay.
  * @param state Interpolation state.
- * @param input Input buffer.
+ * @param input Input buffer. The history_size samples before inputi are overwritten.
+ * @param inputi The index of input to start reading from, advanced past the consumed samples.
+ *               Must be at least history_size.
  * @param rate Stretch factor. Must be a positive non-zero value.
  *             rate > 1.0 performs decimation and rate < 1.0 performs upsampling.
  * @param output The resampled audio buffer.
  * @param outputi The index of output to start writing to.
  */
-void None(State& state, StereoBuffer16& input, float rate, StereoFrame16& output,
-          std::size_t& outputi);
+void None(State& state, StereoBuffer16& input, std::size_t& inputi, float rate,
+          StereoFrame16& output, std::size_t& outputi);
 
 /**
  * Linear interpolation. This is equivalent to a first-order hold. There is a two-sample predelay.
  * @param state Interpolation state.
- * @param input Input buffer.
+ * @param input Input buffer. The history_size samples before inputi are overwritten.
+ * @param inputi The index of input to start reading from, advanced past the consumed samples.
+ *               Must be at least history_size.
  * @param rate Stretch factor. Must be a positive non-zero value.
  *             rate > 1.0 performs decimation and rate < 1.0 performs upsampling.
  * @param output The resampled audio buffer.
  * @param outputi The index of output to start writing to.
  */
-void Linear(State& state, StereoBuffer16& input, float rate, StereoFrame16& output,
-            std::size_t& outputi);
+void Linear(State& state, StereoBuffer16& input, std::size_t& inputi, float rate,
+            StereoFrame16& output, std::size_t& outputi);
 
 } // namespace AudioCore::AudioInterp
@@ -0,0 +1,488 @@
+// Copyright 2024 Encore Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#ifdef __linux__
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "common/assert.h"
+#include "common/host_memory.h"
+#include "common/logging/log.h"
+
+namespace Common {
+
+#ifdef __linux__
+
+struct HostMemory::Tracker {
+    explicit Tracker(std::size_t size)
+        : page_size{static_cast<std::size_t>(sysconf(_SC_PAGESIZE))}, num_pages{size / page_size},
+          claimed{std::make_unique<std::atomic<u64>[]>((num_pages + 63) / 64)},
+          written{std::make_unique<std::atomic<u64>[]>((num_pages + 63) / 64)} {
+        // Only the pages saved on their first write take up memory
+        void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (ptr != MAP_FAILED) {
+            saved = static_cast<u8*>(ptr);
+        }
+    }
+
+    ~Tracker() {
+        if (saved) {
+            munmap(saved, num_pages * page_size);
+        }
+    }
+
+    void Reset() {
+        madvise(saved, num_pages * page_size, MADV_DONTNEED);
+        for (std::size_t i = 0; i < (num_pages + 63) / 64; i++) {
+            claimed[i].store(0, std::memory_order_relaxed);
+            written[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    bool IsWritten(std::size_t page) const {
+        return (written[page / 64].load(std::memory_order_acquire) >> (page % 64)) & 1;
+    }
+
+    /// Returns true for the first claim of the page, whose claimer has to save it
+    bool Claim(std::size_t page) {
+        const u64 bit = u64{1} << (page % 64);
+        return !(claimed[page / 64].fetch_or(bit, std::memory_order_acq_rel) & bit);
+    }
+
+    void SetWritten(std::size_t page) {
+        written[page / 64].fetch_or(u64{1} << (page % 64), std::memory_order_release);
+    }
+
+    std::size_t page_size;
+    std::size_t num_pages;
+    /// Contents of the pages from before their first write
+    u8* saved{};
+    /// Pages whose contents are being or have been saved
+    std::unique_ptr<std::atomic<u64>[]> claimed;
+    /// Pages whose contents have been saved
+    std::unique_ptr<std::atomic<u64>[]> written;
+};
+
+namespace {
+
+/// Memories which are tracking writes, looked up by the fault handler without taking locks
+std::array<std::atomic<HostMemory*>, 16> tracked_memories{};
+
+struct sigaction previous_fault_action {};
+
+} // Anonymous namespace
+
+HostMemory::HostMemory(std::size_t size_) : size{size_} {
+    fd = memfd_create("encore_memory", MFD_CLOEXEC);
+    if (fd != -1 && ftruncate(fd, static_cast<off_t>(size)) == 0) {
+        void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (ptr != MAP_FAILED) {
+            base = static_cast<u8*>(ptr);
+            return;
+        }
+    }
+
+    LOG_WARNING(Common_Memory, "Failed to create shared host memory, falling back to a buffer");
+    if (fd != -1) {
+        close(fd);
+        fd = -1;
+    }
+    fallback = std::make_unique<u8[]>(size);
+    base = fallback.get();
+}
+
+HostMemory::~HostMemory() {
+    StopTracking();
+    if (fd != -1) {
+        munmap(base, size);
+        close(fd);
+    }
+}
+
+bool HostMemory::Fork() {
+    if (!SupportsViews()) {
+        return false;
+    }
+
+    if (!forked) {
+        // Unwritten pages of a private mapping are read from the shared memory, so this is free
+        MapPrivate(0, size);
+        if (tracker) {
+            ProtectUnwritten(0, size);
+        }
+        forked = true;
+        return true;
+    }
+
+    // Pages written since the last snapshot are moved into the shared memory, after which their
+    // private copies can be dropped
+    const auto runs = GetDirtyRuns();
+    WriteBack(runs);
+    for (const auto& [offset, length] : runs) {
+        MapPrivate(offset, length);
+        if (tracker) {
+            ProtectUnwritten(offset, length);
+        }
+    }
+    return true;
+}
+
+void HostMemory::RestoreFork() {
+    ASSERT(forked);
+    for (const auto& [offset, length] : GetDirtyRuns()) {
+        // Reverting changes the contents without writing to them
+        if (tracker) {
+            MarkWritten(offset, length);
+        }
+        MapPrivate(offset, length);
+    }
+}
+
+void HostMemory::DropFork() {
+    ASSERT(forked);
+    WriteBack(GetDirtyRuns());
+    void* ptr = mmap(base, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+    ASSERT_MSG(ptr != MAP_FAILED, "Failed to map shared host memory");
+    if (tracker) {
+        ProtectUnwritten(0, size);
+    }
+    forked = false;
+}
+
+bool HostMemory::StartTracking() {
+    if (!SupportsViews()) {
+        return false;
+    }
+
+    if (tracker) {
+        tracker->Reset();
+    } else {
+        auto new_tracker = std::make_unique<Tracker>(size);
+        if (!new_tracker->saved) {
+            LOG_WARNING(Common_Memory, "Failed to reserve memory for tracking writes");
+            return false;
+        }
+        InstallFaultHandler();
+        tracker = std::move(new_tracker);
+        const auto slot = std::find_if(tracked_memories.begin(), tracked_memories.end(),
+                                       [this](auto& memory) {
+                                           HostMemory* expected = nullptr;
+                                           return memory.compare_exchange_strong(expected, this);
+                                       });
+        if (slot == tracked_memories.end()) {
+            LOG_WARNING(Common_Memory, "Too many memories are tracking writes");
+            tracker.reset();
+            return false;
+        }
+    }
+
+    ProtectUnwritten(0, size);
+    return true;
+}
+
+void HostMemory::StopTracking() {
+    if (!tracker) {
+        return;
+    }
+
+    const int result = mprotect(base, size, PROT_READ | PROT_WRITE);
+    ASSERT_MSG(result == 0, "Failed to unprotect host memory");
+    for (auto& memory : tracked_memories) {
+        HostMemory* expected = this;
+        memory.compare_exchange_strong(expected, nullptr);
+    }
+    tracker.reset();
+}
+
+bool HostMemory::IsWritten(std::size_t offset) const {
+    return tracker && tracker->IsWritten(offset / tracker->page_size);
+}
+
+std::vector<HostMemory::Run> HostMemory::GetWrittenRuns(std::size_t offset,
+                                                        std::size_t length) const {
+    std::vector<Run> runs;
+    if (!tracker) {
+        return runs;
+    }
+
+    // Words without written pages are skipped as a whole, so this is cheap for sparse writes
+    const std::size_t page_size = tracker->page_size;
+    const std::size_t end_page = (offset + length) / page_size;
+    std::size_t page = offset / page_size;
+    while (page < end_page) {
+        const u64 word =
+            tracker->written[page / 64].load(std::memory_order_acquire) >> (page % 64);
+        if (word == 0) {
+            page += 64 - page % 64;
+            continue;
+        }
+        page += static_cast<std::size_t>(std::countr_zero(word));
+        if (page >= end_page) {
+            break;
+        }
+
+        const std::size_t page_offset = page * page_size;
+        if (!runs.empty() && runs.back().first + runs.back().second == page_offset) {
+            runs.back().second += page_size;
+        } else {
+            runs.emplace_back(page_offset, page_size);
+        }
+        page++;
+    }
+    return runs;
+}
+
+const u8* HostMemory::TrackedPointer() const {
+    return tracker ? tracker->saved : nullptr;
+}
+
+void HostMemory::InstallFaultHandler() {
+    // Handlers installed later, like the JIT's, pass on the faults they don't handle to this one
+    static std::once_flag installed;
+    std::call_once(installed, [] {
+        struct sigaction action {};
+        action.sa_flags = SA_SIGINFO;
+        sigemptyset(&action.sa_mask);
+        action.sa_sigaction = [](int sig, siginfo_t* info, void* raw_context) {
+            if (info->si_code == SEGV_ACCERR) {
+                const int saved_errno = errno;
+                const auto* address = static_cast<const u8*>(info->si_addr);
+                for (auto& slot : tracked_memories) {
+                    HostMemory* memory = slot.load(std::memory_order_acquire);
+                    if (memory && memory->HandleWriteFault(address)) {
+                        errno = saved_errno;
+                        return;
+                    }
+                }
+                errno = saved_errno;
+            }
+
+            if (previous_fault_action.sa_flags & SA_SIGINFO) {
+                previous_fault_action.sa_sigaction(sig, info, raw_context);
+            } else if (previous_fault_action.sa_handler == SIG_DFL) {
+                // Returning retries the access, which then takes the default action
+                sigaction(sig, &previous_fault_action, nullptr);
+            } else if (previous_fault_action.sa_handler != SIG_IGN) {
+                previous_fault_action.sa_handler(sig);
+            }
+        };
+        const int result = sigaction(SIGSEGV, &action, &previous_fault_action);
+        ASSERT_MSG(result == 0, "Failed to install the write fault handler");
+    });
+}
+
+bool HostMemory::HandleWriteFault(const u8* address) {
+    if (address < base || address >= base + size) {
+        return false;
+    }
+
+    // Only the first thread to fault on the page saves it, any other one retries the write
+    // until it's unprotected
+    const std::size_t page_size = tracker->page_size;
+    const std::size_t page = static_cast<std::size_t>(address - base) / page_size;
+    if (tracker->Claim(page)) {
+        u8* const page_pointer = base + page * page_size;
+        std::memcpy(tracker->saved + page * page_size, page_pointer, page_size);
+        tracker->SetWritten(page);
+        mprotect(page_pointer, page_size, PROT_READ | PROT_WRITE);
+    }
+    return true;
+}
+
+void HostMemory::MarkWritten(std::size_t offset, std::size_t length) {
+    const std::size_t page_size = tracker->page_size;
+    for (std::size_t page = offset / page_size; page < (offset + length) / page_size; page++) {
+        if (tracker->Claim(page)) {
+            std::memcpy(tracker->saved + page * page_size, base + page * page_size, page_size);
+            tracker->SetWritten(page);
+        }
+    }
+}
+
+void HostMemory::ProtectUnwritten(std::size_t offset, std::size_t length) {
+    const std::size_t page_size = tracker->page_size;
+    const std::size_t end_page = (offset + length) / page_size;
+    std::size_t page = offset / page_size;
+    while (page != end_page) {
+        if (tracker->IsWritten(page)) {
+            page++;
+            continue;
+        }
+        std::size_t run_end = page + 1;
+        while (run_end != end_page && !tracker->IsWritten(run_end)) {
+            run_end++;
+        }
+        const int result = mprotect(base + page * page_size, (run_end - page) * page_size,
+                                    PROT_READ);
+        ASSERT_MSG(result == 0, "Failed to write protect host memory at offset {:#x}",
+                   page * page_size);
+        page = run_end;
+    }
+}
+
+std::vector<HostMemory::Run> HostMemory::GetDirtyRuns() const {
+    const std::size_t page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    const int pagemap = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+    if (pagemap == -1) {
+        // Without the page flags every page has to be assumed dirty
+        return {Run{0, size}};
+    }
+
+    // Private pages which were written to are anonymous, they're either present without being
+    // file backed or swapped out
+    constexpr u64 PRESENT = u64{1} << 63;
+    constexpr u64 SWAPPED = u64{1} << 62;
+    constexpr u64 FILE_PAGE = u64{1} << 61;
+
+    std::vector<Run> runs;
+    std::array<u64, 4096> entries;
+    const std::size_t num_pages = size / page_size;
+    const std::size_t first_entry = reinterpret_cast<std::uintptr_t>(base) / page_size;
+    for (std::size_t page = 0; page < num_pages; page += entries.size()) {
+        const std::size_t count = std::min(entries.size(), num_pages - page);
+        const auto bytes = static_cast<ssize_t>(count * sizeof(u64));
+        if (pread(pagemap, entries.data(), bytes,
+                  static_cast<off_t>((first_entry + page) * sizeof(u64))) != bytes) {
+            close(pagemap);
+            return {Run{0, size}};
+        }
+
+        for (std::size_t i = 0; i < count; i++) {
+            const u64 entry = entries[i];
+            if (!(entry & SWAPPED) && (!(entry & PRESENT) || (entry & FILE_PAGE))) {
+                continue;
+            }
+            const std::size_t offset = (page + i) * page_size;
+            if (!runs.empty() && runs.back().first + runs.back().second == offset) {
+                runs.back().second += page_size;
+            } else {
+                runs.emplace_back(offset, page_size);
+            }
+        }
+    }
+    close(pagemap);
+    return runs;
+}
+
+void HostMemory::WriteBack(const std::vector<Run>& runs) {
+    for (auto [offset, length] : runs) {
+        while (length != 0) {
+            const ssize_t written = pwrite(fd, base + offset, length, static_cast<off_t>(offset));
+            if (written == -1 && errno == EINTR) {
+                continue;
+            }
+            ASSERT_MSG(written > 0, "Failed to write back host memory at offset {:#x}", offset);
+            offset += static_cast<std::size_t>(written);
+            length -= static_cast<std::size_t>(written);
+        }
+    }
+}
+
+void HostMemory::MapPrivate(std::size_t offset, std::size_t length) {
+    void* ptr = mmap(base + offset, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd,
+                     static_cast<off_t>(offset));
+    ASSERT_MSG(ptr != MAP_FAILED, "Failed to map private host memory at offset {:#x}", offset);
+}
+
+HostArena::HostArena(std::size_t size_) : size{size_} {
+    void* ptr = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (ptr == MAP_FAILED) {
+        LOG_WARNING(Common_Memory, "Failed to reserve {:#x} bytes of address space", size);
+        return;
+    }
+    base = static_cast<u8*>(ptr);
+}
+
+HostArena::~HostArena() {
+    if (base) {
+        munmap(base, size);
+    }
+}
+
+void HostArena::Map(std::size_t offset, const HostMemory& memory, std::size_t memory_offset,
+                    std::size_t length, bool writable) {
+    ASSERT(base && memory.SupportsViews());
+    ASSERT(offset + length <= size && memory_offset + length <= memory.Size());
+    void* ptr = mmap(base + offset, length, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                     MAP_SHARED | MAP_FIXED, memory.fd, static_cast<off_t>(memory_offset));
+    ASSERT_MSG(ptr != MAP_FAILED, "Failed to map view at offset {:#x}", offset);
+}
+
+void HostArena::Unmap(std::size_t offset, std::size_t length) {
+    ASSERT(base && offset + length <= size);
+    void* ptr = mmap(base + offset, length, PROT_NONE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0);
+    ASSERT_MSG(ptr != MAP_FAILED, "Failed to unmap view at offset {:#x}", offset);
+}
+
+#else
+
+// Views need anonymous shared memory, which is only implemented for Linux hosts so far
+
+struct HostMemory::Tracker {};
+
+HostMemory::HostMemory(std::size_t size_)
+    : size{size_}, fallback{std::make_unique<u8[]>(size_)} {
+    base = fallback.get();
+}
+
+HostMemory::~HostMemory() = default;
+
+bool HostMemory::Fork() {
+    return false;
+}
+
+void HostMemory::RestoreFork() {
+    UNREACHABLE();
+}
+
+void HostMemory::DropFork() {
+    UNREACHABLE();
+}
+
+bool HostMemory::StartTracking() {
+    return false;
+}
+
+void HostMemory::StopTracking() {}
+
+bool HostMemory::IsWritten(std::size_t) const {
+    return false;
+}
+
+std::vector<HostMemory::Run> HostMemory::GetWrittenRuns(std::size_t, std::size_t) const {
+    return {};
+}
+
+const u8* HostMemory::TrackedPointer() const {
+    return nullptr;
+}
+
+HostArena::HostArena(std::size_t size_) : size{size_} {}
+
+HostArena::~HostArena() = default;
+
+void HostArena::Map(std::size_t, const HostMemory&, std::size_t, std::size_t, bool) {
+    UNREACHABLE();
+}
+
+void HostArena::Unmap(std::size_t, std::size_t) {
+    UNREACHABLE();
+}
+
+#endif
+
+} // namespace Common
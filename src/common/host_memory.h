@@ -0,0 +1,163 @@
+// Copyright 2024 Encore Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "common/common_types.h"
+
+namespace Common {
+
+/**
+ * Zero-initialized host memory. Where the host supports it, the memory is backed by an anonymous
+ * shared memory object, so ranges of it can be mapped into any number of HostArenas in addition
+ * to the regular mapping at BasePointer(). Elsewhere it falls back to a regular allocation.
+ */
+class HostMemory {
+public:
+    /// Byte offset and length of a range of host pages
+    using Run = std::pair<std::size_t, std::size_t>;
+
+    explicit HostMemory(std::size_t size);
+    ~HostMemory();
+
+    HostMemory(const HostMemory&) = delete;
+    HostMemory& operator=(const HostMemory&) = delete;
+
+    /// Returns true if ranges of this memory can be mapped into arenas.
+    bool SupportsViews() const {
+        return fd != -1;
+    }
+
+    u8* BasePointer() {
+        return base;
+    }
+
+    const u8* BasePointer() const {
+        return base;
+    }
+
+    std::size_t Size() const {
+        return size;
+    }
+
+    /**
+     * Snapshots the current contents. Afterwards BasePointer() is a private copy-on-write mapping
+     * of the shared memory, so writes through it can be discarded with RestoreFork() at the cost
+     * of the pages they touched. Forking again makes the current contents the new snapshot.
+     * While forked, views mapped into arenas don't see writes made through BasePointer().
+     * @returns false if the host doesn't support forking.
+     */
+    bool Fork();
+
+    /// Reverts the contents to the ones of the last Fork().
+    void RestoreFork();
+
+    /// Keeps the current contents and maps the shared memory at BasePointer() again.
+    void DropFork();
+
+    bool IsForked() const {
+        return forked;
+    }
+
+    /**
+     * Starts tracking writes. The memory is write protected, and the first write to each host page
+     * through BasePointer(), from any thread, saves the previous contents of the page and marks it
+     * as written. Views mapped into arenas bypass the protection, so they have to be mapped
+     * read-only while tracking. Starting again resets the tracking. Must not be called while other
+     * threads access the memory.
+     * @returns false if the host doesn't support tracking writes.
+     */
+    bool StartTracking();
+
+    /// Stops tracking writes and releases the saved contents.
+    void StopTracking();
+
+    bool IsTracking() const {
+        return tracker != nullptr;
+    }
+
+    /// Returns true if the host page containing offset was written since tracking started.
+    bool IsWritten(std::size_t offset) const;
+
+    /// Returns the runs of host pages within the range which were written since tracking started.
+    std::vector<Run> GetWrittenRuns(std::size_t offset, std::size_t length) const;
+
+    /// Returns the contents from when tracking started, which are only valid for written pages.
+    const u8* TrackedPointer() const;
+
+private:
+    friend class HostArena;
+
+    struct Tracker;
+
+    static void InstallFaultHandler();
+
+    /// Saves and unprotects the tracked page containing address, returns false if there is none
+    bool HandleWriteFault(const u8* address);
+
+    /// Marks the pages of the range as written, saving the contents of the ones which weren't
+    void MarkWritten(std::size_t offset, std::size_t length);
+
+    /// Write protects the pages of the range which weren't written since tracking started
+    void ProtectUnwritten(std::size_t offset, std::size_t length);
+
+    /// Returns the runs of pages written through the private mapping since they were last mapped
+    std::vector<Run> GetDirtyRuns() const;
+
+    /// Copies the private contents of the runs back into the shared memory
+    void WriteBack(const std::vector<Run>& runs);
+
+    void MapPrivate(std::size_t offset, std::size_t length);
+
+    std::size_t size;
+    u8* base{};
+    int fd{-1};
+    bool forked{};
+    std::unique_ptr<Tracker> tracker;
+    std::unique_ptr<u8[]> fallback;
+};
+
+/**
+ * A reserved range of host address space into which ranges of a HostMemory can be mapped.
+ * Accessing a part of the arena that is not mapped faults.
+ */
+class HostArena {
+public:
+    explicit HostArena(std::size_t size);
+    ~HostArena();
+
+    HostArena(const HostArena&) = delete;
+    HostArena& operator=(const HostArena&) = delete;
+
+    /// Returns false if the address space could not be reserved.
+    bool IsValid() const {
+        return base != nullptr;
+    }
+
+    u8* BasePointer() {
+        return base;
+    }
+
+    std::size_t Size() const {
+        return size;
+    }
+
+    /// Maps length bytes of memory starting at memory_offset to offset in the arena, read-only
+    /// unless writable is set.
+    void Map(std::size_t offset, const HostMemory& memory, std::size_t memory_offset,
+             std::size_t length, bool writable);
+
+    /// Removes any mapping from the specified range of the arena.
+    void Unmap(std::size_t offset, std::size_t length);
+
+private:
+    std::size_t size;
+    u8* base{};
+};
+
+} // namespace Common
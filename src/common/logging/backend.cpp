@@ -176,7 +176,7 @@ public:
         const auto& log_dir = FileUtil::GetUserPath(FileUtil::UserPath::LogDir);
         void(FileUtil::CreateDir(log_dir));
         Filter filter;
-        filter.ParseFilterString(Settings::values.log_filter.GetValue());
+        filter.ParseFilterString(Settings::values().log_filter.GetValue());
         instance = std::unique_ptr<Impl, decltype(&Deleter)>(
             new Impl(fmt::format("{}{}", log_dir, log_file), filter), Deleter);
         initialization_in_progress_suppress_logging = false;
@@ -423,6 +423,7 @@ struct Values {
 
     // Core
     Setting<bool> use_cpu_jit{true, "use_cpu_jit"};
+    Setting<bool> use_fastmem{true, "use_fastmem"};
     SwitchableSetting<s32, true> cpu_clock_percentage{100, 5, 400, "cpu_clock_percentage"};
     SwitchableSetting<bool> is_new_3ds{true, "is_new_3ds"};
     SwitchableSetting<bool> lle_applets{false, "lle_applets"};
@@ -430,6 +431,7 @@ struct Values {
     // Data Storage
     Setting<bool> use_virtual_sd{true, "use_virtual_sd"};
     Setting<bool> use_custom_storage{false, "use_custom_storage"};
+    Setting<bool> map_romfs{false, "map_romfs"};
 
     // System
     SwitchableSetting<s32> region_value{REGION_VALUE_AUTO_SELECT, "region_value"};
@@ -550,7 +552,24 @@ struct Values {
     u64 audio_bitrate;
 };
 
-extern Values values;
+/**
+ * Returns the settings of the emulator instance the calling thread works for. Threads which are
+ * not bound to an instance with ScopedValues use the process-wide settings.
+ */
+Values& values();
+
+/// Binds the calling thread to the settings of an emulator instance while in scope.
+class ScopedValues {
+public:
+    explicit ScopedValues(Values& values_);
+    ~ScopedValues();
+
+    ScopedValues(const ScopedValues&) = delete;
+    ScopedValues& operator=(const ScopedValues&) = delete;
+
+private:
+    Values* previous;
+};
 
 bool IsConfiguringGlobal();
 void SetConfiguringGlobal(bool is_global);
@@ -2,7 +2,9 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <cstdint>
 #include <cstring>
+#include <dynarmic/frontend/A32/a32_ir_emitter.h>
 #include <dynarmic/interface/A32/a32.h>
 #include <dynarmic/interface/optimization_flags.h>
 #include "common/assert.h"
@@ -70,6 +72,14 @@ public:
                         pc, MemoryReadCode(pc).value(), num_instructions);
     }
 
+    bool PreCodeReadHook(bool, VAddr pc, Dynarmic::A32::IREmitter& ir) override {
+        // Execute watchpoints are reported from ExceptionRaised before the instruction runs
+        if (memory.HasExecuteWatchpoint(pc)) {
+            ir.ExceptionRaised(Dynarmic::A32::Exception::Breakpoint);
+        }
+        return true;
+    }
+
     void CallSVC(std::uint32_t swi) override {
         svc_context.CallSVC(swi);
     }
@@ -82,6 +92,10 @@ public:
         case Dynarmic::A32::Exception::NoExecuteFault:
             break;
         case Dynarmic::A32::Exception::Breakpoint:
+            if (memory.HasExecuteWatchpoint(pc)) {
+                memory.NotifyExecute(pc);
+                return;
+            }
             if (GDBStub::IsConnected()) {
                 parent.jit->HaltExecution();
                 parent.SetPC(pc);
@@ -260,7 +274,10 @@ void ARM_Dynarmic::ClearInstructionCache() {
 }
 
 void ARM_Dynarmic::InvalidateCacheRange(u32 start_address, std::size_t length) {
-    jit->InvalidateCacheRange(start_address, length);
+    // The code may have been translated by the JIT of any process, e.g. for execute watchpoints
+    for (const auto& j : jits) {
+        j.second->InvalidateCacheRange(start_address, length);
+    }
 }
 
 void ARM_Dynarmic::ClearExclusiveState() {
@@ -303,6 +320,13 @@ std::unique_ptr<Dynarmic::A32::Jit> ARM_Dynarmic::MakeJit() {
     config.callbacks = cb.get();
     if (current_page_table) {
         config.page_table = &current_page_table->GetPointerArray();
+
+        // Accesses to pages missing from the arena fault, and the faulting block is recompiled to
+        // go through the page table instead
+        if (u8* fastmem_pointer = current_page_table->GetFastmemPointer()) {
+            config.fastmem_pointer = reinterpret_cast<std::uintptr_t>(fastmem_pointer);
+            config.recompile_on_fastmem_failure = true;
+        }
     }
     config.coprocessors[15] = std::make_shared<DynarmicCP15>(cp15_state);
     config.define_unpredictable_behaviour = true;
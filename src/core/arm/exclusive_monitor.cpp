@@ -16,7 +16,7 @@ ExclusiveMonitor::~ExclusiveMonitor() = default;
 std::unique_ptr<Core::ExclusiveMonitor> MakeExclusiveMonitor(Memory::MemorySystem& memory,
                                                              std::size_t num_cores) {
 #if ENCORE_ARCH(x86_64) || ENCORE_ARCH(arm64)
-    if (Settings::values.use_cpu_jit) {
+    if (Settings::values().use_cpu_jit) {
         return std::make_unique<Core::DynarmicExclusiveMonitor>(memory, num_cores);
     }
 #endif
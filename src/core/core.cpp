@@ -10,6 +10,7 @@
 #include "audio_core/lle/lle.h"
 #include "common/arch.h"
 #include "common/logging/log.h"
+#include "common/scope_exit.h"
 #include "common/settings.h"
 #include "core/arm/arm_interface.h"
 #include "core/arm/exclusive_monitor.h"
@@ -52,6 +53,7 @@
 namespace Core {
 
 /*static*/ System System::s_instance;
+/*static*/ thread_local System* System::s_current = nullptr;
 
 template <>
 Core::System& Global() {
@@ -280,7 +282,7 @@ System::ResultStatus System::Load(Frontend::EmuWindow& emu_window, const std::st
     auto n3ds_hw_caps = app_loader->LoadNew3dsHwCapabilities();
     ASSERT(n3ds_hw_caps.first);
     u32 num_cores = 2;
-    if (Settings::values.is_new_3ds) {
+    if (Settings::values().is_new_3ds) {
         num_cores = 4;
     }
     ResultStatus init_result{
@@ -336,10 +338,10 @@ System::ResultStatus System::Load(Frontend::EmuWindow& emu_window, const std::st
 
     perf_stats = std::make_unique<PerfStats>(title_id);
 
-    if (Settings::values.dump_textures) {
+    if (Settings::values().dump_textures) {
         custom_tex_manager->PrepareDumping(title_id);
     }
-    if (Settings::values.custom_textures) {
+    if (Settings::values().custom_textures) {
         custom_tex_manager->FindCustomTextures();
     }
 
@@ -387,10 +389,16 @@ System::ResultStatus System::Init(Frontend::EmuWindow& emu_window,
                                   const Kernel::New3dsHwCapabilities& n3ds_hw_caps, u32 num_cores) {
     LOG_DEBUG(HW_Memory, "initialized OK");
 
-    memory = std::make_unique<Memory::MemorySystem>(*this);
+    // The memory, timing and GPU are kept alive when loading a state, see Shutdown
+    if (!memory) {
+        memory = std::make_unique<Memory::MemorySystem>(*this);
+    }
 
-    timing = std::make_unique<Timing>(num_cores, Settings::values.cpu_clock_percentage.GetValue(),
-                                      movie.GetOverrideBaseTicks());
+    if (!timing) {
+        timing = std::make_unique<Timing>(num_cores,
+                                          Settings::values().cpu_clock_percentage.GetValue(),
+                                          movie.GetOverrideBaseTicks());
+    }
 
     kernel = std::make_unique<Kernel::KernelSystem>(
         *memory, *timing, [this] { PrepareReschedule(); }, memory_mode, num_cores, n3ds_hw_caps,
@@ -398,7 +406,7 @@ System::ResultStatus System::Init(Frontend::EmuWindow& emu_window,
 
     exclusive_monitor = MakeExclusiveMonitor(*memory, num_cores);
     cpu_cores.reserve(num_cores);
-    if (Settings::values.use_cpu_jit) {
+    if (Settings::values().use_cpu_jit) {
 #if ENCORE_ARCH(x86_64) || ENCORE_ARCH(arm64)
         for (u32 i = 0; i < num_cores; ++i) {
             cpu_cores.push_back(std::make_shared<ARM_Dynarmic>(
@@ -422,7 +430,7 @@ System::ResultStatus System::Init(Frontend::EmuWindow& emu_window,
     kernel->SetCPUs(cpu_cores);
     kernel->SetRunningCPU(cpu_cores[0].get());
 
-    const auto audio_emulation = Settings::values.audio_emulation.GetValue();
+    const auto audio_emulation = Settings::values().audio_emulation.GetValue();
     if (audio_emulation == Settings::AudioEmulation::HLE) {
         dsp_core = std::make_unique<AudioCore::DspHle>(*this);
     } else {
@@ -432,9 +440,9 @@ System::ResultStatus System::Init(Frontend::EmuWindow& emu_window,
 
     memory->SetDSP(*dsp_core);
 
-    dsp_core->SetSink(Settings::values.output_type.GetValue(),
-                      Settings::values.output_device.GetValue());
-    dsp_core->EnableStretching(Settings::values.enable_audio_stretching.GetValue());
+    dsp_core->SetSink(Settings::values().output_type.GetValue(),
+                      Settings::values().output_device.GetValue());
+    dsp_core->EnableStretching(Settings::values().enable_audio_stretching.GetValue());
 
     telemetry_session = std::make_unique<Core::TelemetrySession>();
 
@@ -449,17 +457,21 @@ System::ResultStatus System::Init(Frontend::EmuWindow& emu_window,
         registered_image_interface = std::make_shared<Frontend::ImageInterface>();
     }
 
-    custom_tex_manager = std::make_unique<VideoCore::CustomTexManager>(*this);
+    if (!custom_tex_manager) {
+        custom_tex_manager = std::make_unique<VideoCore::CustomTexManager>(*this);
+    }
 
     auto gsp = service_manager->GetService<Service::GSP::GSP_GPU>("gsp::Gpu");
-    gpu = std::make_unique<VideoCore::GPU>(*this, emu_window, secondary_window);
+    if (!gpu) {
+        gpu = std::make_unique<VideoCore::GPU>(*this, emu_window, secondary_window);
+    }
     gpu->SetInterruptHandler(
         [gsp](Service::GSP::InterruptId interrupt_id) { gsp->SignalInterrupt(interrupt_id); });
 
     auto plg_ldr = Service::PLGLDR::GetService(*this);
     if (plg_ldr) {
-        plg_ldr->SetEnabled(Settings::values.plugin_loader_enabled.GetValue());
-        plg_ldr->SetAllowGameChangeState(Settings::values.allow_plugin_loader.GetValue());
+        plg_ldr->SetEnabled(Settings::values().plugin_loader_enabled.GetValue());
+        plg_ldr->SetAllowGameChangeState(Settings::values().allow_plugin_loader.GetValue());
     }
 
     LOG_DEBUG(Core, "Initialized OK");
@@ -572,13 +584,16 @@ void System::Shutdown(bool is_deserializing) {
     // Shutdown emulation session
     is_powered_on = false;
 
-    gpu.reset();
+    // When deserializing, the memory, timing and GPU are kept alive and overwritten by the loaded
+    // state instead. This avoids reallocating the emulated RAM and throwing away the renderer and
+    // shader caches, which don't depend on the emulated state.
     if (!is_deserializing) {
+        gpu.reset();
         GDBStub::Shutdown();
         perf_stats.reset();
         app_loader.reset();
+        custom_tex_manager.reset();
     }
-    custom_tex_manager.reset();
     telemetry_session.reset();
     archive_manager.reset();
     service_manager.reset();
@@ -586,13 +601,20 @@ void System::Shutdown(bool is_deserializing) {
     kernel.reset();
     cpu_cores.clear();
     exclusive_monitor.reset();
-    timing.reset();
+    if (is_deserializing) {
+        // The subsystems owning these callbacks are gone, their replacements register new ones
+        timing->ClearEventCallbacks();
+    } else {
+        timing.reset();
+    }
 
     if (video_dumper && video_dumper->IsDumping()) {
         video_dumper->StopDumping();
     }
 
-    memory.reset();
+    if (!is_deserializing) {
+        memory.reset();
+    }
 
     if (self_delete_pending)
         FileUtil::Delete(m_filepath);
@@ -628,8 +650,8 @@ void System::Reset() {
 }
 
 void System::ApplySettings() {
-    GDBStub::SetServerPort(Settings::values.gdbstub_port.GetValue());
-    GDBStub::ToggleServer(Settings::values.use_gdbstub.GetValue());
+    GDBStub::SetServerPort(Settings::values().gdbstub_port.GetValue());
+    GDBStub::ToggleServer(Settings::values().use_gdbstub.GetValue());
 
     if (gpu) {
         gpu->Renderer().UpdateCurrentFramebufferLayout();
@@ -639,10 +661,10 @@ void System::ApplySettings() {
     }
 
     if (IsPoweredOn()) {
-        CoreTiming().UpdateClockSpeed(Settings::values.cpu_clock_percentage.GetValue());
-        dsp_core->SetSink(Settings::values.output_type.GetValue(),
-                          Settings::values.output_device.GetValue());
-        dsp_core->EnableStretching(Settings::values.enable_audio_stretching.GetValue());
+        CoreTiming().UpdateClockSpeed(Settings::values().cpu_clock_percentage.GetValue());
+        dsp_core->SetSink(Settings::values().output_type.GetValue(),
+                          Settings::values().output_device.GetValue());
+        dsp_core->EnableStretching(Settings::values().enable_audio_stretching.GetValue());
 
         auto hid = Service::HID::GetModule(*this);
         if (hid) {
@@ -671,8 +693,23 @@ void System::ApplySettings() {
 
     auto plg_ldr = Service::PLGLDR::GetService(*this);
     if (plg_ldr) {
-        plg_ldr->SetEnabled(Settings::values.plugin_loader_enabled.GetValue());
-        plg_ldr->SetAllowGameChangeState(Settings::values.allow_plugin_loader.GetValue());
+        plg_ldr->SetEnabled(Settings::values().plugin_loader_enabled.GetValue());
+        plg_ldr->SetAllowGameChangeState(Settings::values().allow_plugin_loader.GetValue());
+    }
+}
+
+void System::SetDeltaAnchor() {
+    // Make sure any modified rasterizer surfaces are written back before hashing the RAM
+    gpu->Renderer().Rasterizer()->FlushAll();
+
+    if (!memory->SetDeltaAnchor()) {
+        LOG_WARNING(Core, "The host can't track RAM writes, delta savestates are unavailable");
+    }
+}
+
+void System::ClearDeltaAnchor() {
+    if (memory) {
+        memory->ClearDeltaAnchor();
     }
 }
 
@@ -685,10 +722,33 @@ void System::serialize(Archive& ar, const unsigned int file_version) {
     }
     ar & num_cores;
 
+    // Delta states are checked against the current anchor before anything is torn down, so a
+    // mismatched state is rejected with the running emulation left intact
+    u64 anchor_hash = 0;
+    if (Archive::is_saving::value) {
+        anchor_hash = memory->GetSavedAnchorHash();
+    }
+    if (file_version >= 2) {
+        ar & anchor_hash;
+    }
+    // The anchor lives in the memory system, which is rebuilt for a different core count
+    if (Archive::is_loading::value && anchor_hash != 0 &&
+        (memory->GetDeltaAnchorHash() != anchor_hash || num_cores != GetNumCores())) {
+        throw std::runtime_error("Delta savestate does not match the current anchor");
+    }
+
     if (Archive::is_loading::value) {
         // When loading, we want to make sure any lingering state gets cleared out before we begin.
         // Shutdown, but persist a few things between loads...
+        const bool same_num_cores = num_cores == GetNumCores();
         Shutdown(true);
+        if (!same_num_cores) {
+            // The kept timing system is sized for the old core count, rebuild it from scratch
+            gpu.reset();
+            custom_tex_manager.reset();
+            timing.reset();
+            memory.reset();
+        }
 
         // Re-initialize everything like it was before
         auto memory_mode = this->app_loader->LoadKernelMemoryMode();
@@ -697,6 +757,16 @@ void System::serialize(Archive& ar, const unsigned int file_version) {
             *m_emu_window, m_secondary_window, *memory_mode.first, *n3ds_hw_caps.first, num_cores);
     }
 
+    // A load that fails from here on has already replaced the running system, so what is left of
+    // it is shut down rather than kept powered on in a half-loaded state
+    bool loaded = Archive::is_saving::value;
+    SCOPE_EXIT({
+        if (!loaded) {
+            LOG_ERROR(Core, "Failed to load the savestate, shutting down");
+            Shutdown();
+        }
+    });
+
     // Flush on save, don't flush on load
     const bool should_flush = !Archive::is_loading::value;
     gpu->ClearAll(should_flush);
@@ -734,6 +804,7 @@ void System::serialize(Archive& ar, const unsigned int file_version) {
         gpu->SetInterruptHandler(
             [gsp](Service::GSP::InterruptId interrupt_id) { gsp->SignalInterrupt(interrupt_id); });
     }
+    loaded = true;
 }
 
 SERIALIZE_IMPL(System)
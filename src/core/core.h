@@ -27,7 +27,7 @@ class SoftwareKeyboard;
 
 namespace Memory {
 class MemorySystem;
-}
+} // namespace Memory
 
 namespace AudioCore {
 class DspInterface;
@@ -79,13 +79,32 @@ class Timing;
 class System {
 public:
     /**
-     * Gets the instance of the System singleton class.
-     * @returns Reference to the instance of the System singleton class.
+     * Gets the System instance the calling thread works for. Threads which are not bound to an
+     * instance with ScopedInstance use the process-wide default instance.
+     * @returns Reference to the System instance.
      */
     [[nodiscard]] static System& GetInstance() {
-        return s_instance;
+        return s_current ? *s_current : s_instance;
     }
 
+    /// Binds the calling thread to a System instance while in scope.
+    class ScopedInstance {
+    public:
+        explicit ScopedInstance(System& system) : previous{s_current} {
+            s_current = &system;
+        }
+
+        ~ScopedInstance() {
+            s_current = previous;
+        }
+
+        ScopedInstance(const ScopedInstance&) = delete;
+        ScopedInstance& operator=(const ScopedInstance&) = delete;
+
+    private:
+        System* previous;
+    };
+
     /// Enumeration representing the return values of the System Initialize and Load process.
     enum class ResultStatus : u32 {
         Success,                    ///< Succeeded
@@ -355,6 +374,17 @@ public:
     /// Applies any changes to settings to this core instance.
     void ApplySettings();
 
+    /**
+     * Captures the current emulated RAM as the anchor for delta savestates. Savestates taken while
+     * an anchor is set only contain the RAM pages which changed since the anchor was captured, and
+     * can only be loaded while the same anchor is set. The anchor is kept when loading a state,
+     * and dropped when the system shuts down.
+     */
+    void SetDeltaAnchor();
+
+    /// Drops the delta anchor, subsequent savestates contain the full emulated RAM.
+    void ClearDeltaAnchor();
+
 private:
     /**
      * Initialize the emulated system.
@@ -422,6 +452,7 @@ private:
 
 private:
     static System s_instance;
+    static thread_local System* s_current;
 
     std::atomic_bool is_powered_on{};
 
@@ -464,4 +495,4 @@ private:
 
 } // namespace Core
 
-BOOST_CLASS_VERSION(Core::System, 1)
+BOOST_CLASS_VERSION(Core::System, 2)
@@ -35,8 +35,8 @@ Timing::Timing(std::size_t num_cores, u32 cpu_clock_percentage, s64 override_bas
 }
 
 s64 Timing::GenerateBaseTicks() {
-    if (Settings::values.init_ticks_type.GetValue() == Settings::InitTicks::Fixed) {
-        return Settings::values.init_ticks_override.GetValue();
+    if (Settings::values().init_ticks_type.GetValue() == Settings::InitTicks::Fixed) {
+        return Settings::values().init_ticks_override.GetValue();
     }
     // Bounded to 32 bits to make sure we don't generate too high of a counter and risk overflowing.
     std::mt19937 random_gen(std::random_device{}());
@@ -52,15 +52,29 @@ void Timing::UpdateClockSpeed(u32 cpu_clock_percentage) {
 TimingEventType* Timing::RegisterEvent(const std::string& name, TimedCallback callback) {
     // check for existing type with same name.
     // we want event type names to remain unique so that we can use them for serialization.
-    auto info = event_types.emplace(name, TimingEventType{});
-    TimingEventType* event_type = &info.first->second;
-    event_type->name = &info.first->first;
+    const auto [itr, inserted] =
+        event_type_ids.emplace(name, static_cast<u32>(event_types.size()));
+    if (inserted) {
+        event_types.push_back(TimingEventType{nullptr, &itr->first, itr->second});
+    }
+    TimingEventType* event_type = &event_types[itr->second];
     if (callback != nullptr) {
-        event_type->callback = callback;
+        event_type->callback = std::move(callback);
     }
     return event_type;
 }
 
+const TimingEventType* Timing::GetLoadedEventType(u32 saved_id) const {
+    ASSERT_MSG(saved_id < loaded_event_types.size(), "Invalid event type id {}", saved_id);
+    return loaded_event_types[saved_id];
+}
+
+void Timing::ClearEventCallbacks() {
+    for (auto& event_type : event_types) {
+        event_type.callback = nullptr;
+    }
+}
+
 void Timing::ScheduleEvent(s64 cycles_into_future, const TimingEventType* event_type,
                            std::uintptr_t user_data, std::size_t core_id, bool thread_safe_mode) {
     if (event_queue_locked) {
@@ -92,9 +106,7 @@ void Timing::ScheduleEvent(s64 cycles_into_future, const TimingEventType* event_
             if (!timer->is_timer_sane)
                 timer->ForceExceptionCheck(cycles_into_future);
 
-            timer->event_queue.emplace_back(
-                Event{timeout, timer->event_fifo_id++, user_data, event_type});
-            std::push_heap(timer->event_queue.begin(), timer->event_queue.end(), std::greater<>());
+            timer->PushEvent(Event{timeout, timer->event_fifo_id++, user_data, event_type});
         } else {
             timer->ts_queue.Push(Event{static_cast<s64>(timer->GetTicks() + cycles_into_future), 0,
                                        user_data, event_type});
@@ -106,16 +118,9 @@ void Timing::UnscheduleEvent(const TimingEventType* event_type, std::uintptr_t u
     if (event_queue_locked) {
         return;
     }
-    for (auto timer : timers) {
-        auto itr = std::remove_if(
-            timer->event_queue.begin(), timer->event_queue.end(),
+    for (const auto& timer : timers) {
+        timer->EraseEvents(
             [&](const Event& e) { return e.type == event_type && e.user_data == user_data; });
-
-        // Removing random items breaks the invariant so we have to re-establish it.
-        if (itr != timer->event_queue.end()) {
-            timer->event_queue.erase(itr, timer->event_queue.end());
-            std::make_heap(timer->event_queue.begin(), timer->event_queue.end(), std::greater<>());
-        }
     }
     // TODO:remove events from ts_queue
 }
@@ -124,15 +129,8 @@ void Timing::RemoveEvent(const TimingEventType* event_type) {
     if (event_queue_locked) {
         return;
     }
-    for (auto timer : timers) {
-        auto itr = std::remove_if(timer->event_queue.begin(), timer->event_queue.end(),
-                                  [&](const Event& e) { return e.type == event_type; });
-
-        // Removing random items breaks the invariant so we have to re-establish it.
-        if (itr != timer->event_queue.end()) {
-            timer->event_queue.erase(itr, timer->event_queue.end());
-            std::make_heap(timer->event_queue.begin(), timer->event_queue.end(), std::greater<>());
-        }
+    for (const auto& timer : timers) {
+        timer->EraseEvents([&](const Event& e) { return e.type == event_type; });
     }
     // TODO:remove events from ts_queue
 }
@@ -161,7 +159,9 @@ std::shared_ptr<Timing::Timer> Timing::GetTimer(std::size_t cpu_id) {
     return timers[cpu_id];
 }
 
-Timing::Timer::Timer(s64 base_ticks) : executed_ticks(base_ticks) {}
+Timing::Timer::Timer(s64 base_ticks) : executed_ticks(base_ticks) {
+    event_queue.reserve(EVENT_QUEUE_CAPACITY);
+}
 
 Timing::Timer::~Timer() {
     MoveEvents();
@@ -192,13 +192,20 @@ void Timing::Timer::ForceExceptionCheck(s64 cycles) {
 }
 
 void Timing::Timer::MoveEvents() {
+    if (ts_queue.Empty()) {
+        return;
+    }
     for (Event ev; ts_queue.Pop(ev);) {
         ev.fifo_order = event_fifo_id++;
-        event_queue.emplace_back(std::move(ev));
-        std::push_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+        PushEvent(std::move(ev));
     }
 }
 
+void Timing::Timer::PushEvent(Event&& event) {
+    event_queue.push_back(std::move(event));
+    std::push_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+}
+
 s64 Timing::Timer::GetMaxSliceLength() const {
     const auto& next_event = event_queue.begin();
     if (next_event != event_queue.end()) {
@@ -17,7 +17,9 @@
  *   ScheduleEvent(periodInCycles - cyclesLate, callback, "whatever")
  */
 
+#include <algorithm>
 #include <chrono>
+#include <deque>
 #include <functional>
 #include <limits>
 #include <string>
@@ -137,6 +139,8 @@ using TimedCallback = std::function<void(std::uintptr_t user_data, int cycles_la
 struct TimingEventType {
     TimedCallback callback;
     const std::string* name;
+    /// Index of the type in the registration order, stable for the lifetime of the Timing
+    u32 id;
 };
 
 class Timing {
@@ -152,23 +156,30 @@ public:
         bool operator<(const Event& right) const;
 
     private:
+        // The type is stored as its id, Timing saves the names of all ids once before the events
         template <class Archive>
         void save(Archive& ar, const unsigned int) const {
             ar & time;
             ar & fifo_order;
             ar & user_data;
-            std::string name = *(type->name);
-            ar << name;
+            u32 type_id = type->id;
+            ar << type_id;
         }
 
         template <class Archive>
-        void load(Archive& ar, const unsigned int) {
+        void load(Archive& ar, const unsigned int file_version) {
             ar & time;
             ar & fifo_order;
             ar & user_data;
-            std::string name;
-            ar >> name;
-            type = Global<Timing>().RegisterEvent(name, nullptr);
+            if (file_version == 0) {
+                std::string name;
+                ar >> name;
+                type = Global<Timing>().RegisterEvent(name, nullptr);
+                return;
+            }
+            u32 type_id;
+            ar >> type_id;
+            type = Global<Timing>().GetLoadedEventType(type_id);
         }
         friend class boost::serialization::access;
 
@@ -183,6 +194,10 @@ public:
     // scheduled and repated.
     static constexpr int MAX_SLICE_LENGTH = BASE_CLOCK_RATE_ARM11 / 234;
 
+    // Initial capacity of the event queue of each timer. Only a couple dozen events are ever
+    // scheduled at once, so scheduling doesn't allocate in practice.
+    static constexpr std::size_t EVENT_QUEUE_CAPACITY = 64;
+
     class Timer {
     public:
         Timer(s64 base_ticks = 0);
@@ -209,6 +224,17 @@ public:
 
     private:
         friend class Timing;
+
+        void PushEvent(Event&& event);
+        /// Removes all events matching the predicate from the queue
+        template <typename Predicate>
+        void EraseEvents(Predicate&& pred) {
+            // Removing random items breaks the invariant so we have to re-establish it.
+            if (std::erase_if(event_queue, std::forward<Predicate>(pred)) != 0) {
+                std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+            }
+        }
+
         // The queue is a min-heap using std::make_heap/push_heap/pop_heap.
         // We don't use std::priority_queue because we need to be able to serialize, unserialize and
         // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't
@@ -239,6 +265,8 @@ public:
         template <class Archive>
         void serialize(Archive& ar, const unsigned int) {
             MoveEvents();
+            // Loading a vector only reserves as much as it needs, keep the usual capacity
+            event_queue.reserve(EVENT_QUEUE_CAPACITY);
             ar & event_queue;
             ar & event_fifo_id;
             ar & slice_length;
@@ -258,6 +286,17 @@ public:
      */
     TimingEventType* RegisterEvent(const std::string& name, TimedCallback callback);
 
+    /**
+     * Returns the event type that had the given id in the state being loaded.
+     */
+    const TimingEventType* GetLoadedEventType(u32 saved_id) const;
+
+    /**
+     * Drops the callbacks of all registered event types. Used when the subsystems owning them are
+     * torn down while the timing system itself is kept alive, they re-register on creation.
+     */
+    void ClearEventCallbacks();
+
     // Make sure to use thread_safe_mode = true if called from a different thread than the
     // emulator thread, such as coroutines.
     void ScheduleEvent(s64 cycles_into_future, const TimingEventType* event_type,
@@ -294,9 +333,13 @@ public:
     static s64 GenerateBaseTicks();
 
 private:
-    // unordered_map stores each element separately as a linked list node so pointers to
-    // elements remain stable regardless of rehashes/resizing.
-    std::unordered_map<std::string, TimingEventType> event_types = {};
+    // Indexed by TimingEventType::id. deque never moves its elements when growing at the end, so
+    // pointers to them remain stable.
+    std::deque<TimingEventType> event_types;
+    // Only used to look up names on registration
+    std::unordered_map<std::string, u32> event_type_ids;
+    // Maps the event type ids of the state being loaded to the current event types
+    std::vector<const TimingEventType*> loaded_event_types;
 
     std::vector<std::shared_ptr<Timer>> timers;
     Timer* current_timer = nullptr;
@@ -306,17 +349,41 @@ private:
     bool event_queue_locked = false;
 
     template <class Archive>
-    void serialize(Archive& ar, const unsigned int file_version) {
-        // event_types set during initialization of other things
-        ar & timers;
-        ar & current_timer;
-        if (Archive::is_loading::value) {
-            event_queue_locked = true;
+    void save(Archive& ar, const unsigned int) const {
+        // event_types set during initialization of other things, only the names are saved so the
+        // ids of the events can be translated on load
+        std::vector<std::string> names;
+        names.reserve(event_types.size());
+        for (const auto& event_type : event_types) {
+            names.push_back(*event_type.name);
         }
+        ar << names;
+        ar << timers;
+        ar << current_timer;
     }
+
+    template <class Archive>
+    void load(Archive& ar, const unsigned int file_version) {
+        if (file_version >= 2) {
+            std::vector<std::string> names;
+            ar >> names;
+            loaded_event_types.clear();
+            loaded_event_types.reserve(names.size());
+            for (const auto& name : names) {
+                loaded_event_types.push_back(RegisterEvent(name, nullptr));
+            }
+        }
+        ar >> timers;
+        ar >> current_timer;
+        loaded_event_types.clear();
+        event_queue_locked = true;
+    }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+
     friend class boost::serialization::access;
 };
 
 } // namespace Core
 
-BOOST_CLASS_VERSION(Core::Timing, 1)
+BOOST_CLASS_VERSION(Core::Timing, 2)
+BOOST_CLASS_VERSION(Core::Timing::Event, 1)
@@ -86,12 +86,12 @@ ResultVal<std::unique_ptr<FileBackend>> NCCHArchive::OpenFile(const Path& path,
     std::memcpy(&openfile_path, binary.data(), sizeof(NCCHFilePath));
 
     std::string file_path;
-    if (Settings::values.is_new_3ds) {
+    if (Settings::values().is_new_3ds) {
         // Try the New 3DS specific variant first.
         file_path = Service::AM::GetTitleContentPath(media_type, title_id | 0x20000000,
                                                      openfile_path.content_index);
     }
-    if (!Settings::values.is_new_3ds || !FileUtil::Exists(file_path)) {
+    if (!Settings::values().is_new_3ds || !FileUtil::Exists(file_path)) {
         file_path =
             Service::AM::GetTitleContentPath(media_type, title_id, openfile_path.content_index);
     }
@@ -372,7 +372,7 @@ ArchiveFactory_SDMC::ArchiveFactory_SDMC(const std::string& sdmc_directory)
 }
 
 bool ArchiveFactory_SDMC::Initialize() {
-    if (!Settings::values.use_virtual_sd) {
+    if (!Settings::values().use_virtual_sd) {
         LOG_WARNING(Service_FS, "SDMC disabled by config.");
         return false;
     }
@@ -5,11 +5,14 @@
 #include <cstring>
 #include <memory>
 #include <span>
+#include <string_view>
 #include <cryptopp/aes.h>
 #include <cryptopp/modes.h>
 #include <cryptopp/sha.h>
 #include "common/common_types.h"
+#include "common/hash.h"
 #include "common/logging/log.h"
+#include "common/settings.h"
 #include "core/core.h"
 #include "core/file_sys/layered_fs.h"
 #include "core/file_sys/ncch_container.h"
@@ -233,49 +236,39 @@ Loader::ResultStatus NCCHContainer::Load() {
                     }
                 }
 
-                SetKeyY(KeySlotID::NCCHSecure1, key_y_primary);
-                if (!IsNormalKeyAvailable(KeySlotID::NCCHSecure1)) {
-                    LOG_ERROR(Service_FS, "Secure1 KeyX missing");
-                    failed_to_decrypt = true;
-                }
-                primary_key = GetNormalKey(KeySlotID::NCCHSecure1);
+                // The keys are derived without changing the shared key slots, so titles can be
+                // loaded on several threads
+                const auto generate_key = [&](std::size_t slot_id, const AESKey& key_y,
+                                              std::string_view slot_name) {
+                    const auto key = GenerateNormalKey(slot_id, key_y);
+                    if (!key) {
+                        LOG_ERROR(Service_FS, "{} KeyX missing", slot_name);
+                        failed_to_decrypt = true;
+                    }
+                    return key.value_or(AESKey{});
+                };
+                primary_key = generate_key(KeySlotID::NCCHSecure1, key_y_primary, "Secure1");
 
                 switch (ncch_header.secondary_key_slot) {
                 case 0:
                     LOG_DEBUG(Service_FS, "Secure1 crypto");
-                    SetKeyY(KeySlotID::NCCHSecure1, key_y_secondary);
-                    if (!IsNormalKeyAvailable(KeySlotID::NCCHSecure1)) {
-                        LOG_ERROR(Service_FS, "Secure1 KeyX missing");
-                        failed_to_decrypt = true;
-                    }
-                    secondary_key = GetNormalKey(KeySlotID::NCCHSecure1);
+                    secondary_key =
+                        generate_key(KeySlotID::NCCHSecure1, key_y_secondary, "Secure1");
                     break;
                 case 1:
                     LOG_DEBUG(Service_FS, "Secure2 crypto");
-                    SetKeyY(KeySlotID::NCCHSecure2, key_y_secondary);
-                    if (!IsNormalKeyAvailable(KeySlotID::NCCHSecure2)) {
-                        LOG_ERROR(Service_FS, "Secure2 KeyX missing");
-                        failed_to_decrypt = true;
-                    }
-                    secondary_key = GetNormalKey(KeySlotID::NCCHSecure2);
+                    secondary_key =
+                        generate_key(KeySlotID::NCCHSecure2, key_y_secondary, "Secure2");
                     break;
                 case 10:
                     LOG_DEBUG(Service_FS, "Secure3 crypto");
-                    SetKeyY(KeySlotID::NCCHSecure3, key_y_secondary);
-                    if (!IsNormalKeyAvailable(KeySlotID::NCCHSecure3)) {
-                        LOG_ERROR(Service_FS, "Secure3 KeyX missing");
-                        failed_to_decrypt = true;
-                    }
-                    secondary_key = GetNormalKey(KeySlotID::NCCHSecure3);
+                    secondary_key =
+                        generate_key(KeySlotID::NCCHSecure3, key_y_secondary, "Secure3");
                     break;
                 case 11:
                     LOG_DEBUG(Service_FS, "Secure4 crypto");
-                    SetKeyY(KeySlotID::NCCHSecure4, key_y_secondary);
-                    if (!IsNormalKeyAvailable(KeySlotID::NCCHSecure4)) {
-                        LOG_ERROR(Service_FS, "Secure4 KeyX missing");
-                        failed_to_decrypt = true;
-                    }
-                    secondary_key = GetNormalKey(KeySlotID::NCCHSecure4);
+                    secondary_key =
+                        generate_key(KeySlotID::NCCHSecure4, key_y_secondary, "Secure4");
                     break;
                 }
             }
@@ -678,7 +671,12 @@ Loader::ResultStatus NCCHContainer::ReadRomFS(std::shared_ptr<RomFSReader>& romf
         return Loader::ResultStatus::Error;
 
     std::shared_ptr<RomFSReader> direct_romfs;
-    if (is_encrypted) {
+    if (Settings::values().map_romfs) {
+        direct_romfs = OpenMappedRomFS(romfs_offset, romfs_size);
+    }
+    if (direct_romfs) {
+        LOG_DEBUG(Service_FS, "RomFS mapped into memory");
+    } else if (is_encrypted) {
         direct_romfs =
             std::make_shared<DirectRomFSReader>(std::move(romfs_file_inner), romfs_offset,
                                                 romfs_size, secondary_key, romfs_ctr, 0x1000);
@@ -702,6 +700,53 @@ Loader::ResultStatus NCCHContainer::ReadRomFS(std::shared_ptr<RomFSReader>& romf
     return Loader::ResultStatus::Success;
 }
 
+std::shared_ptr<RomFSReader> NCCHContainer::OpenMappedRomFS(u32 romfs_offset, u32 romfs_size) {
+    std::string path = filepath;
+    std::size_t offset = romfs_offset;
+    if (is_encrypted) {
+        // The header holds the hashes of the sections, so it tells apart versions of a title. The
+        // key and counter tell apart RomFS decrypted with a missing or wrong key or seed.
+        u64 header_hash = Common::ComputeHash64(&ncch_header, sizeof(ncch_header));
+        header_hash = Common::HashCombine(
+            header_hash, Common::ComputeHash64(secondary_key.data(), secondary_key.size()));
+        header_hash = Common::HashCombine(
+            header_hash, Common::ComputeHash64(romfs_ctr.data(), romfs_ctr.size()));
+        path = fmt::format("{}romfs/{:016X}_{:016X}.bin",
+                           FileUtil::GetUserPath(FileUtil::UserPath::CacheDir),
+                           static_cast<u64>(ncch_header.program_id), header_hash);
+        offset = 0;
+        if (FileUtil::GetSize(path) != romfs_size) {
+            LOG_INFO(Service_FS, "Decrypting RomFS to {}", path);
+            if (!FileUtil::CreateFullPath(path) ||
+                !DecryptRomFS(file, romfs_offset, romfs_size, secondary_key, romfs_ctr, 0x1000,
+                              path)) {
+                LOG_ERROR(Service_FS, "Could not decrypt RomFS to {}", path);
+                return nullptr;
+            }
+        }
+    }
+
+    FileUtil::IOFile romfs_file(path, "rb");
+    if (!romfs_file.IsOpen()) {
+        return nullptr;
+    }
+    auto mapped_romfs = std::make_shared<MappedRomFSReader>(std::move(romfs_file), offset,
+                                                            romfs_size);
+    if (!mapped_romfs->IsMapped()) {
+        return nullptr;
+    }
+    if (!mapped_romfs->HasValidHeader()) {
+        // Don't keep garbage from a wrong key around, it would be mapped on every boot
+        LOG_ERROR(Service_FS, "RomFS in {} is invalid", path);
+        if (is_encrypted) {
+            mapped_romfs.reset();
+            FileUtil::Delete(path);
+        }
+        return nullptr;
+    }
+    return mapped_romfs;
+}
+
 Loader::ResultStatus NCCHContainer::DumpRomFS(const std::string& target_path) {
     std::shared_ptr<RomFSReader> direct_romfs;
     Loader::ResultStatus result = ReadRomFS(direct_romfs, false);
@@ -338,6 +338,12 @@ public:
     ExHeader_Header exheader_header;
 
 private:
+    /**
+     * Maps the RomFS into memory, encrypted ones are decrypted into the cache directory first
+     * @return The reader, or nullptr if the RomFS could not be mapped
+     */
+    std::shared_ptr<RomFSReader> OpenMappedRomFS(u32 romfs_offset, u32 romfs_size);
+
     bool has_header = false;
     bool has_exheader = false;
     bool has_exefs = false;
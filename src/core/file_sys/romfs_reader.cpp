@@ -1,5 +1,17 @@
 #include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <random>
 #include <vector>
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 #include <cryptopp/aes.h>
 #include <cryptopp/modes.h>
 #include "common/archives.h"
@@ -7,6 +19,7 @@
 #include "core/file_sys/romfs_reader.h"
 
 SERIALIZE_EXPORT_IMPL(FileSys::DirectRomFSReader)
+SERIALIZE_EXPORT_IMPL(FileSys::MappedRomFSReader)
 
 namespace FileSys {
 
@@ -109,4 +122,137 @@ std::vector<std::pair<std::size_t, std::size_t>> DirectRomFSReader::BreakupRead(
     return ret;
 }
 
+MappedRomFSReader::MappedRomFSReader(FileUtil::IOFile&& file, std::size_t file_offset,
+                                     std::size_t data_size)
+    : file(std::move(file)), file_offset(file_offset), data_size(data_size) {
+    Map();
+}
+
+MappedRomFSReader::~MappedRomFSReader() {
+    Unmap();
+}
+
+std::size_t MappedRomFSReader::ReadFile(std::size_t offset, std::size_t length, u8* buffer) {
+    if (offset >= data_size) {
+        return 0;
+    }
+    length = std::min(length, static_cast<std::size_t>(data_size) - offset);
+    if (data == nullptr) [[unlikely]] {
+        // The file could not be mapped again after loading a state, read it instead
+        const std::size_t read = file.ReadAtBytes(buffer, length, file_offset + offset);
+        return read == std::numeric_limits<std::size_t>::max() ? 0 : read;
+    }
+    std::memcpy(buffer, data + offset, length);
+    return length;
+}
+
+bool MappedRomFSReader::HasValidHeader() const {
+    constexpr std::array<u8, 4> ivfc_magic{'I', 'V', 'F', 'C'};
+    return data != nullptr && data_size >= ivfc_magic.size() &&
+           std::memcmp(data, ivfc_magic.data(), ivfc_magic.size()) == 0;
+}
+
+void MappedRomFSReader::Map() {
+    if (!file.IsOpen() || data_size == 0 || file.GetSize() < file_offset + data_size) {
+        LOG_ERROR(Service_FS, "RomFS of size {} at {} is not inside the file", data_size,
+                  file_offset);
+        return;
+    }
+
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const u64 map_offset = Common::AlignDown<u64>(file_offset, info.dwAllocationGranularity);
+    const std::size_t map_size = static_cast<std::size_t>(file_offset - map_offset + data_size);
+
+    const HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(file.GetFd()));
+    // The view keeps the file mapping alive after its handle is closed
+    const HANDLE file_mapping =
+        CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (file_mapping == nullptr) {
+        LOG_ERROR(Service_FS, "CreateFileMapping failed: {}", GetLastError());
+        return;
+    }
+    void* view = MapViewOfFile(file_mapping, FILE_MAP_READ, static_cast<DWORD>(map_offset >> 32),
+                               static_cast<DWORD>(map_offset), map_size);
+    CloseHandle(file_mapping);
+    if (view == nullptr) {
+        LOG_ERROR(Service_FS, "MapViewOfFile failed: {}", GetLastError());
+        return;
+    }
+#else
+    const u64 map_offset =
+        Common::AlignDown<u64>(file_offset, static_cast<u64>(sysconf(_SC_PAGESIZE)));
+    const std::size_t map_size = static_cast<std::size_t>(file_offset - map_offset + data_size);
+
+    void* view = mmap(nullptr, map_size, PROT_READ, MAP_SHARED, file.GetFd(),
+                      static_cast<off_t>(map_offset));
+    if (view == MAP_FAILED) {
+        LOG_ERROR(Service_FS, "mmap failed: {}", std::strerror(errno));
+        return;
+    }
+#endif
+
+    mapping = static_cast<u8*>(view);
+    mapping_size = map_size;
+    data = mapping + (file_offset - map_offset);
+}
+
+void MappedRomFSReader::Unmap() {
+    if (mapping == nullptr) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(mapping);
+#else
+    munmap(mapping, mapping_size);
+#endif
+    mapping = nullptr;
+    mapping_size = 0;
+    data = nullptr;
+}
+
+bool DecryptRomFS(FileUtil::IOFile& file, std::size_t file_offset, std::size_t data_size,
+                  const std::array<u8, 16>& key, const std::array<u8, 16>& ctr,
+                  std::size_t crypto_offset, const std::string& path) {
+    constexpr std::size_t chunk_size = 1024 * 1024;
+
+    // Unique, as several emulator instances may decrypt the same RomFS at once
+    const std::string temp_path = fmt::format("{}.{:08x}.part", path, std::random_device{}());
+    {
+        FileUtil::IOFile out(temp_path, "wb");
+        if (!out.IsOpen()) {
+            LOG_ERROR(Service_FS, "Could not create {}", temp_path);
+            return false;
+        }
+
+        CryptoPP::CTR_Mode<CryptoPP::AES>::Decryption d(key.data(), key.size(), ctr.data());
+        d.Seek(crypto_offset);
+
+        std::vector<u8> chunk(chunk_size);
+        for (std::size_t offset = 0; offset < data_size; offset += chunk_size) {
+            const std::size_t length = std::min(chunk_size, data_size - offset);
+            if (file.ReadAtBytes(chunk.data(), length, file_offset + offset) != length) {
+                LOG_ERROR(Service_FS, "Could not read RomFS at {}", offset);
+                out.Close();
+                FileUtil::Delete(temp_path);
+                return false;
+            }
+            d.ProcessData(chunk.data(), chunk.data(), length);
+            if (out.WriteBytes(chunk.data(), length) != length) {
+                LOG_ERROR(Service_FS, "Could not write {}", temp_path);
+                out.Close();
+                FileUtil::Delete(temp_path);
+                return false;
+            }
+        }
+    }
+
+    if (!FileUtil::Rename(temp_path, path)) {
+        FileUtil::Delete(temp_path);
+        return FileUtil::Exists(path);
+    }
+    return true;
+}
+
 } // namespace FileSys
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <shared_mutex>
+#include <string>
 #include <boost/serialization/array.hpp>
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/export.hpp>
@@ -97,6 +98,76 @@ private:
     friend class boost::serialization::access;
 };
 
+/**
+ * A RomFS reader that maps the plain RomFS data into memory. Reads are copies out of the host page
+ * cache, so they need neither a lock nor a cache of their own.
+ */
+class MappedRomFSReader : public RomFSReader {
+public:
+    /// Maps data_size bytes at file_offset of the file, check IsMapped() afterwards.
+    MappedRomFSReader(FileUtil::IOFile&& file, std::size_t file_offset, std::size_t data_size);
+
+    ~MappedRomFSReader() override;
+
+    bool IsMapped() const {
+        return data != nullptr;
+    }
+
+    /// Whether the data starts with the RomFS level 0 IVFC header, i.e. was decrypted correctly
+    bool HasValidHeader() const;
+
+    std::size_t GetSize() const override {
+        return data_size;
+    }
+
+    std::size_t ReadFile(std::size_t offset, std::size_t length, u8* buffer) override;
+
+    bool AllowsCachedReads() const override {
+        return true;
+    }
+
+    bool CacheReady(std::size_t file_offset, std::size_t length) override {
+        return true;
+    }
+
+private:
+    FileUtil::IOFile file;
+    u64 file_offset;
+    u64 data_size;
+
+    u8* mapping = nullptr;
+    std::size_t mapping_size = 0;
+    const u8* data = nullptr;
+
+    MappedRomFSReader() = default;
+
+    void Map();
+    void Unmap();
+
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int) {
+        ar& boost::serialization::base_object<RomFSReader>(*this);
+        ar & file;
+        ar & file_offset;
+        ar & data_size;
+        if (Archive::is_loading::value) {
+            Unmap();
+            Map();
+        }
+    }
+    friend class boost::serialization::access;
+};
+
+/**
+ * Writes the decrypted RomFS to a file, so that it can be read with a MappedRomFSReader. The file
+ * only appears at path once it was written completely.
+ * @return Whether the file was written successfully
+ */
+bool DecryptRomFS(FileUtil::IOFile& file, std::size_t file_offset, std::size_t data_size,
+                  const std::array<u8, 16>& key, const std::array<u8, 16>& ctr,
+                  std::size_t crypto_offset, const std::string& path);
+
 } // namespace FileSys
 
 BOOST_CLASS_EXPORT_KEY(FileSys::DirectRomFSReader)
+BOOST_CLASS_EXPORT_KEY(FileSys::MappedRomFSReader)
@@ -59,19 +59,20 @@ EmuWindow::~EmuWindow() = default;
 bool EmuWindow::IsWithinTouchscreen(const Layout::FramebufferLayout& layout, unsigned framebuffer_x,
                                     unsigned framebuffer_y) {
     // If separate windows and the touch is in the primary (top) screen, ignore it.
-    if (Settings::values.layout_option.GetValue() == Settings::LayoutOption::SeparateWindows &&
-        !is_secondary && !Settings::values.swap_screen.GetValue()) {
+    if (Settings::values().layout_option.GetValue() == Settings::LayoutOption::SeparateWindows &&
+        !is_secondary && !Settings::values().swap_screen.GetValue()) {
         return false;
     }
 
-    if (Settings::values.render_3d.GetValue() == Settings::StereoRenderOption::SideBySide) {
+    if (Settings::values().render_3d.GetValue() == Settings::StereoRenderOption::SideBySide) {
         return (framebuffer_y >= layout.bottom_screen.top &&
                 framebuffer_y < layout.bottom_screen.bottom &&
                 ((framebuffer_x >= layout.bottom_screen.left / 2 &&
                   framebuffer_x < layout.bottom_screen.right / 2) ||
                  (framebuffer_x >= (layout.bottom_screen.left / 2) + (layout.width / 2) &&
                   framebuffer_x < (layout.bottom_screen.right / 2) + (layout.width / 2))));
-    } else if (Settings::values.render_3d.GetValue() == Settings::StereoRenderOption::CardboardVR) {
+    } else if (Settings::values().render_3d.GetValue() ==
+               Settings::StereoRenderOption::CardboardVR) {
         return (framebuffer_y >= layout.bottom_screen.top &&
                 framebuffer_y < layout.bottom_screen.bottom &&
                 ((framebuffer_x >= layout.bottom_screen.left &&
@@ -89,13 +90,14 @@ bool EmuWindow::IsWithinTouchscreen(const Layout::FramebufferLayout& layout, uns
 
 std::tuple<unsigned, unsigned> EmuWindow::ClipToTouchScreen(unsigned new_x, unsigned new_y) const {
     if (new_x >= framebuffer_layout.width / 2) {
-        if (Settings::values.render_3d.GetValue() == Settings::StereoRenderOption::SideBySide)
+        if (Settings::values().render_3d.GetValue() == Settings::StereoRenderOption::SideBySide)
             new_x -= framebuffer_layout.width / 2;
-        else if (Settings::values.render_3d.GetValue() == Settings::StereoRenderOption::CardboardVR)
+        else if (Settings::values().render_3d.GetValue() ==
+                 Settings::StereoRenderOption::CardboardVR)
             new_x -=
                 (framebuffer_layout.width / 2) - (framebuffer_layout.cardboard.user_x_shift * 2);
     }
-    if (Settings::values.render_3d.GetValue() == Settings::StereoRenderOption::SideBySide) {
+    if (Settings::values().render_3d.GetValue() == Settings::StereoRenderOption::SideBySide) {
         new_x = std::max(new_x, framebuffer_layout.bottom_screen.left / 2);
         new_x = std::min(new_x, framebuffer_layout.bottom_screen.right / 2 - 1);
     } else {
@@ -124,14 +126,15 @@ bool EmuWindow::TouchPressed(unsigned framebuffer_x, unsigned framebuffer_y) {
         return false;
 
     if (framebuffer_x >= framebuffer_layout.width / 2) {
-        if (Settings::values.render_3d.GetValue() == Settings::StereoRenderOption::SideBySide)
+        if (Settings::values().render_3d.GetValue() == Settings::StereoRenderOption::SideBySide)
             framebuffer_x -= framebuffer_layout.width / 2;
-        else if (Settings::values.render_3d.GetValue() == Settings::StereoRenderOption::CardboardVR)
+        else if (Settings::values().render_3d.GetValue() ==
+                 Settings::StereoRenderOption::CardboardVR)
             framebuffer_x -=
                 (framebuffer_layout.width / 2) - (framebuffer_layout.cardboard.user_x_shift * 2);
     }
     std::scoped_lock guard(touch_state->mutex);
-    if (Settings::values.render_3d.GetValue() == Settings::StereoRenderOption::SideBySide) {
+    if (Settings::values().render_3d.GetValue() == Settings::StereoRenderOption::SideBySide) {
         touch_state->touch_x =
             static_cast<float>(framebuffer_x - framebuffer_layout.bottom_screen.left / 2) /
             (framebuffer_layout.bottom_screen.right / 2 -
@@ -177,12 +180,14 @@ void EmuWindow::UpdateCurrentFramebufferLayout(u32 width, u32 height, bool is_po
     // If in portrait mode, only the MobilePortrait option really makes sense
     const Settings::LayoutOption layout_option = is_portrait_mode
                                                      ? Settings::LayoutOption::MobilePortrait
-                                                     : Settings::values.layout_option.GetValue();
+                                                     : Settings::values().layout_option.GetValue();
     const auto min_size =
-        Layout::GetMinimumSizeFromLayout(layout_option, Settings::values.upright_screen.GetValue());
+        Layout::GetMinimumSizeFromLayout(layout_option,
+                                         Settings::values().upright_screen.GetValue());
 
-    if (Settings::values.custom_layout.GetValue() == true) {
-        layout = Layout::CustomFrameLayout(width, height, Settings::values.swap_screen.GetValue());
+    if (Settings::values().custom_layout.GetValue() == true) {
+        layout =
+            Layout::CustomFrameLayout(width, height, Settings::values().swap_screen.GetValue());
     } else {
         width = std::max(width, min_size.first);
         height = std::max(height, min_size.second);
@@ -190,50 +195,50 @@ void EmuWindow::UpdateCurrentFramebufferLayout(u32 width, u32 height, bool is_po
         switch (layout_option) {
         case Settings::LayoutOption::SingleScreen:
             layout =
-                Layout::SingleFrameLayout(width, height, Settings::values.swap_screen.GetValue(),
-                                          Settings::values.upright_screen.GetValue());
+                Layout::SingleFrameLayout(width, height, Settings::values().swap_screen.GetValue(),
+                                          Settings::values().upright_screen.GetValue());
             break;
         case Settings::LayoutOption::LargeScreen:
             layout =
-                Layout::LargeFrameLayout(width, height, Settings::values.swap_screen.GetValue(),
-                                         Settings::values.upright_screen.GetValue(),
-                                         Settings::values.large_screen_proportion.GetValue(),
+                Layout::LargeFrameLayout(width, height, Settings::values().swap_screen.GetValue(),
+                                         Settings::values().upright_screen.GetValue(),
+                                         Settings::values().large_screen_proportion.GetValue(),
                                          Layout::VerticalAlignment::Bottom);
             break;
         case Settings::LayoutOption::HybridScreen:
             layout =
-                Layout::HybridScreenLayout(width, height, Settings::values.swap_screen.GetValue(),
-                                           Settings::values.upright_screen.GetValue());
+                Layout::HybridScreenLayout(width, height, Settings::values().swap_screen.GetValue(),
+                                           Settings::values().upright_screen.GetValue());
             break;
         case Settings::LayoutOption::SideScreen:
             layout =
-                Layout::LargeFrameLayout(width, height, Settings::values.swap_screen.GetValue(),
-                                         Settings::values.upright_screen.GetValue(), 1.0f,
+                Layout::LargeFrameLayout(width, height, Settings::values().swap_screen.GetValue(),
+                                         Settings::values().upright_screen.GetValue(), 1.0f,
                                          Layout::VerticalAlignment::Bottom);
             break;
         case Settings::LayoutOption::SeparateWindows:
             layout = Layout::SeparateWindowsLayout(width, height, is_secondary,
-                                                   Settings::values.upright_screen.GetValue());
+                                                   Settings::values().upright_screen.GetValue());
             break;
         case Settings::LayoutOption::MobilePortrait:
             layout = Layout::MobilePortraitFrameLayout(width, height,
-                                                       Settings::values.swap_screen.GetValue());
+                                                       Settings::values().swap_screen.GetValue());
             break;
         case Settings::LayoutOption::MobileLandscape:
             layout =
-                Layout::LargeFrameLayout(width, height, Settings::values.swap_screen.GetValue(),
+                Layout::LargeFrameLayout(width, height, Settings::values().swap_screen.GetValue(),
                                          false, 2.25f, Layout::VerticalAlignment::Top);
             break;
         case Settings::LayoutOption::Default:
         default:
             layout =
-                Layout::DefaultFrameLayout(width, height, Settings::values.swap_screen.GetValue(),
-                                           Settings::values.upright_screen.GetValue());
+                Layout::DefaultFrameLayout(width, height, Settings::values().swap_screen.GetValue(),
+                                           Settings::values().upright_screen.GetValue());
             break;
         }
         UpdateMinimumWindowSize(min_size);
     }
-    if (Settings::values.render_3d.GetValue() == Settings::StereoRenderOption::CardboardVR) {
+    if (Settings::values().render_3d.GetValue() == Settings::StereoRenderOption::CardboardVR) {
         layout = Layout::GetCardboardSettings(layout);
     }
     NotifyFramebufferLayoutChanged(layout);
@@ -367,7 +367,7 @@ FramebufferLayout HybridScreenLayout(u32 width, u32 height, bool swapped, bool u
 FramebufferLayout SeparateWindowsLayout(u32 width, u32 height, bool is_secondary, bool upright) {
     // When is_secondary is true, we disable the top screen, and enable the bottom screen.
     // The same logic is found in the SingleFrameLayout using the is_swapped bool.
-    is_secondary = Settings::values.swap_screen ? !is_secondary : is_secondary;
+    is_secondary = Settings::values().swap_screen ? !is_secondary : is_secondary;
     return SingleFrameLayout(width, height, is_secondary, upright);
 }
 
@@ -375,16 +375,16 @@ FramebufferLayout CustomFrameLayout(u32 width, u32 height, bool is_swapped) {
     ASSERT(width > 0);
     ASSERT(height > 0);
 
-    FramebufferLayout res{width, height, true, true, {}, {}, !Settings::values.upright_screen};
+    FramebufferLayout res{width, height, true, true, {}, {}, !Settings::values().upright_screen};
 
-    Common::Rectangle<u32> top_screen{Settings::values.custom_top_left.GetValue(),
-                                      Settings::values.custom_top_top.GetValue(),
-                                      Settings::values.custom_top_right.GetValue(),
-                                      Settings::values.custom_top_bottom.GetValue()};
-    Common::Rectangle<u32> bot_screen{Settings::values.custom_bottom_left.GetValue(),
-                                      Settings::values.custom_bottom_top.GetValue(),
-                                      Settings::values.custom_bottom_right.GetValue(),
-                                      Settings::values.custom_bottom_bottom.GetValue()};
+    Common::Rectangle<u32> top_screen{Settings::values().custom_top_left.GetValue(),
+                                      Settings::values().custom_top_top.GetValue(),
+                                      Settings::values().custom_top_right.GetValue(),
+                                      Settings::values().custom_top_bottom.GetValue()};
+    Common::Rectangle<u32> bot_screen{Settings::values().custom_bottom_left.GetValue(),
+                                      Settings::values().custom_bottom_top.GetValue(),
+                                      Settings::values().custom_bottom_right.GetValue(),
+                                      Settings::values().custom_bottom_bottom.GetValue()};
 
     if (is_swapped) {
         res.top_screen = bot_screen;
@@ -397,19 +397,19 @@ FramebufferLayout CustomFrameLayout(u32 width, u32 height, bool is_swapped) {
 }
 
 FramebufferLayout FrameLayoutFromResolutionScale(u32 res_scale, bool is_secondary) {
-    if (Settings::values.custom_layout.GetValue() == true) {
-        return CustomFrameLayout(std::max(Settings::values.custom_top_right.GetValue(),
-                                          Settings::values.custom_bottom_right.GetValue()),
-                                 std::max(Settings::values.custom_top_bottom.GetValue(),
-                                          Settings::values.custom_bottom_bottom.GetValue()),
-                                 Settings::values.swap_screen.GetValue());
+    if (Settings::values().custom_layout.GetValue() == true) {
+        return CustomFrameLayout(std::max(Settings::values().custom_top_right.GetValue(),
+                                          Settings::values().custom_bottom_right.GetValue()),
+                                 std::max(Settings::values().custom_top_bottom.GetValue(),
+                                          Settings::values().custom_bottom_bottom.GetValue()),
+                                 Settings::values().swap_screen.GetValue());
     }
 
     int width, height;
-    switch (Settings::values.layout_option.GetValue()) {
+    switch (Settings::values().layout_option.GetValue()) {
     case Settings::LayoutOption::SingleScreen:
     case Settings::LayoutOption::SeparateWindows: {
-        const bool swap_screens = is_secondary || Settings::values.swap_screen.GetValue();
+        const bool swap_screens = is_secondary || Settings::values().swap_screen.GetValue();
         if (swap_screens) {
             width = Core::kScreenBottomWidth * res_scale;
             height = Core::kScreenBottomHeight * res_scale;
@@ -417,54 +417,54 @@ FramebufferLayout FrameLayoutFromResolutionScale(u32 res_scale, bool is_secondar
             width = Core::kScreenTopWidth * res_scale;
             height = Core::kScreenTopHeight * res_scale;
         }
-        if (Settings::values.upright_screen.GetValue()) {
+        if (Settings::values().upright_screen.GetValue()) {
             std::swap(width, height);
         }
         return SingleFrameLayout(width, height, swap_screens,
-                                 Settings::values.upright_screen.GetValue());
+                                 Settings::values().upright_screen.GetValue());
     }
 
     case Settings::LayoutOption::LargeScreen:
-        if (Settings::values.swap_screen.GetValue()) {
+        if (Settings::values().swap_screen.GetValue()) {
             width = (Core::kScreenBottomWidth +
                      Core::kScreenTopWidth /
-                         static_cast<int>(Settings::values.large_screen_proportion.GetValue())) *
+                         static_cast<int>(Settings::values().large_screen_proportion.GetValue())) *
                     res_scale;
             height = Core::kScreenBottomHeight * res_scale;
         } else {
             width = (Core::kScreenTopWidth +
                      Core::kScreenBottomWidth /
-                         static_cast<int>(Settings::values.large_screen_proportion.GetValue())) *
+                         static_cast<int>(Settings::values().large_screen_proportion.GetValue())) *
                     res_scale;
             height = Core::kScreenTopHeight * res_scale;
         }
-        if (Settings::values.upright_screen.GetValue()) {
+        if (Settings::values().upright_screen.GetValue()) {
             std::swap(width, height);
         }
-        return LargeFrameLayout(width, height, Settings::values.swap_screen.GetValue(),
-                                Settings::values.upright_screen.GetValue(),
-                                Settings::values.large_screen_proportion.GetValue(),
+        return LargeFrameLayout(width, height, Settings::values().swap_screen.GetValue(),
+                                Settings::values().upright_screen.GetValue(),
+                                Settings::values().large_screen_proportion.GetValue(),
                                 VerticalAlignment::Bottom);
 
     case Settings::LayoutOption::SideScreen:
         width = (Core::kScreenTopWidth + Core::kScreenBottomWidth) * res_scale;
         height = Core::kScreenTopHeight * res_scale;
 
-        if (Settings::values.upright_screen.GetValue()) {
+        if (Settings::values().upright_screen.GetValue()) {
             std::swap(width, height);
         }
-        return LargeFrameLayout(width, height, Settings::values.swap_screen.GetValue(),
-                                Settings::values.upright_screen.GetValue(), 1,
+        return LargeFrameLayout(width, height, Settings::values().swap_screen.GetValue(),
+                                Settings::values().upright_screen.GetValue(), 1,
                                 VerticalAlignment::Middle);
 
     case Settings::LayoutOption::MobilePortrait:
         width = Core::kScreenTopWidth * res_scale;
         height = (Core::kScreenTopHeight + Core::kScreenBottomHeight) * res_scale;
-        return MobilePortraitFrameLayout(width, height, Settings::values.swap_screen.GetValue());
+        return MobilePortraitFrameLayout(width, height, Settings::values().swap_screen.GetValue());
 
     case Settings::LayoutOption::MobileLandscape: {
         constexpr float large_screen_proportion = 2.25f;
-        if (Settings::values.swap_screen.GetValue()) {
+        if (Settings::values().swap_screen.GetValue()) {
             width = (Core::kScreenBottomWidth +
                      static_cast<int>(Core::kScreenTopWidth / large_screen_proportion)) *
                     res_scale;
@@ -475,7 +475,7 @@ FramebufferLayout FrameLayoutFromResolutionScale(u32 res_scale, bool is_secondar
                     res_scale;
             height = Core::kScreenTopHeight * res_scale;
         }
-        return LargeFrameLayout(width, height, Settings::values.swap_screen.GetValue(), false,
+        return LargeFrameLayout(width, height, Settings::values().swap_screen.GetValue(), false,
                                 large_screen_proportion, VerticalAlignment::Top);
     }
 
@@ -484,11 +484,11 @@ FramebufferLayout FrameLayoutFromResolutionScale(u32 res_scale, bool is_secondar
         width = Core::kScreenTopWidth * res_scale;
         height = (Core::kScreenTopHeight + Core::kScreenBottomHeight) * res_scale;
 
-        if (Settings::values.upright_screen.GetValue()) {
+        if (Settings::values().upright_screen.GetValue()) {
             std::swap(width, height);
         }
-        return DefaultFrameLayout(width, height, Settings::values.swap_screen.GetValue(),
-                                  Settings::values.upright_screen.GetValue());
+        return DefaultFrameLayout(width, height, Settings::values().swap_screen.GetValue(),
+                                  Settings::values().upright_screen.GetValue());
     }
     UNREACHABLE();
 }
@@ -499,19 +499,19 @@ FramebufferLayout GetCardboardSettings(const FramebufferLayout& layout) {
     u32 bottom_screen_left = 0;
     u32 bottom_screen_top = 0;
 
-    u32 cardboard_screen_scale = Settings::values.cardboard_screen_size.GetValue();
+    u32 cardboard_screen_scale = Settings::values().cardboard_screen_size.GetValue();
     u32 top_screen_width = ((layout.top_screen.GetWidth() / 2) * cardboard_screen_scale) / 100;
     u32 top_screen_height = ((layout.top_screen.GetHeight() / 2) * cardboard_screen_scale) / 100;
     u32 bottom_screen_width =
         ((layout.bottom_screen.GetWidth() / 2) * cardboard_screen_scale) / 100;
     u32 bottom_screen_height =
         ((layout.bottom_screen.GetHeight() / 2) * cardboard_screen_scale) / 100;
-    const bool is_swapped = Settings::values.swap_screen.GetValue();
+    const bool is_swapped = Settings::values().swap_screen.GetValue();
     const bool is_portrait = layout.height > layout.width;
 
     u32 cardboard_screen_width;
     u32 cardboard_screen_height;
-    switch (Settings::values.layout_option.GetValue()) {
+    switch (Settings::values().layout_option.GetValue()) {
     case Settings::LayoutOption::MobileLandscape:
     case Settings::LayoutOption::SideScreen:
         // If orientation is portrait, only use MobilePortrait
@@ -548,10 +548,10 @@ FramebufferLayout GetCardboardSettings(const FramebufferLayout& layout) {
     }
     s32 cardboard_max_x_shift = (layout.width / 2 - cardboard_screen_width) / 2;
     s32 cardboard_user_x_shift =
-        (Settings::values.cardboard_x_shift.GetValue() * cardboard_max_x_shift) / 100;
+        (Settings::values().cardboard_x_shift.GetValue() * cardboard_max_x_shift) / 100;
     s32 cardboard_max_y_shift = (layout.height - cardboard_screen_height) / 2;
     s32 cardboard_user_y_shift =
-        (Settings::values.cardboard_y_shift.GetValue() * cardboard_max_y_shift) / 100;
+        (Settings::values().cardboard_y_shift.GetValue() * cardboard_max_y_shift) / 100;
 
     // Center the screens and apply user Y shift
     FramebufferLayout new_layout = layout;
@@ -585,16 +585,18 @@ std::pair<unsigned, unsigned> GetMinimumSizeFromLayout(Settings::LayoutOption la
     switch (layout) {
     case Settings::LayoutOption::SingleScreen:
     case Settings::LayoutOption::SeparateWindows:
-        min_width = Settings::values.swap_screen ? Core::kScreenBottomWidth : Core::kScreenTopWidth;
+        min_width =
+            Settings::values().swap_screen ? Core::kScreenBottomWidth : Core::kScreenTopWidth;
         min_height = Core::kScreenBottomHeight;
         break;
     case Settings::LayoutOption::LargeScreen:
         min_width = static_cast<u32>(
-            Settings::values.swap_screen
-                ? Core::kScreenTopWidth / Settings::values.large_screen_proportion.GetValue() +
+            Settings::values().swap_screen
+                ? Core::kScreenTopWidth / Settings::values().large_screen_proportion.GetValue() +
                       Core::kScreenBottomWidth
-                : Core::kScreenTopWidth + Core::kScreenBottomWidth /
-                                              Settings::values.large_screen_proportion.GetValue());
+                : Core::kScreenTopWidth +
+                      Core::kScreenBottomWidth /
+                          Settings::values().large_screen_proportion.GetValue());
         min_height = Core::kScreenBottomHeight;
         break;
     case Settings::LayoutOption::SideScreen:
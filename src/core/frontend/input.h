@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -38,14 +39,19 @@ namespace Impl {
 template <typename InputDeviceType>
 using FactoryListType = std::unordered_map<std::string, std::shared_ptr<Factory<InputDeviceType>>>;
 
+// Emulator instances on different threads register and use factories concurrently
 template <typename InputDeviceType>
 struct FactoryList {
     static FactoryListType<InputDeviceType> list;
+    static std::mutex mutex;
 };
 
 template <typename InputDeviceType>
 FactoryListType<InputDeviceType> FactoryList<InputDeviceType>::list;
 
+template <typename InputDeviceType>
+std::mutex FactoryList<InputDeviceType>::mutex;
+
 } // namespace Impl
 
 /**
@@ -58,6 +64,7 @@ FactoryListType<InputDeviceType> FactoryList<InputDeviceType>::list;
 template <typename InputDeviceType>
 void RegisterFactory(const std::string& name, std::shared_ptr<Factory<InputDeviceType>> factory) {
     auto pair = std::make_pair(name, std::move(factory));
+    std::scoped_lock lock{Impl::FactoryList<InputDeviceType>::mutex};
     if (!Impl::FactoryList<InputDeviceType>::list.insert(std::move(pair)).second) {
         LOG_ERROR(Input, "Factory {} already registered", name);
     }
@@ -70,6 +77,7 @@ void RegisterFactory(const std::string& name, std::shared_ptr<Factory<InputDevic
  */
 template <typename InputDeviceType>
 void UnregisterFactory(const std::string& name) {
+    std::scoped_lock lock{Impl::FactoryList<InputDeviceType>::mutex};
     if (Impl::FactoryList<InputDeviceType>::list.erase(name) == 0) {
         LOG_ERROR(Input, "Factory {} not registered", name);
     }
@@ -84,6 +92,7 @@ template <typename InputDeviceType>
 std::unique_ptr<InputDeviceType> CreateDevice(const std::string& params) {
     const Common::ParamPackage package(params);
     const std::string engine = package.Get("engine", "null");
+    std::scoped_lock lock{Impl::FactoryList<InputDeviceType>::mutex};
     const auto& factory_list = Impl::FactoryList<InputDeviceType>::list;
     const auto pair = factory_list.find(engine);
     if (pair == factory_list.end()) {
@@ -43,7 +43,7 @@ static const u32 memory_region_sizes[8][3] = {
 
 void KernelSystem::MemoryInit(MemoryMode memory_mode, New3dsMemoryMode n3ds_mode,
                               u64 override_init_time) {
-    const bool is_new_3ds = Settings::values.is_new_3ds.GetValue();
+    const bool is_new_3ds = Settings::values().is_new_3ds.GetValue();
     u32 mem_type_index = static_cast<u32>(memory_mode);
     u32 reported_mem_type = static_cast<u32>(memory_mode);
     if (is_new_3ds) {
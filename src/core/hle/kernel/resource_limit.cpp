@@ -78,7 +78,7 @@ SERIALIZE_IMPL(ResourceLimit)
 ResourceLimitList::ResourceLimitList(KernelSystem& kernel) {
     // PM makes APPMEMALLOC always match app RESLIMIT_COMMIT.
     // See: https://github.com/LumaTeam/Luma3DS/blob/e2778a45/sysmodules/pm/source/reslimit.c#L275
-    const bool is_new_3ds = Settings::values.is_new_3ds.GetValue();
+    const bool is_new_3ds = Settings::values().is_new_3ds.GetValue();
     const auto& appmemalloc = kernel.GetMemoryRegion(MemoryRegion::APPLICATION);
 
     // Create the Application resource limit
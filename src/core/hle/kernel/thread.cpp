@@ -435,7 +435,7 @@ std::shared_ptr<Thread> SetupMainThread(KernelSystem& kernel, u32 entry_point, u
 
     s64 sleep_time_ns = 0;
     if (!is_lle_service && kernel.GetAppMainThreadExtendedSleep()) {
-        if (Settings::values.delay_start_for_lle_modules) {
+        if (Settings::values().delay_start_for_lle_modules) {
             sleep_time_ns = sleep_app_thread_ns;
         }
         kernel.SetAppMainThreadExtendedSleep(false);
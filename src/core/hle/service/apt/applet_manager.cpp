@@ -116,7 +116,7 @@ static u64 GetTitleIdForApplet(AppletId id, u32 region_value) {
     ASSERT_MSG(itr != applet_titleids.end(), "Unknown applet id 0x{:#05X}", id);
 
     auto n3ds_title_id = itr->n3ds_title_ids[region_value];
-    if (n3ds_title_id != 0 && Settings::values.is_new_3ds.GetValue()) {
+    if (n3ds_title_id != 0 && Settings::values().is_new_3ds.GetValue()) {
         return n3ds_title_id;
     }
     return itr->title_ids[region_value];
@@ -572,7 +572,7 @@ Result AppletManager::PrepareToStartLibraryApplet(AppletId applet_id) {
 
     capture_buffer_info.reset();
 
-    if (Settings::values.lle_applets) {
+    if (Settings::values().lle_applets) {
         auto cfg = Service::CFG::GetModule(system);
         auto process = NS::LaunchTitle(FS::MediaType::NAND,
                                        GetTitleIdForApplet(applet_id, cfg->GetRegionValue()));
@@ -601,7 +601,7 @@ Result AppletManager::PreloadLibraryApplet(AppletId applet_id) {
     last_library_launcher_slot = active_slot;
     last_prepared_library_applet = applet_id;
 
-    if (Settings::values.lle_applets) {
+    if (Settings::values().lle_applets) {
         auto cfg = Service::CFG::GetModule(system);
         auto process = NS::LaunchTitle(FS::MediaType::NAND,
                                        GetTitleIdForApplet(applet_id, cfg->GetRegionValue()));
@@ -1192,7 +1192,7 @@ ResultVal<Service::FS::MediaType> AppletManager::Unknown54(u32 in_param) {
 }
 
 TargetPlatform AppletManager::GetTargetPlatform() {
-    if (Settings::values.is_new_3ds.GetValue() && !new_3ds_mode_blocked) {
+    if (Settings::values().is_new_3ds.GetValue() && !new_3ds_mode_blocked) {
         return TargetPlatform::New3ds;
     } else {
         return TargetPlatform::Old3ds;
@@ -1504,9 +1504,9 @@ void AppletManager::CaptureFrameBuffers() {
 
 void AppletManager::LoadInputDevices() {
     home_button = Input::CreateDevice<Input::ButtonDevice>(
-        Settings::values.current_input_profile.buttons[Settings::NativeButton::Home]);
+        Settings::values().current_input_profile.buttons[Settings::NativeButton::Home]);
     power_button = Input::CreateDevice<Input::ButtonDevice>(
-        Settings::values.current_input_profile.buttons[Settings::NativeButton::Power]);
+        Settings::values().current_input_profile.buttons[Settings::NativeButton::Power]);
 }
 
 /// Handles updating the current Applet every time it's called.
@@ -1412,7 +1412,7 @@ void Module::APTInterface::IsStandardMemoryLayout(Kernel::HLERequestContext& ctx
     LOG_DEBUG(Service_APT, "called");
 
     bool is_standard;
-    if (Settings::values.is_new_3ds) {
+    if (Settings::values().is_new_3ds) {
         // Memory layout is standard if it is not NewDev1 (178MB)
         is_standard = apt->system.Kernel().GetNew3dsHwCapabilities().memory_mode !=
                       Kernel::New3dsMemoryMode::NewDev1;
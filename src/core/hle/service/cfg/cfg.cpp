@@ -198,12 +198,12 @@ void Module::Interface::GetCountryCodeID(Kernel::HLERequestContext& ctx) {
 }
 
 u32 Module::GetRegionValue() {
-    if (Settings::values.region_value.GetValue() == Settings::REGION_VALUE_AUTO_SELECT) {
+    if (Settings::values().region_value.GetValue() == Settings::REGION_VALUE_AUTO_SELECT) {
         UpdatePreferredRegionCode();
         return preferred_region_code;
     }
 
-    return Settings::values.region_value.GetValue();
+    return Settings::values().region_value.GetValue();
 }
 
 void Module::Interface::GetRegion(Kernel::HLERequestContext& ctx) {
@@ -296,11 +296,11 @@ void Module::Interface::GetSystemModel(Kernel::HLERequestContext& ctx) {
     std::memcpy(&model, &data, 4);
     if ((model.model == NINTENDO_3DS || model.model == NINTENDO_3DS_XL ||
          model.model == NINTENDO_2DS) &&
-        Settings::values.is_new_3ds) {
+        Settings::values().is_new_3ds) {
         model.model = NEW_NINTENDO_3DS_XL;
     } else if ((model.model == NEW_NINTENDO_3DS || model.model == NEW_NINTENDO_3DS_XL ||
                 model.model == NEW_NINTENDO_2DS_XL) &&
-               !Settings::values.is_new_3ds) {
+               !Settings::values().is_new_3ds) {
         model.model = NINTENDO_3DS_XL;
     }
     std::memcpy(&data, &model, 4);
@@ -717,7 +717,7 @@ void Module::SetSystemLanguage(SystemLanguage language) {
 }
 
 SystemLanguage Module::GetSystemLanguage() {
-    if (Settings::values.region_value.GetValue() == Settings::REGION_VALUE_AUTO_SELECT) {
+    if (Settings::values().region_value.GetValue() == Settings::REGION_VALUE_AUTO_SELECT) {
         UpdatePreferredRegionCode();
     }
     return GetRawSystemLanguage();
@@ -364,7 +364,7 @@ void FS_USER::IsSdmcDetected(Kernel::HLERequestContext& ctx) {
     IPC::RequestParser rp(ctx);
     IPC::RequestBuilder rb = rp.MakeBuilder(2, 0);
     rb.Push(ResultSuccess);
-    rb.Push(Settings::values.use_virtual_sd.GetValue());
+    rb.Push(Settings::values().use_virtual_sd.GetValue());
 }
 
 void FS_USER::IsSdmcWriteable(Kernel::HLERequestContext& ctx) {
@@ -372,7 +372,7 @@ void FS_USER::IsSdmcWriteable(Kernel::HLERequestContext& ctx) {
     IPC::RequestBuilder rb = rp.MakeBuilder(2, 0);
     rb.Push(ResultSuccess);
     // If the SD isn't enabled, it can't be writeable...else, stubbed true
-    rb.Push(Settings::values.use_virtual_sd.GetValue());
+    rb.Push(Settings::values().use_virtual_sd.GetValue());
     LOG_DEBUG(Service_FS, " (STUBBED)");
 }
 
@@ -1938,7 +1938,7 @@ bool HTTP_C::PerformStateChecks(Kernel::HLERequestContext& ctx, IPC::RequestPars
     }
 
     // don't allow HTTP usage when we want determinism
-    if (!Settings::values.want_determinism.GetValue()) {
+    if (!Settings::values().want_determinism.GetValue()) {
         IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
         rb.Push(ErrorStateError);
         return false;
@@ -175,8 +175,7 @@ std::vector<u8> GenerateInternalKey(const HW::AES::NfcSecret& secret, const Hash
     output.insert(output.end(), seed.uid_2.begin(), seed.uid_2.end());
     output.emplace_back(seed.nintendo_id_2);
 
-    HW::AES::SelectDlpNfcKeyYIndex(HW::AES::DlpNfcKeyY::Nfc);
-    auto nfc_key = HW::AES::GetNormalKey(HW::AES::KeySlotID::DLPNFCDataKey);
+    auto nfc_key = HW::AES::GetDlpNfcKey(HW::AES::DlpNfcKeyY::Nfc).value_or(HW::AES::AESKey{});
     auto nfc_iv = HW::AES::GetNfcIv();
 
     // Decrypt the keygen salt using the NFC key and IV.
@@ -194,7 +194,7 @@ void PLG_LDR::SetEnabled(Kernel::HLERequestContext& ctx) {
     bool can_change = enabled == plgldr_context.is_enabled || plgldr_context.allow_game_change;
     if (can_change) {
         plgldr_context.is_enabled = enabled;
-        Settings::values.plugin_loader_enabled.SetValue(enabled);
+        Settings::values().plugin_loader_enabled.SetValue(enabled);
     }
     IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
     rb.Push((can_change) ? ResultSuccess : Kernel::ResultNotAuthorized);
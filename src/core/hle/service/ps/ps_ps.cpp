@@ -61,19 +61,22 @@ void PS_PS::EncryptDecryptAes(Kernel::HLERequestContext& ctx) {
     // and encrypted data is actually returned, but the key used is unknown.
     ASSERT_MSG(key_type != 7 && key_type < 10, "Key type is invalid");
 
+    std::optional<HW::AES::AESKey> normal_key;
     if (key_type == 0x5) {
-        HW::AES::SelectDlpNfcKeyYIndex(HW::AES::DlpNfcKeyY::Dlp);
+        normal_key = HW::AES::GetDlpNfcKey(HW::AES::DlpNfcKeyY::Dlp);
     } else if (key_type == 0x9) {
-        HW::AES::SelectDlpNfcKeyYIndex(HW::AES::DlpNfcKeyY::Nfc);
+        normal_key = HW::AES::GetDlpNfcKey(HW::AES::DlpNfcKeyY::Nfc);
+    } else if (HW::AES::IsNormalKeyAvailable(KeyTypes[key_type])) {
+        normal_key = HW::AES::GetNormalKey(KeyTypes[key_type]);
     }
 
-    if (!HW::AES::IsNormalKeyAvailable(KeyTypes[key_type])) {
+    if (!normal_key) {
         LOG_ERROR(Service_PS,
                   "Key 0x{:2X} is not available, encryption/decryption will not be correct",
                   KeyTypes[key_type]);
     }
 
-    HW::AES::AESKey key = HW::AES::GetNormalKey(KeyTypes[key_type]);
+    HW::AES::AESKey key = normal_key.value_or(HW::AES::AESKey{});
 
     if (algorithm == AlgorithmType::CCM_Encrypt || algorithm == AlgorithmType::CCM_Decrypt) {
         // AES-CCM is not supported with this function
@@ -154,7 +157,7 @@ void PS_PS::GenerateRandomBytes(Kernel::HLERequestContext& ctx) {
     auto buffer = rp.PopMappedBuffer();
 
     std::vector<u8> out_data(size);
-    if (Settings::values.want_determinism.GetValue()) {
+    if (Settings::values().want_determinism.GetValue()) {
         std::generate(out_data.begin(), out_data.end(),
                       [this] { return deterministic_random_gen() >> 24; });
     } else {
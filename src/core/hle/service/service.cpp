@@ -196,7 +196,7 @@ std::string ServiceFrameworkBase::GetFunctionName(IPC::Header header) const {
 }
 
 static bool AttemptLLE(const ServiceModuleInfo& service_module) {
-    if (!Settings::values.lle_modules.at(service_module.name))
+    if (!Settings::values().lle_modules.at(service_module.name))
         return false;
     std::unique_ptr<Loader::AppLoader> loader =
         Loader::GetLoader(AM::GetTitleContentPath(FS::MediaType::NAND, service_module.title_id));
@@ -448,7 +448,7 @@ std::optional<std::reference_wrapper<SocketHolder>> SOC_U::GetSocketHolder(u32 c
     }
     // block socket usage if we want determinism
     // (this shouldn't be reachable, but just in case)
-    if (Settings::values.want_determinism.GetValue()) {
+    if (Settings::values().want_determinism.GetValue()) {
         IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
         rb.Push(ResultInvalidSocketDescriptor);
         return std::nullopt;
@@ -814,7 +814,7 @@ void SOC_U::Socket(Kernel::HLERequestContext& ctx) {
     IPC::RequestBuilder rb = rp.MakeBuilder(2, 0);
 
     // block socket usage if we want determinism
-    if (Settings::values.want_determinism.GetValue()) {
+    if (Settings::values().want_determinism.GetValue()) {
         rb.Push(UnimplementedFunction(ErrorModule::SOC));
         rb.Skip(1, false);
         return;
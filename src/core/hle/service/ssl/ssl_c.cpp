@@ -30,7 +30,7 @@ void SSL_C::GenerateRandomData(Kernel::HLERequestContext& ctx) {
     auto buffer = rp.PopMappedBuffer();
 
     std::vector<u8> out_data(size);
-    if (Settings::values.want_determinism.GetValue()) {
+    if (Settings::values().want_determinism.GetValue()) {
         std::generate(out_data.begin(), out_data.end(),
                       [this] { return deterministic_random_gen() >> 24; });
     } else {
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <boost/iostreams/device/file_descriptor.hpp>
@@ -105,11 +106,15 @@ struct KeySlot {
     }
 
     void GenerateNormalKey() {
-        if (x && y) {
-            normal = Lrot128(Add128(Xor128(Lrot128(*x, 2), *y), generator_constant), 87);
-        } else {
-            normal.reset();
+        normal = y ? GenerateNormalKey(*y) : std::nullopt;
+    }
+
+    /// Returns the normal key for the KeyX of this slot and the given KeyY
+    std::optional<AESKey> GenerateNormalKey(const AESKey& key_y) const {
+        if (!x) {
+            return std::nullopt;
         }
+        return Lrot128(Add128(Xor128(Lrot128(*x, 2), key_y), generator_constant), 87);
     }
 
     void Clear() {
@@ -119,6 +124,9 @@ struct KeySlot {
     }
 };
 
+// The keys are shared by all emulator instances of the process. Keys derived from a KeyY which
+// depends on the loaded content are generated without changing the slots, see GenerateNormalKey.
+std::mutex keys_mutex;
 std::array<KeySlot, KeySlotID::MaxKeySlotID> key_slots;
 std::array<std::optional<AESKey>, MaxCommonKeySlot> common_key_y_slots;
 std::array<std::optional<AESKey>, NumDlpNfcKeyYs> dlp_nfc_key_y_slots;
@@ -311,6 +319,7 @@ void LoadPresetKeys() {
 } // namespace
 
 void InitKeys(bool force) {
+    std::scoped_lock lock{keys_mutex};
     static bool initialized = false;
     if (initialized && !force) {
         return;
@@ -322,35 +331,56 @@ void InitKeys(bool force) {
 }
 
 void SetKeyX(std::size_t slot_id, const AESKey& key) {
+    std::scoped_lock lock{keys_mutex};
     key_slots.at(slot_id).SetKeyX(key);
 }
 
 void SetKeyY(std::size_t slot_id, const AESKey& key) {
+    std::scoped_lock lock{keys_mutex};
     key_slots.at(slot_id).SetKeyY(key);
 }
 
 void SetNormalKey(std::size_t slot_id, const AESKey& key) {
+    std::scoped_lock lock{keys_mutex};
     key_slots.at(slot_id).SetNormalKey(key);
 }
 
 bool IsKeyXAvailable(std::size_t slot_id) {
+    std::scoped_lock lock{keys_mutex};
     return key_slots.at(slot_id).x.has_value();
 }
 
 bool IsNormalKeyAvailable(std::size_t slot_id) {
+    std::scoped_lock lock{keys_mutex};
     return key_slots.at(slot_id).normal.has_value();
 }
 
 AESKey GetNormalKey(std::size_t slot_id) {
+    std::scoped_lock lock{keys_mutex};
     return key_slots.at(slot_id).normal.value_or(AESKey{});
 }
 
-void SelectCommonKeyIndex(u8 index) {
-    key_slots[KeySlotID::TicketCommonKey].SetKeyY(common_key_y_slots.at(index));
+std::optional<AESKey> GenerateNormalKey(std::size_t slot_id, const AESKey& key_y) {
+    std::scoped_lock lock{keys_mutex};
+    return key_slots.at(slot_id).GenerateNormalKey(key_y);
+}
+
+std::optional<AESKey> GetCommonKey(u8 index) {
+    std::scoped_lock lock{keys_mutex};
+    const auto& key_y = common_key_y_slots.at(index);
+    if (!key_y) {
+        return std::nullopt;
+    }
+    return key_slots[KeySlotID::TicketCommonKey].GenerateNormalKey(*key_y);
 }
 
-void SelectDlpNfcKeyYIndex(u8 index) {
-    key_slots[KeySlotID::DLPNFCDataKey].SetKeyY(dlp_nfc_key_y_slots.at(index));
+std::optional<AESKey> GetDlpNfcKey(DlpNfcKeyY index) {
+    std::scoped_lock lock{keys_mutex};
+    const auto& key_y = dlp_nfc_key_y_slots.at(index);
+    if (!key_y) {
+        return std::nullopt;
+    }
+    return key_slots[KeySlotID::DLPNFCDataKey].GenerateNormalKey(*key_y);
 }
 
 bool NfcSecretsAvailable() {
@@ -359,8 +389,7 @@ bool NfcSecretsAvailable() {
             return nfc_secret.phrase.empty() || nfc_secret.seed.empty() ||
                    nfc_secret.hmac_key.empty();
         });
-    SelectDlpNfcKeyYIndex(DlpNfcKeyY::Nfc);
-    return IsNormalKeyAvailable(KeySlotID::DLPNFCDataKey) && missing_secret == nfc_secrets.end();
+    return GetDlpNfcKey(DlpNfcKeyY::Nfc).has_value() && missing_secret == nfc_secrets.end();
 }
 
 const NfcSecret& GetNfcSecret(NfcSecretId secret_id) {
@@ -6,6 +6,7 @@
 
 #include <array>
 #include <cstddef>
+#include <optional>
 #include <vector>
 #include "common/common_types.h"
 
@@ -84,8 +85,14 @@ bool IsKeyXAvailable(std::size_t slot_id);
 bool IsNormalKeyAvailable(std::size_t slot_id);
 AESKey GetNormalKey(std::size_t slot_id);
 
-void SelectCommonKeyIndex(u8 index);
-void SelectDlpNfcKeyYIndex(u8 index);
+/// Returns the normal key the slot would have with the given KeyY, without changing the slot.
+/// Returns std::nullopt if the KeyX of the slot is missing.
+std::optional<AESKey> GenerateNormalKey(std::size_t slot_id, const AESKey& key_y);
+
+/// Returns the ticket common key with the specified index, or std::nullopt if it is missing.
+std::optional<AESKey> GetCommonKey(u8 index);
+/// Returns the DLP or NFC data key, or std::nullopt if it is missing.
+std::optional<AESKey> GetDlpNfcKey(DlpNfcKeyY index);
 
 bool NfcSecretsAvailable();
 const NfcSecret& GetNfcSecret(NfcSecretId secret_id);
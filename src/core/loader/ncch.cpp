@@ -161,7 +161,7 @@ ResultStatus AppLoader_NCCH::LoadExec(std::shared_ptr<Kernel::Process>& process)
         auto& ncch_caps = overlay_ncch->exheader_header.arm11_system_local_caps;
         const auto o3ds_mode = static_cast<Kernel::MemoryMode>(ncch_caps.system_mode.Value());
         const auto n3ds_mode = static_cast<Kernel::New3dsMemoryMode>(ncch_caps.n3ds_mode);
-        const bool is_new_3ds = Settings::values.is_new_3ds.GetValue();
+        const bool is_new_3ds = Settings::values().is_new_3ds.GetValue();
         if (is_new_3ds && n3ds_mode == Kernel::New3dsMemoryMode::Legacy &&
             category == Kernel::ResourceLimitCategory::Application) {
             u64 new_limit = 0;
@@ -216,7 +216,7 @@ ResultStatus AppLoader_NCCH::LoadExec(std::shared_ptr<Kernel::Process>& process)
 }
 
 void AppLoader_NCCH::ParseRegionLockoutInfo(u64 program_id) {
-    if (Settings::values.region_value.GetValue() != Settings::REGION_VALUE_AUTO_SELECT) {
+    if (Settings::values().region_value.GetValue() != Settings::REGION_VALUE_AUTO_SELECT) {
         return;
     }
 
@@ -4,13 +4,21 @@
 
 #include <array>
 #include <cstring>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <boost/container/small_vector.hpp>
 #include <boost/serialization/array.hpp>
 #include <boost/serialization/binary_object.hpp>
+#include <boost/serialization/utility.hpp>
 #include "audio_core/dsp_interface.h"
 #include "common/archives.h"
 #include "common/assert.h"
 #include "common/atomic_ops.h"
 #include "common/common_types.h"
+#include "common/hash.h"
+#include "common/host_memory.h"
 #include "common/logging/log.h"
 #include "common/settings.h"
 #include "common/swap.h"
@@ -30,10 +38,32 @@ SERIALIZE_EXPORT_IMPL(Memory::MemorySystem::BackingMemImpl<Memory::Region::N3DS>
 
 namespace Memory {
 
+/// The fastmem arena covers the whole 32-bit guest address space
+constexpr std::size_t FASTMEM_ARENA_SIZE =
+    static_cast<std::size_t>(PAGE_TABLE_NUM_ENTRIES) * ENCORE_PAGE_SIZE;
+
+PageTable::PageTable() {
+    if (Settings::values().use_cpu_jit && Settings::values().use_fastmem) {
+        fastmem_arena = std::make_unique<Common::HostArena>(FASTMEM_ARENA_SIZE);
+        if (!fastmem_arena->IsValid()) {
+            fastmem_arena.reset();
+        }
+    }
+}
+
+PageTable::~PageTable() = default;
+
+u8* PageTable::GetFastmemPointer() const {
+    return fastmem_arena ? fastmem_arena->BasePointer() : nullptr;
+}
+
 void PageTable::Clear() {
     pointers.raw.fill(nullptr);
     pointers.refs.fill(MemoryRef());
     attributes.fill(PageType::Unmapped);
+    if (fastmem_arena) {
+        fastmem_arena->Unmap(0, FASTMEM_ARENA_SIZE);
+    }
 }
 
 class RasterizerCacheMarker {
@@ -86,11 +116,13 @@ private:
 
 class MemorySystem::Impl {
 public:
-    // Visual Studio would try to allocate these on compile time
-    // if they are std::array which would exceed the memory limit.
-    std::unique_ptr<u8[]> fcram = std::make_unique<u8[]>(Memory::FCRAM_N3DS_SIZE);
-    std::unique_ptr<u8[]> vram = std::make_unique<u8[]>(Memory::VRAM_SIZE);
-    std::unique_ptr<u8[]> n3ds_extra_ram = std::make_unique<u8[]>(Memory::N3DS_EXTRA_RAM_SIZE);
+    // FCRAM, VRAM and the N3DS extra RAM share a single allocation, so that they can be mapped
+    // into the fastmem arenas of the page tables.
+    Common::HostMemory backing{Memory::FCRAM_N3DS_SIZE + Memory::VRAM_SIZE +
+                               Memory::N3DS_EXTRA_RAM_SIZE};
+    u8* const fcram = backing.BasePointer();
+    u8* const vram = fcram + Memory::FCRAM_N3DS_SIZE;
+    u8* const n3ds_extra_ram = vram + Memory::VRAM_SIZE;
 
     Core::System& system;
     std::shared_ptr<PageTable> current_page_table = nullptr;
@@ -104,18 +136,37 @@ public:
     std::shared_ptr<BackingMem> n3ds_extra_ram_mem;
     std::shared_ptr<BackingMem> dsp_mem;
 
+    /// Hash of the RAM contents when the anchor for delta savestates was set, or 0 if there is
+    /// none. The backing tracks writes while an anchor is set.
+    u64 anchor_hash = 0;
+    /// FCRAM size of the console model the anchor was set for
+    u32 anchor_fcram_size = 0;
+    bool serialize_ram = true;
+
+    struct Watchpoint {
+        VAddr address;
+        u32 size;
+        WatchType type;
+        std::shared_ptr<const WatchCallback> callback;
+    };
+    std::map<u32, Watchpoint> watchpoints;
+    u32 next_watchpoint_id = 1;
+    u32 num_execute_watchpoints = 0;
+    /// Number of read and write watchpoints on each watched virtual page
+    std::unordered_map<u32, u32> watched_pages;
+
     Impl(Core::System& system_);
 
     const u8* GetPtr(Region r) const {
         switch (r) {
         case Region::VRAM:
-            return vram.get();
+            return vram;
         case Region::DSP:
             return dsp->GetDspMemory().data();
         case Region::FCRAM:
-            return fcram.get();
+            return fcram;
         case Region::N3DS:
-            return n3ds_extra_ram.get();
+            return n3ds_extra_ram;
         default:
             UNREACHABLE();
         }
@@ -124,13 +175,13 @@ public:
     u8* GetPtr(Region r) {
         switch (r) {
         case Region::VRAM:
-            return vram.get();
+            return vram;
         case Region::DSP:
             return dsp->GetDspMemory().data();
         case Region::FCRAM:
-            return fcram.get();
+            return fcram;
         case Region::N3DS:
-            return n3ds_extra_ram.get();
+            return n3ds_extra_ram;
         default:
             UNREACHABLE();
         }
@@ -195,6 +246,12 @@ public:
                 std::memcpy(dest_buffer, GetPointerForRasterizerCache(current_vaddr), copy_amount);
                 break;
             }
+            case PageType::WatchedMemory: {
+                // Block accesses are made by the kernel and services, these are not reported
+                const u8* src_ptr = page_table.pointers.GetMemory(page_index) + page_offset;
+                std::memcpy(dest_buffer, src_ptr, copy_amount);
+                break;
+            }
             default:
                 UNREACHABLE();
             }
@@ -244,6 +301,12 @@ public:
                 std::memcpy(GetPointerForRasterizerCache(current_vaddr), src_buffer, copy_amount);
                 break;
             }
+            case PageType::WatchedMemory: {
+                u8* dest_ptr = page_table.pointers.GetMemory(page_index) + page_offset;
+                std::memcpy(dest_ptr, src_buffer, copy_amount);
+                RefreshTrackedPage(current_vaddr);
+                break;
+            }
             default:
                 UNREACHABLE();
             }
@@ -277,6 +340,12 @@ public:
         return MemoryRef{};
     }
 
+    /// Gets the pointer for virtual memory where the page is marked as WatchedMemory.
+    u8* GetPointerForWatchedMemory(VAddr addr) const {
+        return current_page_table->pointers.GetMemory(addr >> ENCORE_PAGE_BITS) +
+               (addr & ENCORE_PAGE_MASK);
+    }
+
     void RasterizerFlushVirtualRegion(VAddr start, u32 size, FlushMode mode) {
         const VAddr end = start + size;
 
@@ -315,17 +384,291 @@ public:
         }
     }
 
+    /// Returns the offset of the page in the backing, if it is backed by it
+    std::optional<std::size_t> GetBackingOffset(PageTable& page_table, u32 page) const {
+        const u8* backing_base = backing.BasePointer();
+        const u8* pointer = page_table.pointers.GetMemory(page);
+        if (pointer < backing_base || pointer >= backing_base + backing.Size()) {
+            return std::nullopt;
+        }
+        return static_cast<std::size_t>(pointer - backing_base);
+    }
+
+    bool IsWatched(u32 page) const {
+        return !watched_pages.empty() && watched_pages.contains(page);
+    }
+
+    /// Returns true if writes are tracked for the anchor and the page wasn't written since
+    bool IsUnwritten(PageTable& page_table, u32 page) const {
+        if (!backing.IsTracking()) {
+            return false;
+        }
+        const auto offset = GetBackingOffset(page_table, page);
+        return offset && !backing.IsWritten(*offset);
+    }
+
+    /**
+     * Updates the fastmem arena of the page table for the specified pages. Pages of type `Memory`
+     * which are backed by the shared allocation are mapped, everything else is left unmapped so
+     * that the JIT falls back to the page table and memory callbacks when accessing them. Pages
+     * only hidden because their writes are tracked are mapped read-only, as writes through the
+     * arena would go unnoticed. While the RAM is forked nothing is mapped, as the views wouldn't
+     * see the private copies.
+     */
+    void UpdateFastmem(PageTable& page_table, u32 first_page, u32 num_pages) {
+        if (!page_table.fastmem_arena) {
+            return;
+        }
+
+        struct View {
+            std::size_t offset;
+            bool writable;
+        };
+        const auto get_view = [&](u32 page) -> std::optional<View> {
+            const PageType type = page_table.attributes[page];
+            if (!backing.SupportsViews() || backing.IsForked() ||
+                (type != PageType::Memory &&
+                 (type != PageType::WatchedMemory || IsWatched(page)))) {
+                return std::nullopt;
+            }
+            const auto offset = GetBackingOffset(page_table, page);
+            if (!offset) {
+                return std::nullopt;
+            }
+            return View{*offset, type == PageType::Memory};
+        };
+
+        // Apply runs of contiguous pages with a single mapping call each
+        auto& arena = *page_table.fastmem_arena;
+        const u32 end_page = first_page + num_pages;
+        u32 page = first_page;
+        while (page != end_page) {
+            const auto run_view = get_view(page);
+            u32 run_end = page + 1;
+            while (run_end != end_page) {
+                const auto view = get_view(run_end);
+                if (run_view.has_value() != view.has_value() ||
+                    (run_view &&
+                     (view->offset != run_view->offset + (run_end - page) * ENCORE_PAGE_SIZE ||
+                      view->writable != run_view->writable))) {
+                    break;
+                }
+                run_end++;
+            }
+
+            const std::size_t arena_offset = static_cast<std::size_t>(page) * ENCORE_PAGE_SIZE;
+            const std::size_t length = static_cast<std::size_t>(run_end - page) * ENCORE_PAGE_SIZE;
+            if (run_view) {
+                arena.Map(arena_offset, backing, run_view->offset, length, run_view->writable);
+            } else {
+                arena.Unmap(arena_offset, length);
+            }
+            page = run_end;
+        }
+    }
+
+    /**
+     * Moves a page of the page table between `Memory` and `WatchedMemory`, depending on whether it
+     * is watched. Pages not written since the anchor was set are watched as well, so that the JIT
+     * doesn't write to them through the page table, which it couldn't recover from once the
+     * backing faults. Returns true if the page type changed. Does not update the fastmem arena.
+     */
+    bool ApplyWatch(PageTable& page_table, u32 page) {
+        PageType& type = page_table.attributes[page];
+        if (type != PageType::Memory && type != PageType::WatchedMemory) {
+            return false;
+        }
+
+        const bool watched = IsWatched(page) || IsUnwritten(page_table, page);
+        if (watched == (type == PageType::WatchedMemory)) {
+            return false;
+        }
+        if (watched) {
+            type = PageType::WatchedMemory;
+            page_table.pointers.Hide(page);
+        } else {
+            type = PageType::Memory;
+            page_table.pointers.Unhide(page);
+        }
+        return true;
+    }
+
+    void UpdateWatchedPage(u32 page) {
+        for (auto& page_table : page_table_list) {
+            if (ApplyWatch(*page_table, page)) {
+                UpdateFastmem(*page_table, page, 1);
+            }
+        }
+    }
+
+    /// Unhides a page hidden for write tracking once it was written, see ApplyWatch
+    void RefreshTrackedPage(VAddr vaddr) {
+        if (backing.IsTracking()) {
+            UpdateWatchedPage(vaddr >> ENCORE_PAGE_BITS);
+        }
+    }
+
+    /// Applies ApplyWatch to every page and remaps the fastmem arenas
+    void ApplyAllWatches() {
+        for (auto& page_table : page_table_list) {
+            for (u32 page = 0; page < PAGE_TABLE_NUM_ENTRIES; page++) {
+                ApplyWatch(*page_table, page);
+            }
+            UpdateFastmem(*page_table, 0, PAGE_TABLE_NUM_ENTRIES);
+        }
+    }
+
+    /// Adds or removes a reference to every page the range touches
+    void WatchPages(VAddr address, u32 size, bool watch) {
+        const u32 first_page = address >> ENCORE_PAGE_BITS;
+        const u32 last_page = static_cast<u32>((u64{address} + size - 1) >> ENCORE_PAGE_BITS);
+        for (u32 page = first_page; page <= last_page && page < PAGE_TABLE_NUM_ENTRIES; page++) {
+            if (watch) {
+                if (watched_pages[page]++ == 0) {
+                    UpdateWatchedPage(page);
+                }
+            } else {
+                const auto it = watched_pages.find(page);
+                ASSERT(it != watched_pages.end());
+                if (--it->second == 0) {
+                    watched_pages.erase(it);
+                    UpdateWatchedPage(page);
+                }
+            }
+        }
+    }
+
+    void NotifyAccess(WatchType type, VAddr address, u32 size, u64 value) {
+        // Instruction fetches are reported without a size
+        const u64 end = u64{address} + std::max(size, 1U);
+
+        // Callbacks may add or remove watchpoints, so they are collected first
+        boost::container::small_vector<std::shared_ptr<const WatchCallback>, 4> callbacks;
+        for (const auto& [id, watchpoint] : watchpoints) {
+            if (True(watchpoint.type & type) &&
+                u64{address} < u64{watchpoint.address} + watchpoint.size &&
+                u64{watchpoint.address} < end) {
+                callbacks.push_back(watchpoint.callback);
+            }
+        }
+        if (callbacks.empty()) {
+            return;
+        }
+
+        const u32 pc = type == WatchType::Execute ? address : GetPC();
+        for (const auto& callback : callbacks) {
+            (*callback)(type, address, size, value, pc);
+        }
+    }
+
+private:
+    /// Inclusive start page and page count of a run of pages that differ from the anchor
+    using DirtyRun = std::pair<u32, u32>;
+
+    template <class Archive>
+    void SerializeDeltaRegion(Archive& ar, u8* data, std::size_t region_size) {
+        // Only the pages written since the anchor was set can differ from it, they're found
+        // without looking at the rest of the RAM
+        const u32 num_pages = static_cast<u32>(region_size / ENCORE_PAGE_SIZE);
+        const std::size_t region_offset = static_cast<std::size_t>(data - backing.BasePointer());
+        const u8* anchor_data = backing.TrackedPointer() + region_offset;
+        const auto written_runs = backing.GetWrittenRuns(region_offset, region_size);
+        std::vector<DirtyRun> dirty_runs;
+        if (Archive::is_saving::value) {
+            for (const auto& [offset, length] : written_runs) {
+                for (std::size_t page_offset = offset - region_offset;
+                     page_offset != offset - region_offset + length;
+                     page_offset += ENCORE_PAGE_SIZE) {
+                    // Pages written back to their anchor contents are left out
+                    if (std::memcmp(data + page_offset, anchor_data + page_offset,
+                                    ENCORE_PAGE_SIZE) == 0) {
+                        continue;
+                    }
+                    const u32 page = static_cast<u32>(page_offset / ENCORE_PAGE_SIZE);
+                    if (!dirty_runs.empty() &&
+                        dirty_runs.back().first + dirty_runs.back().second == page) {
+                        dirty_runs.back().second++;
+                    } else {
+                        dirty_runs.emplace_back(page, 1);
+                    }
+                }
+            }
+        }
+        ar & dirty_runs;
+
+        if (Archive::is_loading::value) {
+            // The other pages still hold the anchor contents
+            for (const auto& [offset, length] : written_runs) {
+                std::memcpy(data + (offset - region_offset), anchor_data + (offset - region_offset),
+                            length);
+            }
+        }
+        for (const auto& [first_page, page_count] : dirty_runs) {
+            if (first_page + page_count > num_pages) {
+                throw std::runtime_error("Delta savestate contains out of range pages");
+            }
+            ar& boost::serialization::make_binary_object(
+                data + static_cast<std::size_t>(first_page) * ENCORE_PAGE_SIZE,
+                static_cast<std::size_t>(page_count) * ENCORE_PAGE_SIZE);
+        }
+    }
+
+public:
+    /// Returns the hash of the anchor the next savestate is diffed against, or 0 for a full state
+    u64 GetSavedAnchorHash() const {
+        if (!serialize_ram || anchor_hash == 0) {
+            return 0;
+        }
+        const u32 fcram_size = Settings::values().is_new_3ds.GetValue() ? Memory::FCRAM_N3DS_SIZE
+                                                                        : Memory::FCRAM_SIZE;
+        return anchor_fcram_size == fcram_size ? anchor_hash : 0;
+    }
+
 private:
+    template <class Archive>
+    void SerializeRam(Archive& ar, u32 fcram_size, u32 n3ds_extra_ram_size,
+                      const unsigned int file_version) {
+        // A delta state only stores the pages which changed since the anchor was captured
+        u64 saved_anchor_hash = 0;
+        if (Archive::is_saving::value) {
+            saved_anchor_hash = GetSavedAnchorHash();
+        }
+        if (file_version >= 1) {
+            ar & saved_anchor_hash;
+        }
+
+        if (saved_anchor_hash != 0) {
+            if (anchor_hash != saved_anchor_hash || anchor_fcram_size != fcram_size) {
+                throw std::runtime_error("Delta savestate does not match the current anchor");
+            }
+            SerializeDeltaRegion(ar, vram, Memory::VRAM_SIZE);
+            SerializeDeltaRegion(ar, fcram, fcram_size);
+            SerializeDeltaRegion(ar, n3ds_extra_ram, n3ds_extra_ram_size);
+        } else {
+            ar& boost::serialization::make_binary_object(vram, Memory::VRAM_SIZE);
+            ar& boost::serialization::make_binary_object(fcram, fcram_size);
+            ar& boost::serialization::make_binary_object(n3ds_extra_ram,
+                                                          n3ds_extra_ram_size);
+        }
+    }
+
     friend class boost::serialization::access;
     template <class Archive>
     void serialize(Archive& ar, const unsigned int file_version) {
-        bool save_n3ds_ram = Settings::values.is_new_3ds.GetValue();
+        bool save_n3ds_ram = Settings::values().is_new_3ds.GetValue();
         ar & save_n3ds_ram;
-        ar& boost::serialization::make_binary_object(vram.get(), Memory::VRAM_SIZE);
-        ar& boost::serialization::make_binary_object(
-            fcram.get(), save_n3ds_ram ? Memory::FCRAM_N3DS_SIZE : Memory::FCRAM_SIZE);
-        ar& boost::serialization::make_binary_object(
-            n3ds_extra_ram.get(), save_n3ds_ram ? Memory::N3DS_EXTRA_RAM_SIZE : 0);
+        const u32 fcram_size = save_n3ds_ram ? Memory::FCRAM_N3DS_SIZE : Memory::FCRAM_SIZE;
+        const u32 n3ds_extra_ram_size = save_n3ds_ram ? Memory::N3DS_EXTRA_RAM_SIZE : 0;
+
+        // States without RAM leave the current contents alone when loaded, older states always
+        // contain it
+        bool includes_ram = serialize_ram || file_version < 2;
+        if (file_version >= 2) {
+            ar & includes_ram;
+        }
+        if (includes_ram) {
+            SerializeRam(ar, fcram_size, n3ds_extra_ram_size, file_version);
+        }
         ar & cache_marker;
         ar & page_table_list;
         // dsp is set from Core::System at startup
@@ -334,6 +677,11 @@ private:
         ar & vram_mem;
         ar & n3ds_extra_ram_mem;
         ar & dsp_mem;
+
+        if (Archive::is_loading::value) {
+            // Watchpoints are not part of the state, the pages follow the current ones
+            ApplyAllWatches();
+        }
     }
 };
 
@@ -402,6 +750,7 @@ void MemorySystem::MapPages(PageTable& page_table, u32 base, u32 size, MemoryRef
                                      FlushMode::FlushAndInvalidate);
     }
 
+    const u32 first_page = base;
     u32 end = base + size;
     while (base != end) {
         ASSERT_MSG(base < PAGE_TABLE_NUM_ENTRIES, "out of range mapping at {:08X}", base);
@@ -414,11 +763,14 @@ void MemorySystem::MapPages(PageTable& page_table, u32 base, u32 size, MemoryRef
             page_table.attributes[base] = PageType::RasterizerCachedMemory;
             page_table.pointers[base] = nullptr;
         }
+        impl->ApplyWatch(page_table, base);
 
         base += 1;
         if (memory != nullptr && memory.GetSize() > ENCORE_PAGE_SIZE)
             memory += ENCORE_PAGE_SIZE;
     }
+
+    impl->UpdateFastmem(page_table, first_page, size);
 }
 
 void MemorySystem::MapMemoryRegion(PageTable& page_table, VAddr base, u32 size, MemoryRef target) {
@@ -440,7 +792,16 @@ MemoryRef MemorySystem::GetPointerForRasterizerCache(VAddr addr) const {
 }
 
 void MemorySystem::RegisterPageTable(std::shared_ptr<PageTable> page_table) {
+    if (!impl->backing.SupportsViews()) {
+        // Nothing could ever be mapped into the arena
+        page_table->fastmem_arena.reset();
+    }
     impl->page_table_list.push_back(page_table);
+    for (const auto& [page, count] : impl->watched_pages) {
+        if (impl->ApplyWatch(*page_table, page)) {
+            impl->UpdateFastmem(*page_table, page, 1);
+        }
+    }
 }
 
 void MemorySystem::UnregisterPageTable(std::shared_ptr<PageTable> page_table) {
@@ -489,6 +850,16 @@ T MemorySystem::Read(const VAddr vaddr) {
 
         T value;
         std::memcpy(&value, GetPointerForRasterizerCache(vaddr), sizeof(T));
+        if (!impl->watched_pages.empty()) {
+            impl->NotifyAccess(WatchType::Read, vaddr, sizeof(T), value);
+        }
+        return value;
+    }
+    case PageType::WatchedMemory: {
+        T value;
+        std::memcpy(&value, impl->GetPointerForWatchedMemory(vaddr), sizeof(T));
+        impl->NotifyAccess(WatchType::Read, vaddr, sizeof(T), value);
+        impl->RefreshTrackedPage(vaddr);
         return value;
     }
     default:
@@ -536,6 +907,15 @@ void MemorySystem::Write(const VAddr vaddr, const T data) {
     case PageType::RasterizerCachedMemory: {
         RasterizerFlushVirtualRegion(vaddr, sizeof(T), FlushMode::Invalidate);
         std::memcpy(GetPointerForRasterizerCache(vaddr), &data, sizeof(T));
+        if (!impl->watched_pages.empty()) {
+            impl->NotifyAccess(WatchType::Write, vaddr, sizeof(T), data);
+        }
+        break;
+    }
+    case PageType::WatchedMemory: {
+        std::memcpy(impl->GetPointerForWatchedMemory(vaddr), &data, sizeof(T));
+        impl->NotifyAccess(WatchType::Write, vaddr, sizeof(T), data);
+        impl->RefreshTrackedPage(vaddr);
         break;
     }
     default:
@@ -566,7 +946,21 @@ bool MemorySystem::WriteExclusive(const VAddr vaddr, const T data, const T expec
         RasterizerFlushVirtualRegion(vaddr, sizeof(T), FlushMode::Invalidate);
         const auto volatile_pointer =
             reinterpret_cast<volatile T*>(GetPointerForRasterizerCache(vaddr).GetPtr());
-        return Common::AtomicCompareAndSwap(volatile_pointer, data, expected);
+        const bool stored = Common::AtomicCompareAndSwap(volatile_pointer, data, expected);
+        if (stored && !impl->watched_pages.empty()) {
+            impl->NotifyAccess(WatchType::Write, vaddr, sizeof(T), data);
+        }
+        return stored;
+    }
+    case PageType::WatchedMemory: {
+        const auto volatile_pointer =
+            reinterpret_cast<volatile T*>(impl->GetPointerForWatchedMemory(vaddr));
+        const bool stored = Common::AtomicCompareAndSwap(volatile_pointer, data, expected);
+        if (stored) {
+            impl->NotifyAccess(WatchType::Write, vaddr, sizeof(T), data);
+            impl->RefreshTrackedPage(vaddr);
+        }
+        return stored;
     }
     default:
         UNREACHABLE();
@@ -582,11 +976,8 @@ bool MemorySystem::IsValidVirtualAddress(const Kernel::Process& process, const V
         return true;
     }
 
-    if (page_table.attributes[vaddr >> ENCORE_PAGE_BITS] == PageType::RasterizerCachedMemory) {
-        return true;
-    }
-
-    return false;
+    const PageType type = page_table.attributes[vaddr >> ENCORE_PAGE_BITS];
+    return type == PageType::RasterizerCachedMemory || type == PageType::WatchedMemory;
 }
 
 bool MemorySystem::IsValidPhysicalAddress(const PAddr paddr) const {
@@ -599,9 +990,13 @@ u8* MemorySystem::GetPointer(const VAddr vaddr) {
         return page_pointer + (vaddr & ENCORE_PAGE_MASK);
     }
 
-    if (impl->current_page_table->attributes[vaddr >> ENCORE_PAGE_BITS] ==
-        PageType::RasterizerCachedMemory) {
+    switch (impl->current_page_table->attributes[vaddr >> ENCORE_PAGE_BITS]) {
+    case PageType::RasterizerCachedMemory:
         return GetPointerForRasterizerCache(vaddr);
+    case PageType::WatchedMemory:
+        return impl->GetPointerForWatchedMemory(vaddr);
+    default:
+        break;
     }
 
     LOG_ERROR(HW_Memory, "unknown GetPointer @ 0x{:08x} at PC 0x{:08X}", vaddr, impl->GetPC());
@@ -614,9 +1009,13 @@ const u8* MemorySystem::GetPointer(const VAddr vaddr) const {
         return page_pointer + (vaddr & ENCORE_PAGE_MASK);
     }
 
-    if (impl->current_page_table->attributes[vaddr >> ENCORE_PAGE_BITS] ==
-        PageType::RasterizerCachedMemory) {
+    switch (impl->current_page_table->attributes[vaddr >> ENCORE_PAGE_BITS]) {
+    case PageType::RasterizerCachedMemory:
         return GetPointerForRasterizerCache(vaddr);
+    case PageType::WatchedMemory:
+        return impl->GetPointerForWatchedMemory(vaddr);
+    default:
+        break;
     }
 
     LOG_ERROR(HW_Memory, "unknown GetPointer @ 0x{:08x}", vaddr);
@@ -740,8 +1139,10 @@ void MemorySystem::RasterizerMarkRegionCached(PAddr start, u32 size, bool cached
                         // address space, for example, a system module need not have a VRAM mapping.
                         break;
                     case PageType::Memory:
+                    case PageType::WatchedMemory:
                         page_type = PageType::RasterizerCachedMemory;
                         page_table->pointers[vaddr >> ENCORE_PAGE_BITS] = nullptr;
+                        impl->UpdateFastmem(*page_table, vaddr >> ENCORE_PAGE_BITS, 1);
                         break;
                     default:
                         UNREACHABLE();
@@ -757,6 +1158,8 @@ void MemorySystem::RasterizerMarkRegionCached(PAddr start, u32 size, bool cached
                         page_type = PageType::Memory;
                         page_table->pointers[vaddr >> ENCORE_PAGE_BITS] =
                             GetPointerForRasterizerCache(vaddr & ~ENCORE_PAGE_MASK);
+                        impl->ApplyWatch(*page_table, vaddr >> ENCORE_PAGE_BITS);
+                        impl->UpdateFastmem(*page_table, vaddr >> ENCORE_PAGE_BITS, 1);
                         break;
                     }
                     default:
@@ -768,6 +1171,56 @@ void MemorySystem::RasterizerMarkRegionCached(PAddr start, u32 size, bool cached
     }
 }
 
+u32 MemorySystem::AddWatchpoint(VAddr address, u32 size, WatchType type, WatchCallback callback) {
+    ASSERT(size != 0);
+    const u32 id = impl->next_watchpoint_id++;
+    impl->watchpoints.emplace(
+        id, Impl::Watchpoint{address, size, type,
+                             std::make_shared<const WatchCallback>(std::move(callback))});
+
+    if (True(type & (WatchType::Read | WatchType::Write))) {
+        impl->WatchPages(address, size, true);
+    }
+    if (True(type & WatchType::Execute)) {
+        // Code translated before doesn't have the hook yet
+        impl->num_execute_watchpoints++;
+        impl->system.InvalidateCacheRange(address, size);
+    }
+    return id;
+}
+
+void MemorySystem::RemoveWatchpoint(u32 id) {
+    const auto it = impl->watchpoints.find(id);
+    if (it == impl->watchpoints.end()) {
+        return;
+    }
+    const auto [address, size, type, callback] = it->second;
+    impl->watchpoints.erase(it);
+
+    if (True(type & (WatchType::Read | WatchType::Write))) {
+        impl->WatchPages(address, size, false);
+    }
+    if (True(type & WatchType::Execute)) {
+        impl->num_execute_watchpoints--;
+        impl->system.InvalidateCacheRange(address, size);
+    }
+}
+
+bool MemorySystem::HasExecuteWatchpoint(VAddr address) const {
+    if (impl->num_execute_watchpoints == 0) {
+        return false;
+    }
+    return std::any_of(impl->watchpoints.begin(), impl->watchpoints.end(), [&](const auto& pair) {
+        const auto& watchpoint = pair.second;
+        return True(watchpoint.type & WatchType::Execute) && address >= watchpoint.address &&
+               u64{address} < u64{watchpoint.address} + watchpoint.size;
+    });
+}
+
+void MemorySystem::NotifyExecute(VAddr address) {
+    impl->NotifyAccess(WatchType::Execute, address, 0, 0);
+}
+
 u8 MemorySystem::Read8(const VAddr addr) {
     return Read<u8>(addr);
 }
@@ -870,6 +1323,11 @@ void MemorySystem::ZeroBlock(const Kernel::Process& process, const VAddr dest_ad
             std::memset(GetPointerForRasterizerCache(current_vaddr), 0, copy_amount);
             break;
         }
+        case PageType::WatchedMemory: {
+            std::memset(page_table.pointers.GetMemory(page_index) + page_offset, 0, copy_amount);
+            impl->RefreshTrackedPage(current_vaddr);
+            break;
+        }
         default:
             UNREACHABLE();
         }
@@ -920,6 +1378,11 @@ void MemorySystem::CopyBlock(const Kernel::Process& dest_process,
                        copy_amount);
             break;
         }
+        case PageType::WatchedMemory: {
+            const u8* src_ptr = page_table.pointers.GetMemory(page_index) + page_offset;
+            WriteBlock(dest_process, dest_addr, src_ptr, copy_amount);
+            break;
+        }
         default:
             UNREACHABLE();
         }
@@ -933,18 +1396,18 @@ void MemorySystem::CopyBlock(const Kernel::Process& dest_process,
 }
 
 u32 MemorySystem::GetFCRAMOffset(const u8* pointer) const {
-    ASSERT(pointer >= impl->fcram.get() && pointer <= impl->fcram.get() + Memory::FCRAM_N3DS_SIZE);
-    return static_cast<u32>(pointer - impl->fcram.get());
+    ASSERT(pointer >= impl->fcram && pointer <= impl->fcram + Memory::FCRAM_N3DS_SIZE);
+    return static_cast<u32>(pointer - impl->fcram);
 }
 
 u8* MemorySystem::GetFCRAMPointer(std::size_t offset) {
     ASSERT(offset <= Memory::FCRAM_N3DS_SIZE);
-    return impl->fcram.get() + offset;
+    return impl->fcram + offset;
 }
 
 const u8* MemorySystem::GetFCRAMPointer(std::size_t offset) const {
     ASSERT(offset <= Memory::FCRAM_N3DS_SIZE);
-    return impl->fcram.get() + offset;
+    return impl->fcram + offset;
 }
 
 MemoryRef MemorySystem::GetFCRAMRef(std::size_t offset) const {
@@ -956,4 +1419,110 @@ void MemorySystem::SetDSP(AudioCore::DspInterface& dsp) {
     impl->dsp = &dsp;
 }
 
+bool MemorySystem::SetDeltaAnchor() {
+    if (!impl->backing.StartTracking()) {
+        ClearDeltaAnchor();
+        return false;
+    }
+
+    const bool is_n3ds = Settings::values().is_new_3ds.GetValue();
+    const u32 fcram_size = is_n3ds ? Memory::FCRAM_N3DS_SIZE : Memory::FCRAM_SIZE;
+    const u32 n3ds_extra_ram_size = is_n3ds ? Memory::N3DS_EXTRA_RAM_SIZE : 0;
+    u64 hash = Common::ComputeHash64(impl->vram, Memory::VRAM_SIZE);
+    hash = Common::HashCombine(hash, Common::ComputeHash64(impl->fcram, fcram_size));
+    hash = Common::HashCombine(hash,
+                               Common::ComputeHash64(impl->n3ds_extra_ram, n3ds_extra_ram_size));
+    // A zero hash marks a full state in the savestate stream
+    impl->anchor_hash = hash != 0 ? hash : 1;
+    impl->anchor_fcram_size = fcram_size;
+
+    // Hide every page, so that the first write to each is caught
+    impl->ApplyAllWatches();
+    return true;
+}
+
+void MemorySystem::ClearDeltaAnchor() {
+    impl->anchor_hash = 0;
+    impl->anchor_fcram_size = 0;
+    if (impl->backing.IsTracking()) {
+        impl->backing.StopTracking();
+        impl->ApplyAllWatches();
+    }
+}
+
+u64 MemorySystem::GetDeltaAnchorHash() const {
+    return impl->anchor_hash;
+}
+
+u64 MemorySystem::GetSavedAnchorHash() const {
+    return impl->GetSavedAnchorHash();
+}
+
+void MemorySystem::SetSerializeRam(bool serialize_ram) {
+    impl->serialize_ram = serialize_ram;
+}
+
+std::size_t MemorySystem::GetRamSize() const {
+    const bool is_n3ds = Settings::values().is_new_3ds.GetValue();
+    return Memory::VRAM_SIZE + (is_n3ds ? Memory::FCRAM_N3DS_SIZE : Memory::FCRAM_SIZE) +
+           (is_n3ds ? Memory::N3DS_EXTRA_RAM_SIZE : 0);
+}
+
+void MemorySystem::ReadRam(u8* dest) const {
+    const bool is_n3ds = Settings::values().is_new_3ds.GetValue();
+    const u32 fcram_size = is_n3ds ? Memory::FCRAM_N3DS_SIZE : Memory::FCRAM_SIZE;
+    std::memcpy(dest, impl->vram, Memory::VRAM_SIZE);
+    std::memcpy(dest + Memory::VRAM_SIZE, impl->fcram, fcram_size);
+    if (is_n3ds) {
+        std::memcpy(dest + Memory::VRAM_SIZE + fcram_size, impl->n3ds_extra_ram,
+                    Memory::N3DS_EXTRA_RAM_SIZE);
+    }
+}
+
+void MemorySystem::WriteRam(const u8* src) {
+    const bool is_n3ds = Settings::values().is_new_3ds.GetValue();
+    const u32 fcram_size = is_n3ds ? Memory::FCRAM_N3DS_SIZE : Memory::FCRAM_SIZE;
+    std::memcpy(impl->vram, src, Memory::VRAM_SIZE);
+    std::memcpy(impl->fcram, src + Memory::VRAM_SIZE, fcram_size);
+    if (is_n3ds) {
+        std::memcpy(impl->n3ds_extra_ram, src + Memory::VRAM_SIZE + fcram_size,
+                    Memory::N3DS_EXTRA_RAM_SIZE);
+    }
+}
+
+bool MemorySystem::ForkRam() {
+    const bool was_forked = impl->backing.IsForked();
+    if (!impl->backing.Fork()) {
+        return false;
+    }
+    if (!was_forked) {
+        for (auto& page_table : impl->page_table_list) {
+            impl->UpdateFastmem(*page_table, 0, PAGE_TABLE_NUM_ENTRIES);
+        }
+    }
+    return true;
+}
+
+bool MemorySystem::IsRamForked() const {
+    return impl->backing.IsForked();
+}
+
+bool MemorySystem::RestoreRamFork() {
+    if (!impl->backing.IsForked()) {
+        return false;
+    }
+    impl->backing.RestoreFork();
+    return true;
+}
+
+void MemorySystem::DropRamFork() {
+    if (!impl->backing.IsForked()) {
+        return;
+    }
+    impl->backing.DropFork();
+    for (auto& page_table : impl->page_table_list) {
+        impl->UpdateFastmem(*page_table, 0, PAGE_TABLE_NUM_ENTRIES);
+    }
+}
+
 } // namespace Memory
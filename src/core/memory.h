@@ -5,12 +5,20 @@
 #pragma once
 #include <array>
 #include <cstddef>
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 #include <boost/serialization/array.hpp>
 #include <boost/serialization/vector.hpp>
+#include "common/common_funcs.h"
 #include "common/common_types.h"
 #include "common/memory_ref.h"
 
+namespace Common {
+class HostArena;
+}
+
 namespace Kernel {
 class Process;
 }
@@ -42,7 +50,25 @@ enum class PageType {
     /// Page is mapped to regular memory, but also needs to check for rasterizer cache flushing and
     /// invalidation
     RasterizerCachedMemory,
+    /// Page is mapped to regular memory, but has watchpoints on it. The memory is only reachable
+    /// through the slow paths, which report the accesses.
+    WatchedMemory,
+};
+
+/// Kinds of accesses a watchpoint reports
+enum class WatchType : u32 {
+    Read = 1 << 0,
+    Write = 1 << 1,
+    Execute = 1 << 2,
 };
+DECLARE_ENUM_FLAG_OPERATORS(WatchType);
+
+/**
+ * Called for an access to watched memory with the kind, address and size of the access, the value
+ * read or written and the PC of the running core. Size and value are 0 for Execute.
+ */
+using WatchCallback =
+    std::function<void(WatchType type, VAddr address, u32 size, u64 value, u32 pc)>;
 
 /**
  * A (reasonably) fast way of allowing switchable and remappable process address spaces. It loosely
@@ -51,6 +77,9 @@ enum class PageType {
  * requires an indexed fetch and a check for NULL.
  */
 struct PageTable {
+    PageTable();
+    ~PageTable();
+
     /**
      * Array of memory pointers backing each page. An entry can only be non-null if the
      * corresponding entry in the `attributes` array is of type `Memory`.
@@ -82,6 +111,21 @@ struct PageTable {
             return Entry(*this, static_cast<VAddr>(idx));
         }
 
+        /// Clears the pointer used by the fast paths, but keeps the reference to the memory.
+        void Hide(std::size_t idx) {
+            raw[idx] = nullptr;
+        }
+
+        /// Makes the memory of a hidden entry visible to the fast paths again.
+        void Unhide(std::size_t idx) {
+            raw[idx] = refs[idx].GetPtr();
+        }
+
+        /// Returns the memory of an entry, including hidden ones.
+        u8* GetMemory(std::size_t idx) {
+            return refs[idx].GetPtr();
+        }
+
     private:
         std::array<u8*, PAGE_TABLE_NUM_ENTRIES> raw;
         std::array<MemoryRef, PAGE_TABLE_NUM_ENTRIES> refs;
@@ -100,6 +144,15 @@ struct PageTable {
         return pointers.raw;
     }
 
+    /**
+     * Host address space mirroring the 4GiB guest address space for the CPU JIT, or nullptr if
+     * fastmem is disabled. Only pages of type `Memory` are mapped in it, see MemorySystem.
+     */
+    std::unique_ptr<Common::HostArena> fastmem_arena;
+
+    /// Returns the base of the fastmem arena, or nullptr if there is none.
+    u8* GetFastmemPointer() const;
+
     void Clear();
 
 private:
@@ -108,7 +161,8 @@ private:
         ar & pointers.refs;
         ar & attributes;
         for (std::size_t i = 0; i < PAGE_TABLE_NUM_ENTRIES; i++) {
-            pointers.raw[i] = pointers.refs[i].GetPtr();
+            pointers.raw[i] =
+                attributes[i] == PageType::WatchedMemory ? nullptr : pointers.refs[i].GetPtr();
         }
     }
     friend class boost::serialization::access;
@@ -553,6 +607,76 @@ public:
 
     void RasterizerFlushVirtualRegion(VAddr start, u32 size, FlushMode mode);
 
+    /**
+     * Makes the current contents of the emulated RAM the anchor for delta savestates. Writes to
+     * the RAM are tracked from then on, so saving only emits the pages written since, and loading
+     * only reverts those before applying the state. A delta savestate can only be loaded while an
+     * anchor with the same contents is set. The anchor is kept when loading a state.
+     * @returns false if the host can't track writes, in which case no anchor is set.
+     */
+    bool SetDeltaAnchor();
+
+    /// Removes the anchor, savestates contain the full RAM again.
+    void ClearDeltaAnchor();
+
+    /// Returns the hash of the anchor contents, or 0 if no anchor is set.
+    u64 GetDeltaAnchorHash() const;
+
+    /// Returns the hash of the anchor the next savestate is diffed against, or 0 if it contains
+    /// the full RAM.
+    u64 GetSavedAnchorHash() const;
+
+    /// Sets whether serialization includes the emulated RAM. States saved without it leave the
+    /// current RAM untouched when loaded.
+    void SetSerializeRam(bool serialize_ram);
+
+    /// Returns the size of the emulated RAM copied by ReadRam, which depends on the console model.
+    std::size_t GetRamSize() const;
+
+    /**
+     * Copies the VRAM, FCRAM and N3DS extra RAM, in this order, to dest. Together with a state
+     * saved without RAM, this keeps the RAM at fixed offsets from one copy to the next.
+     * @param dest Buffer of GetRamSize() bytes.
+     */
+    void ReadRam(u8* dest) const;
+
+    /// Overwrites the emulated RAM with a copy made by ReadRam.
+    void WriteRam(const u8* src);
+
+    /**
+     * Snapshots the emulated RAM by turning its host mapping copy-on-write, so the snapshot can be
+     * restored at the cost of the pages written since. Forking again replaces the snapshot. The
+     * fastmem arenas stay unmapped until the fork is dropped.
+     * @returns false if the host doesn't support forking.
+     */
+    bool ForkRam();
+
+    /// Returns true if the RAM is forked, i.e. RestoreRamFork can revert it.
+    bool IsRamForked() const;
+
+    /// Reverts the emulated RAM to the last fork. Returns false if there is none.
+    bool RestoreRamFork();
+
+    /// Keeps the current RAM contents and ends the fork, if any.
+    void DropRamFork();
+
+    /**
+     * Adds a watchpoint on the virtual address range [address, address + size) of every process.
+     * Read and write watchpoints move the pages they touch off the fast paths, execute watchpoints
+     * make the CPU JIT retranslate the instructions they cover with a hook.
+     * @returns The id of the watchpoint, used to remove it again.
+     */
+    u32 AddWatchpoint(VAddr address, u32 size, WatchType type, WatchCallback callback);
+
+    /// Removes a watchpoint added with AddWatchpoint.
+    void RemoveWatchpoint(u32 id);
+
+    /// Returns true if an execute watchpoint covers the instruction at the address.
+    bool HasExecuteWatchpoint(VAddr address) const;
+
+    /// Reports the execution of the instruction at the address to the watchpoints covering it.
+    void NotifyExecute(VAddr address);
+
 private:
     template <typename T>
     T Read(const VAddr vaddr);
@@ -592,3 +716,4 @@ BOOST_CLASS_EXPORT_KEY(Memory::MemorySystem::BackingMemImpl<Memory::Region::FCRA
 BOOST_CLASS_EXPORT_KEY(Memory::MemorySystem::BackingMemImpl<Memory::Region::VRAM>)
 BOOST_CLASS_EXPORT_KEY(Memory::MemorySystem::BackingMemImpl<Memory::Region::DSP>)
 BOOST_CLASS_EXPORT_KEY(Memory::MemorySystem::BackingMemImpl<Memory::Region::N3DS>)
+BOOST_CLASS_VERSION(Memory::MemorySystem::Impl, 2)
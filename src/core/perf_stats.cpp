@@ -31,7 +31,7 @@ namespace Core {
 PerfStats::PerfStats(u64 title_id) : title_id(title_id) {}
 
 PerfStats::~PerfStats() {
-    if (!Settings::values.record_frame_times || title_id == 0) {
+    if (!Settings::values().record_frame_times || title_id == 0) {
         return;
     }
 
@@ -142,9 +142,9 @@ void FrameLimiter::DoFrameLimiting(microseconds current_system_time_us) {
     }
 
     auto now = Clock::now();
-    double sleep_scale = Settings::values.frame_limit.GetValue() / 100.0;
+    double sleep_scale = Settings::values().frame_limit.GetValue() / 100.0;
 
-    if (Settings::values.frame_limit.GetValue() == 0) {
+    if (Settings::values().frame_limit.GetValue() == 0) {
         return;
     }
 
@@ -2,55 +2,225 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+
 #include "audio_core/audio_types.h"
 #include "audio_core/dsp_interface.h"
+#include "common/arch.h"
+#include "common/logging/log.h"
 #include "audio_resampler.h"
 
+#if ENCORE_ARCH(x86_64)
+#include <emmintrin.h>
+#elif ENCORE_ARCH(arm64)
+#include <arm_neon.h>
+#endif
+
 using namespace Headless;
 
-constexpr auto OUT_SAMPLE_RATE = 44100;
+constexpr u32 DEFAULT_OUT_SAMPLE_RATE = 44100;
+// lower rates would skip input frames between outputs
+constexpr u32 MIN_OUT_SAMPLE_RATE = 8000;
+
+// every output sample is a weighted sum of this many input frames
+constexpr std::size_t TAPS = 16;
+// the fractional position is rounded to the nearest of this many filter phases
+constexpr u32 PHASE_BITS = 9;
+constexpr std::size_t NUM_PHASES = std::size_t{1} << PHASE_BITS;
+// filter coefficients are Q14, the sum of their magnitudes stays well below 2, so the
+// accumulated products of s16 samples can't overflow an s32
+constexpr u32 COEFFICIENT_BITS = 14;
+// the passband ends at this fraction of the lower of the two Nyquist frequencies
+constexpr double CUTOFF = 0.9;
 
-AudioResampler::AudioResampler(Core::System& system_) : system(system_) {
-    blip_l = blip_new(1024 * 2);
-    blip_set_rates(blip_l, AudioCore::native_sample_rate, OUT_SAMPLE_RATE);
-    blip_r = blip_new(1024 * 2);
-    blip_set_rates(blip_r, AudioCore::native_sample_rate, OUT_SAMPLE_RATE);
+// The DSP output FIFO can't hold more frames than this
+constexpr std::size_t MAX_INPUT_FRAMES = 0x2000;
+
+static s32 DotProduct(const s16* samples, const s16* coefficients) {
+    static_assert(TAPS == 16);
+#if ENCORE_ARCH(x86_64)
+    const auto load = [](const s16* p) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    };
+    __m128i sum = _mm_add_epi32(_mm_madd_epi16(load(samples), load(coefficients)),
+                                _mm_madd_epi16(load(samples + 8), load(coefficients + 8)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum);
+#elif ENCORE_ARCH(arm64)
+    int32x4_t sum = vmull_s16(vld1_s16(samples), vld1_s16(coefficients));
+    sum = vmlal_s16(sum, vld1_s16(samples + 4), vld1_s16(coefficients + 4));
+    sum = vmlal_s16(sum, vld1_s16(samples + 8), vld1_s16(coefficients + 8));
+    sum = vmlal_s16(sum, vld1_s16(samples + 12), vld1_s16(coefficients + 12));
+    return vaddvq_s32(sum);
+#else
+    s32 sum = 0;
+    for (std::size_t i = 0; i < TAPS; i++) {
+        sum += s32{samples[i]} * coefficients[i];
+    }
+    return sum;
+#endif
 }
 
-AudioResampler::~AudioResampler() {
-    blip_delete(blip_l);
-    blip_delete(blip_r);
+static s16 ToSample(s32 sum) {
+    constexpr s32 round = 1 << (COEFFICIENT_BITS - 1);
+    return static_cast<s16>(std::clamp((sum + round) >> COEFFICIENT_BITS, -32768, 32767));
 }
 
-void AudioResampler::Flush() {
-    auto& fifo = system.DSP().GetFifo();
-    in_buffer.resize(fifo.Size() * 2);
-    fifo.Pop(in_buffer.data());
-    const auto num_samples = in_buffer.size() / 2;
-    for (unsigned i = 0; i < num_samples; i++) {
-        s16 sample_l = in_buffer[i * 2 + 0];
-        if (sample_l != latch_l) {
-            blip_add_delta(blip_l, i, latch_l - sample_l);
-            latch_l = sample_l;
+// Builds the coefficients of NUM_PHASES + 1 filter phases, phase p interpolates the point p /
+// NUM_PHASES frames after the middle two taps. The last phase equals the first one shifted by a
+// frame, which saves wrapping around when rounding to the nearest phase.
+static std::vector<s16> BuildFilter(u32 output_rate) {
+    const double cutoff =
+        CUTOFF * std::min(1.0, static_cast<double>(output_rate) / AudioCore::native_sample_rate);
+    constexpr double half_width = TAPS / 2;
+
+    std::vector<s16> coefficients((NUM_PHASES + 1) * TAPS);
+    std::array<double, TAPS> phase;
+    for (std::size_t p = 0; p <= NUM_PHASES; p++) {
+        const double offset = static_cast<double>(p) / NUM_PHASES;
+        double total = 0.0;
+        for (std::size_t tap = 0; tap < TAPS; tap++) {
+            const double x = static_cast<double>(tap) - (half_width - 1) - offset;
+            const double arg = std::numbers::pi * cutoff * x;
+            const double sinc = x == 0.0 ? 1.0 : std::sin(arg) / arg;
+            // Blackman window
+            const double w = std::numbers::pi * x / half_width;
+            const double window = std::abs(x) >= half_width
+                                      ? 0.0
+                                      : 0.42 + 0.5 * std::cos(w) + 0.08 * std::cos(2 * w);
+            phase[tap] = sinc * window;
+            total += phase[tap];
         }
 
-        s16 sample_r = in_buffer[i * 2 + 1];
-        if (sample_r != latch_r) {
-            blip_add_delta(blip_r, i, latch_r - sample_r);
-            latch_r = sample_r;
+        // Normalized so constant input comes out unchanged
+        s32 sum = 0;
+        std::size_t largest = 0;
+        s16* out = &coefficients[p * TAPS];
+        for (std::size_t tap = 0; tap < TAPS; tap++) {
+            out[tap] = static_cast<s16>(std::lround(phase[tap] / total * (1 << COEFFICIENT_BITS)));
+            sum += out[tap];
+            largest = out[tap] > out[largest] ? tap : largest;
         }
+        out[largest] = static_cast<s16>(out[largest] + (1 << COEFFICIENT_BITS) - sum);
+    }
+    return coefficients;
+}
+
+AudioResampler::AudioResampler(Core::System& system_)
+    : system(system_), in_buffer(MAX_INPUT_FRAMES * 2), left(MAX_INPUT_FRAMES + TAPS),
+      right(MAX_INPUT_FRAMES + TAPS), out_buffer(MAX_INPUT_FRAMES * 2) {
+    SetOutputRate(DEFAULT_OUT_SAMPLE_RATE);
+}
+
+AudioResampler::~AudioResampler() = default;
+
+void AudioResampler::SetOutputRate(u32 rate) {
+    if (rate == 0) {
+        rate = AudioCore::native_sample_rate;
+    }
+    if (rate < MIN_OUT_SAMPLE_RATE) {
+        LOG_ERROR(Audio, "Output sample rate {} is below the minimum of {}", rate,
+                  MIN_OUT_SAMPLE_RATE);
+        return;
+    }
+
+    passthrough = rate == AudioCore::native_sample_rate;
+    if (!passthrough) {
+        coefficients = BuildFilter(rate);
+        step = (u64{AudioCore::native_sample_rate} << 32) / rate;
     }
 
-    blip_end_frame(blip_l, static_cast<unsigned>(num_samples));
-    blip_end_frame(blip_r, static_cast<unsigned>(num_samples));
+    Reset();
+}
 
-    const auto num_out_samples = blip_samples_avail(blip_l);
-    ASSERT(num_out_samples == blip_samples_avail(blip_r));
-    out_buffer.resize(num_out_samples * 2);
-    blip_read_samples(blip_l, out_buffer.data() + 0, num_out_samples, true);
-    blip_read_samples(blip_r, out_buffer.data() + 1, num_out_samples, true);
+void AudioResampler::Reset() {
+    // Start over with silence as the history, so the first output frame lines up with the first
+    // input frame
+    buffered = TAPS / 2 - 1;
+    std::fill_n(left.begin(), buffered, s16{0});
+    std::fill_n(right.begin(), buffered, s16{0});
+    position = 0;
+    out_size = 0;
 }
 
-std::span<const s16> AudioResampler::GetAudio() {
-    return out_buffer;
+void AudioResampler::SetOutputBuffer(std::span<s16> buffer) {
+    external_buffer = buffer;
+    out_size = 0;
+}
+
+void AudioResampler::Flush(bool append) {
+    if (!append) {
+        out_size = 0;
+    }
+
+    auto& fifo = system.DSP().GetFifo();
+    if (passthrough) {
+        const auto output = ReserveOutput(fifo.Size() * 2);
+        out_size += fifo.Pop(output.data(), output.size() / 2) * 2;
+        // whatever didn't fit into the output buffer is dropped
+        fifo.Pop(in_buffer.data(), MAX_INPUT_FRAMES);
+        return;
+    }
+
+    const std::size_t num_frames = fifo.Pop(in_buffer.data(), MAX_INPUT_FRAMES);
+    for (std::size_t i = 0; i < num_frames; i++) {
+        left[buffered + i] = in_buffer[i * 2 + 0];
+        right[buffered + i] = in_buffer[i * 2 + 1];
+    }
+    buffered += num_frames;
+    Resample();
+}
+
+void AudioResampler::Resample() {
+    // Output frames are produced for as long as all of their taps are buffered
+    std::size_t num_out_frames = 0;
+    if (buffered >= TAPS) {
+        const u64 end = u64{buffered - TAPS + 1} << 32;
+        if (position < end) {
+            num_out_frames = static_cast<std::size_t>((end - position + step - 1) / step);
+        }
+    }
+
+    const auto output = ReserveOutput(num_out_frames * 2);
+    const std::size_t num_written = output.size() / 2;
+    u64 pos = position;
+    for (std::size_t i = 0; i < num_written; i++, pos += step) {
+        const std::size_t index = static_cast<std::size_t>(pos >> 32);
+        const u32 fraction = static_cast<u32>(pos);
+        const std::size_t phase = ((fraction >> (31 - PHASE_BITS)) + 1) >> 1;
+        const s16* filter = &coefficients[phase * TAPS];
+        output[i * 2 + 0] = ToSample(DotProduct(&left[index], filter));
+        output[i * 2 + 1] = ToSample(DotProduct(&right[index], filter));
+    }
+    out_size += num_written * 2;
+    position += num_out_frames * step;
+
+    // Keep the frames still needed by the next outputs at the start of the buffers
+    const std::size_t consumed = std::min(static_cast<std::size_t>(position >> 32), buffered);
+    std::copy(left.begin() + consumed, left.begin() + buffered, left.begin());
+    std::copy(right.begin() + consumed, right.begin() + buffered, right.begin());
+    buffered -= consumed;
+    position -= u64{consumed} << 32;
+}
+
+std::span<s16> AudioResampler::ReserveOutput(std::size_t num_samples) {
+    if (!external_buffer.empty()) {
+        return external_buffer.subspan(out_size,
+                                       std::min(num_samples, external_buffer.size() - out_size));
+    }
+    if (out_buffer.size() < out_size + num_samples) {
+        out_buffer.resize(out_size + num_samples);
+    }
+    return std::span{out_buffer}.subspan(out_size, num_samples);
+}
+
+std::span<const s16> AudioResampler::GetAudio() const {
+    if (!external_buffer.empty()) {
+        return external_buffer.first(out_size);
+    }
+    return std::span{out_buffer}.first(out_size);
 }
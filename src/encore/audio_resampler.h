@@ -4,26 +4,55 @@
 
 #pragma once
 
-#include <blip_buf.h>
+#include <span>
+#include <vector>
 
 #include "core/core.h"
 
 namespace Headless {
 
+// Converts the DSP output to the rate requested by the frontend with a polyphase windowed-sinc
+// filter. All buffers are allocated up front, so flushing doesn't allocate once the output buffer
+// has grown to the size of a batch of frames.
 class AudioResampler {
 public:
     explicit AudioResampler(Core::System& system);
     ~AudioResampler();
 
-    void Flush();
-    std::span<const s16> GetAudio();
+    // 0 or the native rate pass the DSP output through untouched
+    void SetOutputRate(u32 rate);
+
+    // drops the filter history and any pending output, as if the resampler was just created
+    void Reset();
+
+    // audio is written to the provided buffer instead of an internal one, until an empty buffer
+    // is set again. Samples which don't fit into it are dropped
+    void SetOutputBuffer(std::span<s16> buffer);
+
+    // resamples the audio produced since the last flush
+    // if append is set, it's added to the audio of the previous flush instead of replacing it
+    void Flush(bool append = false);
+    std::span<const s16> GetAudio() const;
 
 private:
+    // returns up to num_samples of space after the current output
+    std::span<s16> ReserveOutput(std::size_t num_samples);
+    void Resample();
+
     Core::System& system;
-    std::vector<s16> in_buffer, out_buffer;
-    blip_t* blip_l;
-    blip_t* blip_r;
-    s16 latch_l{0}, latch_r{0};
+    bool passthrough{};
+
+    // stereo frames popped from the DSP, then split into channels after the filter history
+    std::vector<s16> in_buffer;
+    std::vector<s16> left, right;
+    std::size_t buffered{};
+    u64 position{}; // in input frames as 32.32 fixed point, relative to the start of left/right
+    u64 step{};
+    std::vector<s16> coefficients;
+
+    std::vector<s16> out_buffer;
+    std::span<s16> external_buffer;
+    std::size_t out_size{};
 };
 
 } // namespace Headless
@@ -0,0 +1,250 @@
+// Copyright 2024 Encore Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <unordered_map>
+#include <fmt/format.h>
+
+#include "common/file_util.h"
+#include "common/hash.h"
+#include "common/logging/log.h"
+#include "common/scm_rev.h"
+#include "common/settings.h"
+#include "core/hle/service/am/am.h"
+#include "core/hle/service/fs/archive.h"
+#include "core/loader/loader.h"
+
+#include "boot_cache.h"
+#include "savestate_mt.h"
+
+namespace Headless {
+
+namespace {
+
+constexpr u32 SNAPSHOT_MAGIC = 0x53424E45; // "ENBS"
+
+struct SnapshotHeader {
+    u32 magic;
+    u32 reserved;
+    u64 key;
+    u64 size;
+};
+
+struct RomHash {
+    u64 size;
+    s64 write_time;
+    u64 hash;
+};
+
+// Hashing reads the whole ROM, so the hash is kept for as long as the size and modification time
+// of the file stay the same. Shared by all contexts
+std::mutex rom_hashes_mutex;
+std::unordered_map<std::string, RomHash> rom_hashes;
+
+std::optional<u64> HashRom(const std::string& rom_path) {
+    std::error_code ec;
+    const auto write_time = std::filesystem::last_write_time(rom_path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    const u64 size = FileUtil::GetSize(rom_path);
+    const s64 write_time_count = write_time.time_since_epoch().count();
+
+    std::scoped_lock lock{rom_hashes_mutex};
+    const auto it = rom_hashes.find(rom_path);
+    if (it != rom_hashes.end() && it->second.size == size &&
+        it->second.write_time == write_time_count) {
+        return it->second.hash;
+    }
+
+    FileUtil::IOFile file(rom_path, "rb");
+    if (!file.IsOpen()) {
+        return std::nullopt;
+    }
+    constexpr std::size_t chunk_size = 4 * 1024 * 1024;
+    std::vector<u8> chunk(chunk_size);
+    u64 hash = size;
+    for (u64 offset = 0; offset < size; offset += chunk_size) {
+        const std::size_t length = file.ReadBytes(chunk.data(), chunk_size);
+        if (length == 0) {
+            return std::nullopt;
+        }
+        hash = Common::HashCombine(hash, Common::ComputeHash64(chunk.data(), length));
+    }
+
+    rom_hashes[rom_path] = {size, write_time_count, hash};
+    return hash;
+}
+
+// Files up to this size are hashed by content, larger ones (title contents, fonts) by their size
+// and modification time
+constexpr u64 MAX_CONTENT_HASH_SIZE = 1024 * 1024;
+
+u64 HashDirectory(u64 hash, const std::string& directory) {
+    std::error_code ec;
+    std::vector<std::filesystem::path> files;
+    for (auto it = std::filesystem::recursive_directory_iterator(directory, ec);
+         !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+        if (it->is_regular_file(ec)) {
+            files.push_back(it->path());
+        }
+    }
+    // Directories aren't iterated in a fixed order
+    std::sort(files.begin(), files.end());
+
+    std::vector<u8> contents;
+    for (const auto& file_path : files) {
+        const std::string relative = file_path.lexically_relative(directory).generic_string();
+        const std::string file_name = file_path.string();
+        const u64 size = FileUtil::GetSize(file_name);
+        hash = Common::HashCombine(hash, Common::ComputeHash64(relative.data(), relative.size()));
+        hash = Common::HashCombine(hash, size);
+
+        if (size > MAX_CONTENT_HASH_SIZE) {
+            const auto write_time = std::filesystem::last_write_time(file_path, ec);
+            hash = Common::HashCombine(hash, write_time.time_since_epoch().count());
+            continue;
+        }
+        contents.resize(size);
+        FileUtil::IOFile file(file_name, "rb");
+        if (file.ReadBytes(contents.data(), contents.size()) == contents.size()) {
+            hash = Common::HashCombine(hash, Common::ComputeHash64(contents.data(), size));
+        }
+    }
+    return hash;
+}
+
+// Booting reads the title's save data, update and DLC, the extdata and the system save data, so a
+// snapshot is only valid for the contents of the emulated NAND and SD card it was taken with
+u64 HashUserData(u64 program_id) {
+    using Service::FS::MediaType;
+    constexpr std::array<u64, 3> title_types{
+        0x00040000, // Application, its save data is stored next to it
+        0x0004000E, // Update
+        0x0004008C, // DLC
+    };
+
+    u64 hash = 0;
+    const u64 title_id_low = program_id & 0xFFFFFFFF;
+    for (const u64 title_type : title_types) {
+        const u64 title_id = (title_type << 32) | title_id_low;
+        hash = HashDirectory(hash, Service::AM::GetTitlePath(MediaType::SDMC, title_id));
+    }
+    hash = HashDirectory(hash, fmt::format("{}Nintendo 3DS/{}/{}/extdata/",
+                                           FileUtil::GetUserPath(FileUtil::UserPath::SDMCDir),
+                                           SYSTEM_ID, SDCARD_ID));
+    hash = HashDirectory(hash, fmt::format("{}data/{}/",
+                                           FileUtil::GetUserPath(FileUtil::UserPath::NANDDir),
+                                           SYSTEM_ID));
+    hash = HashDirectory(hash, FileUtil::GetUserPath(FileUtil::UserPath::SysDataDir));
+    return hash;
+}
+
+} // Anonymous namespace
+
+BootCache::BootCache(Core::System& system_, Savestate_MT& savestate_mt_)
+    : system(system_), savestate_mt(savestate_mt_) {}
+
+BootCache::~BootCache() = default;
+
+BootCache::RestoreResult BootCache::Restore(const std::string& rom_path, u64 sync_settings_hash) {
+    path.clear();
+    if (Settings::values().init_clock.GetValue() == Settings::InitClock::SystemTime ||
+        Settings::values().init_ticks_type.GetValue() == Settings::InitTicks::Random) {
+        LOG_INFO(Frontend, "Boot isn't deterministic with the current settings, not caching it");
+        return RestoreResult::NotCached;
+    }
+
+    const auto rom_hash = HashRom(rom_path);
+    if (!rom_hash) {
+        LOG_ERROR(Frontend, "Could not hash {}", rom_path);
+        return RestoreResult::NotCached;
+    }
+    u64 program_id = 0;
+    system.GetAppLoader().ReadProgramId(program_id);
+
+    key = Common::HashCombine(*rom_hash, sync_settings_hash);
+    key = Common::HashCombine(key, Common::ComputeHash64(Common::g_scm_rev,
+                                                         std::strlen(Common::g_scm_rev)));
+    key = Common::HashCombine(key, HashUserData(program_id));
+    // One snapshot per title and settings, so a changed ROM, build or save data replaces the
+    // stale one
+    path = fmt::format("{}boot/{:016X}_{:016X}.bin",
+                       FileUtil::GetUserPath(FileUtil::UserPath::CacheDir), program_id,
+                       sync_settings_hash);
+
+    FileUtil::IOFile file(path, "rb");
+    if (!file.IsOpen()) {
+        return RestoreResult::NotCached;
+    }
+    SnapshotHeader header{};
+    if (file.ReadBytes(&header, sizeof(header)) != sizeof(header) ||
+        header.magic != SNAPSHOT_MAGIC || header.key != key ||
+        file.GetSize() != sizeof(header) + header.size) {
+        LOG_INFO(Frontend, "Boot snapshot {} is stale", path);
+        return RestoreResult::NotCached;
+    }
+
+    buffer.resize(header.size);
+    if (file.ReadBytes(buffer.data(), buffer.size()) != buffer.size()) {
+        return RestoreResult::NotCached;
+    }
+    try {
+        savestate_mt.LoadState(buffer.data(), buffer.size());
+    } catch (const std::exception& e) {
+        LOG_ERROR(Frontend, "Could not load boot snapshot {}: {}", path, e.what());
+        file.Close();
+        FileUtil::Delete(path);
+        return RestoreResult::Failed;
+    }
+    LOG_INFO(Frontend, "Restored boot snapshot {}", path);
+    return RestoreResult::Restored;
+}
+
+void BootCache::Store() {
+    if (path.empty()) {
+        return;
+    }
+
+    buffer.resize(savestate_mt.StartSaveState());
+    savestate_mt.FinishSaveState(buffer.data());
+
+    // Written under another name first, so a snapshot is either complete or missing. The name is
+    // unique as contexts booting the same title may store it at the same time.
+    const std::string temp_path = fmt::format("{}.{:08x}.part", path, std::random_device{}());
+    if (!FileUtil::CreateFullPath(temp_path)) {
+        return;
+    }
+    {
+        FileUtil::IOFile file(temp_path, "wb");
+        const SnapshotHeader header{
+            .magic = SNAPSHOT_MAGIC,
+            .reserved = 0,
+            .key = key,
+            .size = buffer.size(),
+        };
+        if (file.WriteObject(header) != 1 ||
+            file.WriteBytes(buffer.data(), buffer.size()) != buffer.size()) {
+            LOG_ERROR(Frontend, "Could not write boot snapshot {}", temp_path);
+            file.Close();
+            FileUtil::Delete(temp_path);
+            return;
+        }
+    }
+    FileUtil::Delete(path);
+    if (!FileUtil::Rename(temp_path, path)) {
+        // Another context stored the same snapshot first
+        FileUtil::Delete(temp_path);
+        return;
+    }
+    LOG_INFO(Frontend, "Stored boot snapshot {}", path);
+}
+
+} // namespace Headless
@@ -0,0 +1,50 @@
+// Copyright 2024 Encore Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "core/core.h"
+
+namespace Headless {
+
+class Savestate_MT;
+
+// Keeps the state a ROM reaches after booting for a fixed number of frames in the cache
+// directory, so later loads of the same ROM restore it instead of emulating the boot again.
+// Snapshots are keyed by a hash of the ROM contents, the sync settings, the build and the emulated
+// NAND and SD card data the title may read, a snapshot whose key doesn't match is stale and gets
+// replaced. Booting is only cached if it is
+// deterministic, i.e. neither the clock nor the initial ticks are taken from the host.
+class BootCache {
+public:
+    BootCache(Core::System& system, Savestate_MT& savestate_mt);
+    ~BootCache();
+
+    enum class RestoreResult {
+        Restored,
+        // The ROM has to be booted and Store called afterwards
+        NotCached,
+        // The snapshot failed to load and was deleted. The system may be torn down, so the ROM
+        // has to be loaded again before booting it and calling Store
+        Failed,
+    };
+
+    // Call after loading the ROM
+    RestoreResult Restore(const std::string& rom_path, u64 sync_settings_hash);
+    // Saves the current state for the ROM passed to the last Restore
+    void Store();
+
+private:
+    Core::System& system;
+    Savestate_MT& savestate_mt;
+
+    std::string path;
+    u64 key{};
+    std::vector<u8> buffer;
+};
+
+} // namespace Headless
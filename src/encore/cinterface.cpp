@@ -24,6 +24,7 @@ ENCORE_EXPORT void Encore_DestroyContext(EncoreContext* context) {
 
 ENCORE_EXPORT bool Encore_InstallCIA(EncoreContext* context, const char* cia_path,
                                      char* string_buffer, u32 string_size) {
+    const auto binding = context->BindThread();
     const auto& result = context->InstallCIA(cia_path);
     const auto& msg = std::get<std::string>(result);
     auto len = std::min(msg.length(), static_cast<std::size_t>(string_size - 1));
@@ -34,6 +35,7 @@ ENCORE_EXPORT bool Encore_InstallCIA(EncoreContext* context, const char* cia_pat
 
 ENCORE_EXPORT bool Encore_LoadROM(EncoreContext* context, const char* rom_path,
                                   char* error_message_buffer, u32 error_message_buffer_size) {
+    const auto binding = context->BindThread();
     const auto& error_message = context->LoadROM(rom_path);
     if (error_message) {
         auto len = std::min(error_message->length(),
@@ -47,62 +49,209 @@ ENCORE_EXPORT bool Encore_LoadROM(EncoreContext* context, const char* rom_path,
 }
 
 ENCORE_EXPORT bool Encore_RunFrame(EncoreContext* context) {
+    const auto binding = context->BindThread();
     return context->RunFrame();
 }
 
+ENCORE_EXPORT void Encore_RunFrames(EncoreContext* context, const InputSnapshot* inputs,
+                                    u32 num_frames, bool present_all_frames, bool* lagged) {
+    const auto binding = context->BindThread();
+    // inputs may be null, in which case the current input is used for all frames
+    std::span<const InputSnapshot> input_span;
+    if (inputs) {
+        input_span = {inputs, num_frames};
+    }
+    context->RunFrames(input_span, num_frames, present_all_frames, lagged);
+}
+
+// pushes the input used by the following frames, a null snapshot goes back to the input callbacks
+ENCORE_EXPORT void Encore_SetInput(EncoreContext* context, const InputSnapshot* snapshot) {
+    const auto binding = context->BindThread();
+    context->SetInput(snapshot);
+}
+
 ENCORE_EXPORT void Encore_Reset(EncoreContext* context) {
+    const auto binding = context->BindThread();
     context->Reset();
 }
 
 ENCORE_EXPORT void Encore_GetVideoBufferDimensions(EncoreContext* context, u32* w, u32* h) {
+    const auto binding = context->BindThread();
     const auto& buffer_dimensions = context->GetVideoBufferDimensions();
     *w = std::get<0>(buffer_dimensions);
     *h = std::get<1>(buffer_dimensions);
 }
 
 ENCORE_EXPORT u32 Encore_GetGLTexture(EncoreContext* context) {
+    const auto binding = context->BindThread();
     return context->GetGLTexture();
 }
 
 ENCORE_EXPORT void Encore_ReadFrameBuffer(EncoreContext* context, u32* dest_buffer) {
+    const auto binding = context->BindThread();
     context->ReadFrameBuffer(dest_buffer);
 }
 
 ENCORE_EXPORT void Encore_GetAudio(EncoreContext* context, const s16** buffer, u32* frames) {
+    const auto binding = context->BindThread();
     const auto& audio = context->GetAudio();
     *buffer = audio.data();
     *frames = static_cast<u32>(audio.size());
 }
 
+ENCORE_EXPORT void Encore_SetAudioSampleRate(EncoreContext* context, u32 rate) {
+    const auto binding = context->BindThread();
+    context->SetAudioSampleRate(rate);
+}
+
+ENCORE_EXPORT void Encore_SetAudioBuffer(EncoreContext* context, s16* buffer, u32 size) {
+    const auto binding = context->BindThread();
+    context->SetAudioBuffer(buffer ? std::span{buffer, size} : std::span<s16>{});
+}
+
 ENCORE_EXPORT void Encore_ReloadConfig(EncoreContext* context) {
+    const auto binding = context->BindThread();
     context->ReloadConfig();
 }
 
 ENCORE_EXPORT u32 Encore_StartSaveState(EncoreContext* context) {
+    const auto binding = context->BindThread();
     return static_cast<u32>(context->StartSaveState());
 }
 
 ENCORE_EXPORT void Encore_FinishSaveState(EncoreContext* context, void* dest_buffer) {
+    const auto binding = context->BindThread();
     context->FinishSaveState(dest_buffer);
 }
 
-ENCORE_EXPORT void Encore_LoadState(EncoreContext* context, void* src_buffer, u32 buffer_len) {
-    context->LoadState(src_buffer, buffer_len);
+ENCORE_EXPORT bool Encore_LoadState(EncoreContext* context, void* src_buffer, u32 buffer_len) {
+    const auto binding = context->BindThread();
+    return context->LoadState(src_buffer, buffer_len);
+}
+
+ENCORE_EXPORT void Encore_GetSavestateStageTimes(EncoreContext* context, u64* serialize_ns,
+                                                 u64* compress_ns, u64* save_stall_ns,
+                                                 u64* deserialize_ns, u64* decompress_ns,
+                                                 u64* load_stall_ns) {
+    const auto binding = context->BindThread();
+    const auto& stage_times = context->GetSavestateStageTimes();
+    *serialize_ns = stage_times.serialize_ns;
+    *compress_ns = stage_times.compress_ns;
+    *save_stall_ns = stage_times.save_stall_ns;
+    *deserialize_ns = stage_times.deserialize_ns;
+    *decompress_ns = stage_times.decompress_ns;
+    *load_stall_ns = stage_times.load_stall_ns;
+}
+
+ENCORE_EXPORT void Encore_SetDeltaAnchor(EncoreContext* context) {
+    const auto binding = context->BindThread();
+    context->SetDeltaAnchor();
+}
+
+ENCORE_EXPORT void Encore_ClearDeltaAnchor(EncoreContext* context) {
+    const auto binding = context->BindThread();
+    context->ClearDeltaAnchor();
+}
+
+ENCORE_EXPORT void Encore_RewindCapture(EncoreContext* context) {
+    const auto binding = context->BindThread();
+    context->RewindCapture();
+}
+
+ENCORE_EXPORT bool Encore_RewindStep(EncoreContext* context) {
+    const auto binding = context->BindThread();
+    return context->RewindStep();
+}
+
+ENCORE_EXPORT void Encore_SetRewindBudget(EncoreContext* context, u64 budget_bytes) {
+    const auto binding = context->BindThread();
+    context->SetRewindBudget(static_cast<std::size_t>(budget_bytes));
+}
+
+ENCORE_EXPORT bool Encore_ForkState(EncoreContext* context) {
+    const auto binding = context->BindThread();
+    return context->ForkState();
+}
+
+ENCORE_EXPORT bool Encore_RestoreFork(EncoreContext* context) {
+    const auto binding = context->BindThread();
+    return context->RestoreFork();
+}
+
+ENCORE_EXPORT void Encore_DropFork(EncoreContext* context) {
+    const auto binding = context->BindThread();
+    context->DropFork();
 }
 
 ENCORE_EXPORT void Encore_GetMemoryRegion(EncoreContext* context, u32 region, const u8** ptr,
                                           u32* size) {
+    const auto binding = context->BindThread();
     const auto& memory_region = context->GetMemoryRegion(static_cast<Memory::Region>(region));
     *ptr = std::get<const u8*>(memory_region);
     *size = static_cast<u32>(std::get<std::size_t>(memory_region));
 }
 
 ENCORE_EXPORT const u8* Encore_GetPagePointer(EncoreContext* context, u32 addr) {
+    const auto binding = context->BindThread();
     return context->GetPagePointer(addr);
 }
 
+// type is a mask of 1 (read), 2 (write) and 4 (execute)
+// the callback runs on the emulation thread, callbacks are dropped when the core is reset
+// returns 0 if the parameters are invalid
+ENCORE_EXPORT u32 Encore_AddMemoryCallback(EncoreContext* context, u32 type, u32 address, u32 size,
+                                           MemoryCallback callback, void* user_data) {
+    const auto binding = context->BindThread();
+    return context->AddMemoryCallback(static_cast<Memory::WatchType>(type), address, size,
+                                      callback, user_data);
+}
+
+ENCORE_EXPORT void Encore_RemoveMemoryCallback(EncoreContext* context, u32 callback_id) {
+    const auto binding = context->BindThread();
+    context->RemoveMemoryCallback(callback_id);
+}
+
+// returns 0 if the parameters are invalid
+ENCORE_EXPORT u32 Encore_CreateRamSearch(EncoreContext* context, u32 region, u32 value_size,
+                                         bool aligned) {
+    const auto binding = context->BindThread();
+    return context->CreateRamSearch(static_cast<Memory::Region>(region), value_size, aligned);
+}
+
+ENCORE_EXPORT void Encore_DestroyRamSearch(EncoreContext* context, u32 search_id) {
+    const auto binding = context->BindThread();
+    context->DestroyRamSearch(search_id);
+}
+
+ENCORE_EXPORT void Encore_ResetRamSearch(EncoreContext* context, u32 search_id) {
+    const auto binding = context->BindThread();
+    context->ResetRamSearch(search_id);
+}
+
+// returns the number of candidates left
+ENCORE_EXPORT u64 Encore_FilterRamSearch(EncoreContext* context, u32 search_id, u32 value_type,
+                                         u32 compare, bool to_previous, u32 value) {
+    const auto binding = context->BindThread();
+    return context->FilterRamSearch(search_id, static_cast<RamSearch::ValueType>(value_type),
+                                    static_cast<RamSearch::Compare>(compare), to_previous, value);
+}
+
+ENCORE_EXPORT u64 Encore_GetRamSearchCount(EncoreContext* context, u32 search_id) {
+    const auto binding = context->BindThread();
+    return context->GetRamSearchCount(search_id);
+}
+
+// returns the number of results written
+ENCORE_EXPORT u32 Encore_GetRamSearchResults(EncoreContext* context, u32 search_id, u64 first,
+                                             u32 count, u32* offsets, u32* values) {
+    const auto binding = context->BindThread();
+    return static_cast<u32>(context->GetRamSearchResults(
+        search_id, static_cast<std::size_t>(first), {offsets, count}, {values, count}));
+}
+
 ENCORE_EXPORT void Encore_GetTouchScreenLayout(EncoreContext* context, u32* x, u32* y, u32* width,
                                                u32* height, bool* rotated, bool* enabled) {
+    const auto binding = context->BindThread();
     const auto& touch_screen_layout = context->GetTouchScreenLayout();
     const auto& touch_screen_rect = std::get<Common::Rectangle<u32>>(touch_screen_layout);
     *x = touch_screen_rect.left;
@@ -3,9 +3,13 @@
 // Refer to the license.txt file included.
 
 #include <codecvt>
+#include <cstring>
 #include <locale>
+#include <mutex>
+#include <optional>
 
 #include "common/file_util.h"
+#include "common/hash.h"
 #include "common/settings.h"
 #include "core/hle/service/cfg/cfg.h"
 #include "core/hle/service/ptm/ptm.h"
@@ -15,8 +19,9 @@
 
 using namespace Headless;
 
-Config_Headless::Config_Headless(Core::System& system_, ConfigCallbackInterface& callbacks_)
-    : system(system_), callbacks(callbacks_) {
+Config_Headless::Config_Headless(Core::System& system_, ConfigCallbackInterface& callbacks_,
+                                 const std::string& input_engine_)
+    : system(system_), callbacks(callbacks_), input_engine(input_engine_) {
     ASSERT(!system.IsPoweredOn());
     LoadConstantSettings();
     LoadSyncSettings();
@@ -51,197 +56,237 @@ void Config_Headless::ReadSetting(Settings::Setting<Type, ranged>& setting) {
     }
 }
 
+template <typename Type, bool ranged>
+void Config_Headless::ReadSyncSetting(Settings::Setting<Type, ranged>& setting) {
+    ReadSetting(setting);
+    const Type value = setting.GetValue();
+    if constexpr (std::is_same_v<Type, std::string>) {
+        HashSyncValue(value.data(), value.size());
+    } else {
+        HashSyncValue(&value, sizeof(value));
+    }
+}
+
+void Config_Headless::HashSyncValue(const void* data, std::size_t size) {
+    sync_settings_hash = Common::HashCombine(sync_settings_hash, Common::ComputeHash64(data, size));
+}
+
 // we don't want these changing regardless of the frontend
 void Config_Headless::LoadConstantSettings() {
     // Controls
-    Settings::values.current_input_profile.name = "Headless";
+    Settings::values().current_input_profile.name = "Headless";
 
     for (int i = 0; i < Settings::NativeButton::NumButtons; ++i) {
-        Settings::values.current_input_profile.buttons[i] =
-            fmt::format("engine:headless,button:{}", i);
+        Settings::values().current_input_profile.buttons[i] =
+            fmt::format("engine:{},button:{}", input_engine, i);
     }
 
     for (int i = 0; i < Settings::NativeAnalog::NumAnalogs; ++i) {
-        Settings::values.current_input_profile.analogs[i] =
-            fmt::format("engine:headless,axis:{}", i);
+        Settings::values().current_input_profile.analogs[i] =
+            fmt::format("engine:{},axis:{}", input_engine, i);
     }
 
-    Settings::values.current_input_profile.motion_device = "engine:headless";
-    Settings::values.current_input_profile.touch_device = "engine:headless";
+    Settings::values().current_input_profile.motion_device = "engine:" + input_engine;
+    Settings::values().current_input_profile.touch_device = "engine:" + input_engine;
 
-    Settings::values.current_input_profile.use_touch_from_button = false;
-    Settings::values.current_input_profile.touch_from_button_map_index = 0;
+    Settings::values().current_input_profile.use_touch_from_button = false;
+    Settings::values().current_input_profile.touch_from_button_map_index = 0;
 
-    Settings::values.current_input_profile_index = 0;
-    Settings::values.input_profiles.clear();
-    Settings::values.input_profiles.push_back(Settings::values.current_input_profile);
-    Settings::values.touch_from_button_maps.clear();
+    Settings::values().current_input_profile_index = 0;
+    Settings::values().input_profiles.clear();
+    Settings::values().input_profiles.push_back(Settings::values().current_input_profile);
+    Settings::values().touch_from_button_maps.clear();
 
     // Renderer
-    Settings::values.physical_device =
+    Settings::values().physical_device =
         0; // doesn't mean anything outside of Vulkan (not yet supported)
-    Settings::values.spirv_shader_gen = true; // ditto
-    Settings::values.async_presentation =
+    Settings::values().spirv_shader_gen = true; // ditto
+    Settings::values().async_presentation =
         false; // only allow presenting on the main thread (doesn't make sense otherwise)
-    Settings::values.use_gles = false;             // only standard OpenGL supported for now
-    Settings::values.use_disk_shader_cache = true; // no need to expose this to the user
-    Settings::values.frame_limit = 0;              // unthrottled (frontend handles this)
-    Settings::values.use_vsync_new = false;        // frontend handles this
+    Settings::values().use_gles = false;             // only standard OpenGL supported for now
+    Settings::values().use_disk_shader_cache = true; // no need to expose this to the user
+    Settings::values().frame_limit = 0;              // unthrottled (frontend handles this)
+    Settings::values().use_vsync_new = false;        // frontend handles this
 
     // not sure what these are, probably don't want to expose them
-    Settings::values.pp_shader_name = "none (builtin)";
-    Settings::values.anaglyph_shader_name = "dubois (builtin)";
+    Settings::values().pp_shader_name = "none (builtin)";
+    Settings::values().anaglyph_shader_name = "dubois (builtin)";
 
     // Utility
     // not going to support these for now
-    Settings::values.dump_textures = false;
-    Settings::values.custom_textures = false;
-    Settings::values.preload_textures = false;
-    Settings::values.async_custom_loading = false;
+    Settings::values().dump_textures = false;
+    Settings::values().custom_textures = false;
+    Settings::values().preload_textures = false;
+    Settings::values().async_custom_loading = false;
 
     // Audio
-    Settings::values.audio_emulation =
+    Settings::values().audio_emulation =
         Settings::AudioEmulation::HLE;                // only HLE audio supports savestates
-    Settings::values.enable_audio_stretching = false; // handled frontend side
-    Settings::values.volume = 1;
-    Settings::values.output_type =
+    Settings::values().enable_audio_stretching = false; // handled frontend side
+    Settings::values().volume = 1;
+    Settings::values().output_type =
         AudioCore::SinkType::Null; // we use a different interface for this
-    Settings::values.output_device = "None";
+    Settings::values().output_device = "None";
     // not sure about this
-    // Settings::values.input_type = AudioCore::InputType::Static;
-    // Settings::values.input_device = "Static Noise";
-    Settings::values.input_type = AudioCore::InputType::Null;
-    Settings::values.input_device = "None";
+    // Settings::values().input_type = AudioCore::InputType::Static;
+    // Settings::values().input_device = "Static Noise";
+    Settings::values().input_type = AudioCore::InputType::Null;
+    Settings::values().input_device = "None";
 
     // Data Storage
-    Settings::values.use_custom_storage = false; // we'll control this with the user directory
+    Settings::values().use_custom_storage = false; // we'll control this with the user directory
 
     // System
-    Settings::values.init_time_offset = 0; // offset to real time?
+    Settings::values().init_time_offset = 0; // offset to real time?
 
     // Camera
     for (int i = 0; i < Service::CAM::NumCameras; ++i) {
         // TODO image?
-        Settings::values.camera_name[i] = "blank";
-        Settings::values.camera_config[i] = "";
-        Settings::values.camera_flip[i] = 0;
+        Settings::values().camera_name[i] = "blank";
+        Settings::values().camera_config[i] = "";
+        Settings::values().camera_flip[i] = 0;
     }
 
     // Debugging
-    Settings::values.record_frame_times = false;
-    Settings::values.renderer_debug = false;
-    Settings::values.use_gdbstub = false;
-    Settings::values.gdbstub_port = 0;
+    Settings::values().record_frame_times = false;
+    Settings::values().renderer_debug = false;
+    Settings::values().use_gdbstub = false;
+    Settings::values().gdbstub_port = 0;
 
     // TODO make this changeable
     for (const auto& service_module : Service::service_module_map) {
-        Settings::values.lle_modules.emplace(service_module.name, false);
+        Settings::values().lle_modules.emplace(service_module.name, false);
     }
 
     // Video Dumping
-    Settings::values.output_format = "";
-    Settings::values.format_options = "";
+    Settings::values().output_format = "";
+    Settings::values().format_options = "";
 
-    Settings::values.video_encoder = "";
-    Settings::values.video_encoder_options = "";
-    Settings::values.video_bitrate = 0;
+    Settings::values().video_encoder = "";
+    Settings::values().video_encoder_options = "";
+    Settings::values().video_bitrate = 0;
 
-    Settings::values.audio_encoder = "";
-    Settings::values.audio_encoder_options = "";
-    Settings::values.audio_bitrate = 0;
+    Settings::values().audio_encoder = "";
+    Settings::values().audio_encoder_options = "";
+    Settings::values().audio_bitrate = 0;
 
     // Miscellaneous
-    Settings::values.log_filter = "";
+    Settings::values().log_filter = "";
 }
 
 void Config_Headless::LoadSyncSettings() {
+    sync_settings_hash = 0;
+
     // Core
-    ReadSetting(Settings::values.use_cpu_jit);
-    ReadSetting(Settings::values.cpu_clock_percentage);
+    ReadSyncSetting(Settings::values().use_cpu_jit);
+    ReadSyncSetting(Settings::values().use_fastmem);
+    ReadSyncSetting(Settings::values().cpu_clock_percentage);
 
     // Renderer
-    ReadSetting(Settings::values.graphics_api);
-    ReadSetting(Settings::values.async_shader_compilation);
-    ReadSetting(Settings::values.use_hw_shader);
-    ReadSetting(Settings::values.shaders_accurate_mul);
-    ReadSetting(Settings::values.use_shader_jit);
+    ReadSyncSetting(Settings::values().graphics_api);
+    ReadSyncSetting(Settings::values().async_shader_compilation);
+    ReadSyncSetting(Settings::values().use_hw_shader);
+    ReadSyncSetting(Settings::values().shaders_accurate_mul);
+    ReadSyncSetting(Settings::values().use_shader_jit);
 
     // Audio
-    ReadSetting(Settings::values.volume);
+    ReadSyncSetting(Settings::values().volume);
 
     // Data Storage
-    ReadSetting(Settings::values.use_virtual_sd);
+    ReadSyncSetting(Settings::values().use_virtual_sd);
+    ReadSyncSetting(Settings::values().map_romfs);
 
     char user_directory_path_buffer[4096]{};
     callbacks.GetString("user_directory", user_directory_path_buffer,
                         sizeof(user_directory_path_buffer));
-    FileUtil::ResetUserPath();
-    FileUtil::SetUserPath(user_directory_path_buffer);
+    HashSyncValue(user_directory_path_buffer, std::strlen(user_directory_path_buffer));
+    {
+        // The user directory is shared by all contexts in the process, so it's only reset when it
+        // changes, as other contexts may be running
+        static std::mutex user_directory_mutex;
+        static std::optional<std::string> user_directory;
+        std::scoped_lock lock{user_directory_mutex};
+        if (user_directory != user_directory_path_buffer) {
+            FileUtil::ResetUserPath();
+            FileUtil::SetUserPath(user_directory_path_buffer);
+            user_directory = user_directory_path_buffer;
+        }
+    }
 
     // System
-    ReadSetting(Settings::values.is_new_3ds);
-    ReadSetting(Settings::values.lle_applets);
-    ReadSetting(Settings::values.region_value);
-    ReadSetting(Settings::values.init_clock);
-    ReadSetting(Settings::values.init_time);
-    ReadSetting(Settings::values.init_ticks_type);
-    ReadSetting(Settings::values.init_ticks_override);
-    ReadSetting(Settings::values.plugin_loader_enabled);
-    ReadSetting(Settings::values.allow_plugin_loader);
+    ReadSyncSetting(Settings::values().is_new_3ds);
+    ReadSyncSetting(Settings::values().lle_applets);
+    ReadSyncSetting(Settings::values().region_value);
+    ReadSyncSetting(Settings::values().init_clock);
+    ReadSyncSetting(Settings::values().init_time);
+    ReadSyncSetting(Settings::values().init_ticks_type);
+    ReadSyncSetting(Settings::values().init_ticks_override);
+    ReadSyncSetting(Settings::values().plugin_loader_enabled);
+    ReadSyncSetting(Settings::values().allow_plugin_loader);
 
     // Misc
-    ReadSetting(Settings::values.want_determinism);
+    ReadSyncSetting(Settings::values().want_determinism);
 
     // CFG
     const auto cfg = Service::CFG::GetModule(system);
 
+    const auto read_sync_integer = [this](const char* label) {
+        const u64 value = callbacks.GetInteger(label);
+        HashSyncValue(&value, sizeof(value));
+        return value;
+    };
+
     char username_buffer[11]{};
     callbacks.GetString("username", username_buffer, sizeof(username_buffer));
+    HashSyncValue(username_buffer, sizeof(username_buffer));
     cfg->SetUsername(std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>{}.from_bytes(
         username_buffer));
-    cfg->SetBirthday(static_cast<u8>(callbacks.GetInteger("birthmonth")),
-                     static_cast<u8>(callbacks.GetInteger("birthday")));
+    const auto birthmonth = read_sync_integer("birthmonth");
+    cfg->SetBirthday(static_cast<u8>(birthmonth), static_cast<u8>(read_sync_integer("birthday")));
     cfg->SetSystemLanguage(
-        static_cast<Service::CFG::SystemLanguage>(callbacks.GetInteger("language")));
+        static_cast<Service::CFG::SystemLanguage>(read_sync_integer("language")));
     cfg->SetSoundOutputMode(
-        static_cast<Service::CFG::SoundOutputMode>(callbacks.GetInteger("sound_mode")));
-    if (Settings::values.want_determinism.GetValue()) {
+        static_cast<Service::CFG::SoundOutputMode>(read_sync_integer("sound_mode")));
+    if (Settings::values().want_determinism.GetValue()) {
         cfg->SetConsoleUniqueId(0, 0); // TODO: make this configurable
     }
     cfg->UpdateConfigNANDSavegame();
 
     // PTM
-    Service::PTM::Module::SetPlayCoins(static_cast<u16>(callbacks.GetInteger("playcoins")));
+    Service::PTM::Module::SetPlayCoins(static_cast<u16>(read_sync_integer("playcoins")));
+
+    // Encore
+    boot_snapshot_frames = static_cast<u32>(read_sync_integer("boot_snapshot_frames"));
 }
 
 void Config_Headless::LoadNonSyncSettings() {
     // Renderer
-    ReadSetting(Settings::values.resolution_factor);
-    ReadSetting(Settings::values.texture_filter);
-    ReadSetting(Settings::values.texture_sampling);
+    ReadSetting(Settings::values().resolution_factor);
+    ReadSetting(Settings::values().texture_filter);
+    ReadSetting(Settings::values().texture_sampling);
 
-    ReadSetting(Settings::values.mono_render_option);
-    ReadSetting(Settings::values.render_3d);
-    ReadSetting(Settings::values.factor_3d);
-    ReadSetting(Settings::values.filter_mode);
+    ReadSetting(Settings::values().mono_render_option);
+    ReadSetting(Settings::values().render_3d);
+    ReadSetting(Settings::values().factor_3d);
+    ReadSetting(Settings::values().filter_mode);
 
-    ReadSetting(Settings::values.bg_red);
-    ReadSetting(Settings::values.bg_green);
-    ReadSetting(Settings::values.bg_blue);
+    ReadSetting(Settings::values().bg_red);
+    ReadSetting(Settings::values().bg_green);
+    ReadSetting(Settings::values().bg_blue);
 
     // Layout
-    ReadSetting(Settings::values.layout_option);
-    ReadSetting(Settings::values.swap_screen);
-    ReadSetting(Settings::values.upright_screen);
-    ReadSetting(Settings::values.large_screen_proportion);
-    ReadSetting(Settings::values.custom_layout);
-    ReadSetting(Settings::values.custom_top_left);
-    ReadSetting(Settings::values.custom_top_top);
-    ReadSetting(Settings::values.custom_top_right);
-    ReadSetting(Settings::values.custom_top_bottom);
-    ReadSetting(Settings::values.custom_bottom_left);
-    ReadSetting(Settings::values.custom_bottom_top);
-    ReadSetting(Settings::values.custom_bottom_right);
-    ReadSetting(Settings::values.custom_bottom_bottom);
-    ReadSetting(Settings::values.custom_second_layer_opacity);
+    ReadSetting(Settings::values().layout_option);
+    ReadSetting(Settings::values().swap_screen);
+    ReadSetting(Settings::values().upright_screen);
+    ReadSetting(Settings::values().large_screen_proportion);
+    ReadSetting(Settings::values().custom_layout);
+    ReadSetting(Settings::values().custom_top_left);
+    ReadSetting(Settings::values().custom_top_top);
+    ReadSetting(Settings::values().custom_top_right);
+    ReadSetting(Settings::values().custom_top_bottom);
+    ReadSetting(Settings::values().custom_bottom_left);
+    ReadSetting(Settings::values().custom_bottom_top);
+    ReadSetting(Settings::values().custom_bottom_right);
+    ReadSetting(Settings::values().custom_bottom_bottom);
+    ReadSetting(Settings::values().custom_second_layer_opacity);
 }
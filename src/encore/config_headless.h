@@ -21,14 +21,31 @@ struct ConfigCallbackInterface {
 
 class Config_Headless {
 public:
-    Config_Headless(Core::System& system, ConfigCallbackInterface& callbacks);
+    // input_engine is the name the headless input factories are registered under
+    Config_Headless(Core::System& system, ConfigCallbackInterface& callbacks,
+                    const std::string& input_engine);
     ~Config_Headless();
 
     void Reload();
 
+    // Hash of everything read by LoadSyncSettings, states reached with the same hash and inputs
+    // are the same
+    u64 GetSyncSettingsHash() const {
+        return sync_settings_hash;
+    }
+
+    // Number of frames LoadROM boots the ROM for, see BootCache
+    u32 GetBootSnapshotFrames() const {
+        return boot_snapshot_frames;
+    }
+
 private:
     template <typename Type, bool ranged>
     void ReadSetting(Settings::Setting<Type, ranged>& setting);
+    // Also adds the value to the sync settings hash
+    template <typename Type, bool ranged>
+    void ReadSyncSetting(Settings::Setting<Type, ranged>& setting);
+    void HashSyncValue(const void* data, std::size_t size);
 
     void LoadConstantSettings();
     void LoadSyncSettings();
@@ -36,6 +53,10 @@ private:
 
     Core::System& system;
     ConfigCallbackInterface callbacks;
+    std::string input_engine;
+
+    u64 sync_settings_hash = 0;
+    u32 boot_snapshot_frames = 0;
 };
 
 } // namespace Headless
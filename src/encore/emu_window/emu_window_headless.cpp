@@ -13,12 +13,14 @@ EmuWindow_Headless::EmuWindow_Headless(Core::System& system_) : EmuWindow(false)
 
 EmuWindow_Headless::~EmuWindow_Headless() = default;
 
-void EmuWindow_Headless::RunFrame() {
+void EmuWindow_Headless::RunFrame(bool present) {
     while (!frame_has_passed) {
         ASSERT(system.RunLoop() == Core::System::ResultStatus::Success);
     }
 
-    Present();
+    if (present) {
+        Present();
+    }
     frame_has_passed = false;
 }
 
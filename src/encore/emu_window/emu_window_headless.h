@@ -15,7 +15,7 @@ public:
     explicit EmuWindow_Headless(Core::System& system);
     virtual ~EmuWindow_Headless();
 
-    void RunFrame();
+    void RunFrame(bool present = true);
 
     virtual std::pair<u32, u32> GetVideoBufferDimensions() const = 0;
     virtual void ReadFrameBuffer(u32* dest_buffer) const = 0;
@@ -133,8 +133,8 @@ void EmuWindow_Headless_GL::ReadFrameBuffer(u32* dest_buffer) const {
 
 void EmuWindow_Headless_GL::ReloadConfig() {
     // in case of a custom layout, which case we need to do some more work for the correct layout
-    if (Settings::values.custom_layout.GetValue()) {
-        auto layout = Layout::CustomFrameLayout(1, 1, Settings::values.swap_screen.GetValue());
+    if (Settings::values().custom_layout.GetValue()) {
+        auto layout = Layout::CustomFrameLayout(1, 1, Settings::values().swap_screen.GetValue());
         const auto left = std::min(layout.top_screen.left, layout.bottom_screen.left);
         const auto right = std::max(layout.top_screen.right, layout.bottom_screen.right);
         const auto bottom = std::min(layout.top_screen.bottom, layout.bottom_screen.bottom);
@@ -152,7 +152,7 @@ void EmuWindow_Headless_GL::ReloadConfig() {
     }
 
     const auto& layout = GetFramebufferLayout();
-    const auto scale_factor = Settings::values.resolution_factor.GetValue();
+    const auto scale_factor = Settings::values().resolution_factor.GetValue();
     UpdateCurrentFramebufferLayout(layout.width * scale_factor, layout.height * scale_factor,
                                    false);
 }
@@ -53,7 +53,7 @@ void EmuWindow_Headless_SW::ReadFrameBuffer(u32* dest_buffer) const {
 
 void EmuWindow_Headless_SW::ReloadConfig() {
     std::fill_n(framebuffer.get(), layout.width * layout.height,
-                static_cast<u8>(Settings::values.bg_red.GetValue() * 255) << 24 |
-                    static_cast<u8>(Settings::values.bg_green.GetValue() * 255) << 16 |
-                    static_cast<u8>(Settings::values.bg_blue.GetValue() * 255) << 8);
+                static_cast<u8>(Settings::values().bg_red.GetValue() * 255) << 24 |
+                    static_cast<u8>(Settings::values().bg_green.GetValue() * 255) << 16 |
+                    static_cast<u8>(Settings::values().bg_blue.GetValue() * 255) << 8);
 }
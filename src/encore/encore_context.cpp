@@ -2,7 +2,10 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <mutex>
 #include <fmt/format.h>
 
 #include "audio_core/dsp_interface.h"
@@ -27,41 +30,71 @@
 
 using namespace Headless;
 
+namespace {
+
+// AES keys are shared by all contexts, and are only reloaded while no other context is alive
+std::mutex live_contexts_mutex;
+u32 live_contexts = 0;
+
+std::atomic<u32> next_context_id = 0;
+
+} // Anonymous namespace
+
 EncoreContext::EncoreContext(ConfigCallbackInterface& config_interface,
                              GLCallbackInterface& gl_interface,
                              InputCallbackInterface& input_interface)
-    : system(Core::System::GetInstance()) {
-    config = std::make_unique<Config_Headless>(system, config_interface);
+    : settings(std::make_unique<Settings::Values>()),
+      system_instance(std::make_unique<Core::System>()), system(*system_instance),
+      input_engine(fmt::format("headless{}", next_context_id++)) {
+    const auto binding = BindThread();
+    config = std::make_unique<Config_Headless>(system, config_interface, input_engine);
     Frontend::RegisterDefaultApplets(system);
-    if (Settings::values.graphics_api.GetValue() == Settings::GraphicsAPI::OpenGL) {
+    if (Settings::values().graphics_api.GetValue() == Settings::GraphicsAPI::OpenGL) {
         window = std::make_unique<EmuWindow_Headless_GL>(system, gl_interface);
     } else {
         window = std::make_unique<EmuWindow_Headless_SW>(system);
     }
     savestate_mt = std::make_unique<Savestate_MT>(system);
     audio_resampler = std::make_unique<AudioResampler>(system);
-    Input::RegisterFactory<Input::ButtonDevice>(
-        "headless", std::make_shared<HeadlessButtonFactory>(input_interface));
-    Input::RegisterFactory<Input::AnalogDevice>(
-        "headless", std::make_shared<HeadlessAxisFactory>(input_interface));
-    Input::RegisterFactory<Input::TouchDevice>(
-        "headless", std::make_shared<HeadlessTouchFactory>(input_interface));
-    Input::RegisterFactory<Input::MotionDevice>(
-        "headless", std::make_shared<HeadlessMotionFactory>(input_interface));
-    // we may have set a new aes_keys.txt, force reload it
-    HW::AES::InitKeys(true);
+    rewind_buffer = std::make_unique<RewindBuffer>(system);
+    state_fork = std::make_unique<StateFork>(system);
+    boot_cache = std::make_unique<BootCache>(system, *savestate_mt);
+    input = std::make_shared<HeadlessInput>(input_interface);
+    Input::RegisterFactory<Input::ButtonDevice>(input_engine,
+                                                std::make_shared<HeadlessButtonFactory>(input));
+    Input::RegisterFactory<Input::AnalogDevice>(input_engine,
+                                                std::make_shared<HeadlessAxisFactory>(input));
+    Input::RegisterFactory<Input::TouchDevice>(input_engine,
+                                               std::make_shared<HeadlessTouchFactory>(input));
+    Input::RegisterFactory<Input::MotionDevice>(input_engine,
+                                                std::make_shared<HeadlessMotionFactory>(input));
+
+    std::scoped_lock lock{live_contexts_mutex};
+    // we may have set a new aes_keys.txt, force reload it unless other contexts are using the keys
+    HW::AES::InitKeys(live_contexts == 0);
+    live_contexts++;
 }
 
 EncoreContext::~EncoreContext() {
-    if (system.IsPoweredOn()) {
-        window->MakeCurrent();
-        system.Shutdown();
+    {
+        const auto binding = BindThread();
+        if (system.IsPoweredOn()) {
+            window->MakeCurrent();
+            system.Shutdown();
+        }
     }
 
-    Input::UnregisterFactory<Input::ButtonDevice>("headless");
-    Input::UnregisterFactory<Input::AnalogDevice>("headless");
-    Input::UnregisterFactory<Input::TouchDevice>("headless");
-    Input::UnregisterFactory<Input::MotionDevice>("headless");
+    Input::UnregisterFactory<Input::ButtonDevice>(input_engine);
+    Input::UnregisterFactory<Input::AnalogDevice>(input_engine);
+    Input::UnregisterFactory<Input::TouchDevice>(input_engine);
+    Input::UnregisterFactory<Input::MotionDevice>(input_engine);
+
+    std::scoped_lock lock{live_contexts_mutex};
+    live_contexts--;
+}
+
+EncoreContext::ThreadBinding EncoreContext::BindThread() {
+    return {Settings::ScopedValues{*settings}, Core::System::ScopedInstance{system}};
 }
 
 std::pair<bool, std::string> EncoreContext::InstallCIA(const std::string& cia_path) {
@@ -154,6 +187,37 @@ std::pair<bool, std::string> EncoreContext::InstallCIA(const std::string& cia_pa
 
 std::optional<std::string> EncoreContext::LoadROM(const std::string& rom_path) {
     window->MakeCurrent();
+    rewind_buffer->Clear();
+    state_fork->Drop();
+    if (auto error = LoadSystem(rom_path)) {
+        return error;
+    }
+
+    const u32 boot_frames = config->GetBootSnapshotFrames();
+    if (boot_frames != 0) {
+        const auto restore_result = boot_cache->Restore(rom_path, config->GetSyncSettingsHash());
+        if (restore_result == BootCache::RestoreResult::Failed) {
+            // the broken snapshot may have torn the system down, boot from a fresh load instead
+            if (system.IsPoweredOn()) {
+                system.Shutdown();
+            }
+            if (auto error = LoadSystem(rom_path)) {
+                return error;
+            }
+        }
+        if (restore_result != BootCache::RestoreResult::Restored) {
+            // booted without input, so the snapshot doesn't depend on the frontend
+            const std::vector<InputSnapshot> no_input(boot_frames, InputSnapshot{});
+            RunFrames(no_input, boot_frames, false, nullptr);
+            boot_cache->Store();
+        }
+        // the audio of the boot frames is only there if the boot wasn't cached
+        audio_resampler->Reset();
+    }
+    return std::nullopt;
+}
+
+std::optional<std::string> EncoreContext::LoadSystem(const std::string& rom_path) {
     const auto load_result = system.Load(*window, rom_path);
     switch (load_result) {
     case Core::System::ResultStatus::ErrorGetLoader:
@@ -182,11 +246,43 @@ std::optional<std::string> EncoreContext::LoadROM(const std::string& rom_path) {
 }
 
 bool EncoreContext::RunFrame() {
-    system.GPU().SetLagged();
+    bool lagged;
+    RunFrames({}, 1, true, &lagged);
+    return lagged;
+}
+
+void EncoreContext::RunFrames(std::span<const InputSnapshot> inputs, u32 num_frames,
+                              bool present_all_frames, bool* lagged) {
+    // without inputs, the current input (pushed snapshot or callbacks) is used as usual
+    ASSERT(inputs.empty() || inputs.size() >= num_frames);
+    if (!system.IsPoweredOn()) {
+        // nothing is loaded, e.g. after a failed state load
+        if (lagged) {
+            std::fill_n(lagged, num_frames, true);
+        }
+        return;
+    }
+    const auto previous_input = input->GetSnapshot();
     window->MakeCurrent();
-    window->RunFrame();
-    audio_resampler->Flush();
-    return system.GPU().GetLagged();
+    for (u32 i = 0; i < num_frames; i++) {
+        if (!inputs.empty()) {
+            input->SetSnapshot(inputs[i]);
+        }
+
+        system.GPU().SetLagged();
+        window->RunFrame(present_all_frames || i == num_frames - 1);
+        // audio of all frames is returned together
+        audio_resampler->Flush(i != 0);
+        if (lagged) {
+            lagged[i] = system.GPU().GetLagged();
+        }
+    }
+
+    input->SetSnapshot(previous_input);
+}
+
+void EncoreContext::SetInput(const InputSnapshot* snapshot) {
+    input->SetSnapshot(snapshot ? std::make_optional(*snapshot) : std::nullopt);
 }
 
 void EncoreContext::Reset() {
@@ -199,7 +295,7 @@ std::pair<u32, u32> EncoreContext::GetVideoBufferDimensions() const {
 }
 
 u32 EncoreContext::GetGLTexture() const {
-    ASSERT(Settings::values.graphics_api.GetValue() == Settings::GraphicsAPI::OpenGL);
+    ASSERT(Settings::values().graphics_api.GetValue() == Settings::GraphicsAPI::OpenGL);
     return static_cast<EmuWindow_Headless_GL&>(*window).GetGLTexture();
 }
 
@@ -212,6 +308,14 @@ std::span<const s16> EncoreContext::GetAudio() const {
     return audio_resampler->GetAudio();
 }
 
+void EncoreContext::SetAudioSampleRate(u32 rate) {
+    audio_resampler->SetOutputRate(rate);
+}
+
+void EncoreContext::SetAudioBuffer(std::span<s16> buffer) {
+    audio_resampler->SetOutputBuffer(buffer);
+}
+
 void EncoreContext::ReloadConfig() const {
     config->Reload();
     window->ReloadConfig();
@@ -226,13 +330,83 @@ void EncoreContext::FinishSaveState(void* dest_buffer) {
     savestate_mt->FinishSaveState(dest_buffer);
 }
 
-void EncoreContext::LoadState(void* src_buffer, std::size_t buffer_len) const {
+bool EncoreContext::LoadState(void* src_buffer, std::size_t buffer_len) const {
+    // a failed load shuts the system down, see Core::System::serialize
+    if (!system.IsPoweredOn()) {
+        return false;
+    }
+    window->MakeCurrent();
+    try {
+        savestate_mt->LoadState(src_buffer, buffer_len);
+    } catch (const std::exception& e) {
+        LOG_ERROR(Frontend, "Error loading savestate: {}", e.what());
+        return false;
+    }
+    return true;
+}
+
+const SavestateStageTimes& EncoreContext::GetSavestateStageTimes() const {
+    return savestate_mt->GetStageTimes();
+}
+
+void EncoreContext::SetDeltaAnchor() {
+    if (!system.IsPoweredOn()) {
+        return;
+    }
+    window->MakeCurrent();
+    system.SetDeltaAnchor();
+}
+
+void EncoreContext::ClearDeltaAnchor() {
+    system.ClearDeltaAnchor();
+}
+
+void EncoreContext::RewindCapture() {
+    if (!system.IsPoweredOn()) {
+        return;
+    }
+    window->MakeCurrent();
+    rewind_buffer->Capture();
+}
+
+bool EncoreContext::RewindStep() {
+    if (!system.IsPoweredOn()) {
+        return false;
+    }
+    window->MakeCurrent();
+    try {
+        return rewind_buffer->Step();
+    } catch (const std::exception& e) {
+        LOG_ERROR(Frontend, "Error rewinding: {}", e.what());
+        return false;
+    }
+}
+
+void EncoreContext::SetRewindBudget(std::size_t budget_bytes) {
+    rewind_buffer->SetBudget(budget_bytes);
+}
+
+bool EncoreContext::ForkState() {
+    window->MakeCurrent();
+    return state_fork->Fork();
+}
+
+bool EncoreContext::RestoreFork() {
     window->MakeCurrent();
-    savestate_mt->LoadState(src_buffer, buffer_len);
+    try {
+        return state_fork->Restore();
+    } catch (const std::exception& e) {
+        LOG_ERROR(Frontend, "Error restoring fork: {}", e.what());
+        return false;
+    }
+}
+
+void EncoreContext::DropFork() {
+    state_fork->Drop();
 }
 
 std::pair<const u8*, std::size_t> EncoreContext::GetMemoryRegion(Memory::Region region) const {
-    const auto is_n3ds = Settings::values.is_new_3ds.GetValue();
+    const auto is_n3ds = Settings::values().is_new_3ds.GetValue();
     switch (region) {
     case Memory::Region::FCRAM:
         return std::make_pair(system.Memory().GetPhysicalPointer(Memory::FCRAM_PADDR),
@@ -255,6 +429,90 @@ const u8* EncoreContext::GetPagePointer(u32 addr) const {
     return system.Memory().GetPointer(addr);
 }
 
+u32 EncoreContext::CreateRamSearch(Memory::Region region, u32 value_size, bool aligned) {
+    if (!system.IsPoweredOn() || region > Memory::Region::N3DS ||
+        (value_size != 1 && value_size != 2 && value_size != 4)) {
+        return 0;
+    }
+
+    const u32 id = next_ram_search_id++;
+    auto session = std::make_unique<RamSearchSession>(region, RamSearch(value_size, aligned));
+    session->search.Reset(GetMemoryRegionSpan(region));
+    ram_searches.emplace(id, std::move(session));
+    return id;
+}
+
+void EncoreContext::DestroyRamSearch(u32 id) {
+    ram_searches.erase(id);
+}
+
+void EncoreContext::ResetRamSearch(u32 id) {
+    if (const auto it = ram_searches.find(id); it != ram_searches.end()) {
+        it->second->search.Reset(GetMemoryRegionSpan(it->second->region));
+    }
+}
+
+std::size_t EncoreContext::FilterRamSearch(u32 id, RamSearch::ValueType type,
+                                           RamSearch::Compare compare, bool to_previous,
+                                           u32 value) {
+    const auto it = ram_searches.find(id);
+    if (it == ram_searches.end()) {
+        return 0;
+    }
+
+    auto& session = *it->second;
+    return session.search.Filter(GetMemoryRegionSpan(session.region), type, compare, to_previous,
+                                 value);
+}
+
+std::size_t EncoreContext::GetRamSearchCount(u32 id) const {
+    const auto it = ram_searches.find(id);
+    return it != ram_searches.end() ? it->second->search.GetCount() : 0;
+}
+
+std::size_t EncoreContext::GetRamSearchResults(u32 id, std::size_t first, std::span<u32> offsets,
+                                               std::span<u32> values) const {
+    const auto it = ram_searches.find(id);
+    if (it == ram_searches.end()) {
+        return 0;
+    }
+
+    const auto& session = *it->second;
+    return session.search.GetResults(GetMemoryRegionSpan(session.region), first, offsets, values);
+}
+
+std::span<const u8> EncoreContext::GetMemoryRegionSpan(Memory::Region region) const {
+    // searches outlive the emulated system, an empty span makes them fail until it's reset
+    if (!system.IsPoweredOn()) {
+        return {};
+    }
+    const auto [ptr, size] = GetMemoryRegion(region);
+    return ptr ? std::span<const u8>{ptr, size} : std::span<const u8>{};
+}
+
+u32 EncoreContext::AddMemoryCallback(Memory::WatchType type, VAddr address, u32 size,
+                                     MemoryCallback callback, void* user_data) {
+    constexpr auto all_types =
+        Memory::WatchType::Read | Memory::WatchType::Write | Memory::WatchType::Execute;
+    if (!system.IsPoweredOn() || !callback || size == 0 || type == Memory::WatchType{} ||
+        (type & ~all_types) != Memory::WatchType{}) {
+        return 0;
+    }
+
+    return system.Memory().AddWatchpoint(
+        address, size, type,
+        [callback, user_data](Memory::WatchType access, VAddr access_address, u32 access_size,
+                              u64 value, u32 pc) {
+            callback(user_data, static_cast<u32>(access), access_address, access_size, value, pc);
+        });
+}
+
+void EncoreContext::RemoveMemoryCallback(u32 id) {
+    if (system.IsPoweredOn()) {
+        system.Memory().RemoveWatchpoint(id);
+    }
+}
+
 std::tuple<Common::Rectangle<u32>, bool, bool> EncoreContext::GetTouchScreenLayout() const {
     const auto& layout = window->GetFramebufferLayout();
     // keep in mind is_rotated is true if in "normal" orientation
@@ -2,25 +2,45 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <unordered_map>
+
 #include "audio_resampler.h"
+#include "boot_cache.h"
 #include "config_headless.h"
 #include "emu_window/emu_window_headless.h"
 #include "emu_window/emu_window_headless_gl.h"
 #include "input_factory/headless_input_factory.h"
+#include "ram_search.h"
+#include "rewind_buffer.h"
 #include "savestate_mt.h"
+#include "state_fork.h"
 
 namespace Headless {
 
+// Called with the user data, the kind, address and size of the access, the value and the PC
+using MemoryCallback = void (*)(void*, u32, u32, u32, u64, u32);
+
 class EncoreContext {
 public:
     EncoreContext(ConfigCallbackInterface& config_interface, GLCallbackInterface& gl_interface,
                   InputCallbackInterface& input_interface);
     ~EncoreContext();
 
+    // The core reaches its system and settings through per-thread bindings, the C interface binds
+    // the calling thread to the context for every call, so contexts can run on different threads
+    struct ThreadBinding {
+        Settings::ScopedValues settings;
+        Core::System::ScopedInstance system;
+    };
+    [[nodiscard]] ThreadBinding BindThread();
+
     std::pair<bool, std::string> InstallCIA(const std::string& cia_path);
     std::optional<std::string> LoadROM(const std::string& rom_path);
 
     bool RunFrame();
+    void RunFrames(std::span<const InputSnapshot> inputs, u32 num_frames, bool present_all_frames,
+                   bool* lagged);
+    void SetInput(const InputSnapshot* snapshot);
     void Reset();
 
     std::pair<u32, u32> GetVideoBufferDimensions() const;
@@ -28,24 +48,68 @@ public:
     void ReadFrameBuffer(u32* dest_buffer);
 
     std::span<const s16> GetAudio() const;
+    void SetAudioSampleRate(u32 rate);
+    void SetAudioBuffer(std::span<s16> buffer);
 
     void ReloadConfig() const;
 
     std::size_t StartSaveState();
     void FinishSaveState(void* dest_buffer);
-    void LoadState(void* src_buffer, std::size_t buffer_len) const;
+    bool LoadState(void* src_buffer, std::size_t buffer_len) const;
+    const SavestateStageTimes& GetSavestateStageTimes() const;
+    void SetDeltaAnchor();
+    void ClearDeltaAnchor();
+
+    void RewindCapture();
+    bool RewindStep();
+    void SetRewindBudget(std::size_t budget_bytes);
+
+    bool ForkState();
+    bool RestoreFork();
+    void DropFork();
 
     std::pair<const u8*, std::size_t> GetMemoryRegion(Memory::Region region) const;
     const u8* GetPagePointer(u32 addr) const;
 
+    u32 CreateRamSearch(Memory::Region region, u32 value_size, bool aligned);
+    void DestroyRamSearch(u32 id);
+    void ResetRamSearch(u32 id);
+    std::size_t FilterRamSearch(u32 id, RamSearch::ValueType type, RamSearch::Compare compare,
+                                bool to_previous, u32 value);
+    std::size_t GetRamSearchCount(u32 id) const;
+    std::size_t GetRamSearchResults(u32 id, std::size_t first, std::span<u32> offsets,
+                                    std::span<u32> values) const;
+
+    u32 AddMemoryCallback(Memory::WatchType type, VAddr address, u32 size, MemoryCallback callback,
+                          void* user_data);
+    void RemoveMemoryCallback(u32 id);
+
     std::tuple<Common::Rectangle<u32>, bool, bool> GetTouchScreenLayout() const;
 
 private:
+    // Loads the ROM into the system, returns an error message on failure
+    std::optional<std::string> LoadSystem(const std::string& rom_path);
+    std::span<const u8> GetMemoryRegionSpan(Memory::Region region) const;
+
+    std::unique_ptr<Settings::Values> settings;
+    std::unique_ptr<Core::System> system_instance;
     Core::System& system;
+    std::string input_engine;
     std::unique_ptr<EmuWindow_Headless> window;
     std::unique_ptr<Config_Headless> config;
+    std::shared_ptr<HeadlessInput> input;
     std::unique_ptr<Savestate_MT> savestate_mt;
     std::unique_ptr<AudioResampler> audio_resampler;
+    std::unique_ptr<RewindBuffer> rewind_buffer;
+    std::unique_ptr<StateFork> state_fork;
+    std::unique_ptr<BootCache> boot_cache;
+
+    struct RamSearchSession {
+        Memory::Region region;
+        RamSearch search;
+    };
+    std::unordered_map<u32, std::unique_ptr<RamSearchSession>> ram_searches;
+    u32 next_ram_search_id{1};
 };
 
 } // namespace Headless
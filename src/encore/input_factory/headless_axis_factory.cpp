@@ -10,17 +10,17 @@ class HeadlessAxis;
 
 class HeadlessAxis final : public Input::AnalogDevice {
 public:
-    explicit HeadlessAxis(GetAxisCallback callback_, u32 axis_)
-        : callback(callback_), axis(axis_) {}
+    explicit HeadlessAxis(std::shared_ptr<const HeadlessInput> input_, u32 axis_)
+        : input(std::move(input_)), axis(axis_) {}
 
     std::tuple<float, float> GetStatus() const override {
         float x, y;
-        callback(axis, &x, &y);
+        input->GetAxis(axis, &x, &y);
         return std::make_tuple(x, y);
     }
 
 private:
-    GetAxisCallback callback;
+    std::shared_ptr<const HeadlessInput> input;
     u32 axis;
 };
 
@@ -28,11 +28,11 @@ private:
 
 using namespace Headless;
 
-HeadlessAxisFactory::HeadlessAxisFactory(InputCallbackInterface& input_interface)
-    : callback(input_interface.GetAxis) {}
+HeadlessAxisFactory::HeadlessAxisFactory(std::shared_ptr<const HeadlessInput> input_)
+    : input(std::move(input_)) {}
 
 std::unique_ptr<Input::AnalogDevice> HeadlessAxisFactory::Create(
     const Common::ParamPackage& params) {
     const u32 axis = params.Get("axis", 0);
-    return std::make_unique<HeadlessAxis>(callback, axis);
+    return std::make_unique<HeadlessAxis>(input, axis);
 }
@@ -13,12 +13,12 @@ namespace Headless {
 
 class HeadlessAxisFactory final : public Input::Factory<Input::AnalogDevice> {
 public:
-    explicit HeadlessAxisFactory(InputCallbackInterface& input_interface);
+    explicit HeadlessAxisFactory(std::shared_ptr<const HeadlessInput> input);
 
     std::unique_ptr<Input::AnalogDevice> Create(const Common::ParamPackage& params) override;
 
 private:
-    GetAxisCallback callback;
+    std::shared_ptr<const HeadlessInput> input;
 };
 
 } // namespace Headless
@@ -10,15 +10,15 @@ class HeadlessButton;
 
 class HeadlessButton final : public Input::ButtonDevice {
 public:
-    explicit HeadlessButton(GetButtonCallback callback_, u32 button_)
-        : callback(callback_), button(button_) {}
+    explicit HeadlessButton(std::shared_ptr<const HeadlessInput> input_, u32 button_)
+        : input(std::move(input_)), button(button_) {}
 
     bool GetStatus() const override {
-        return callback(button);
+        return input->GetButton(button);
     }
 
 private:
-    GetButtonCallback callback;
+    std::shared_ptr<const HeadlessInput> input;
     u32 button;
 };
 
@@ -26,11 +26,11 @@ private:
 
 using namespace Headless;
 
-HeadlessButtonFactory::HeadlessButtonFactory(InputCallbackInterface& input_interface)
-    : callback(input_interface.GetButton) {}
+HeadlessButtonFactory::HeadlessButtonFactory(std::shared_ptr<const HeadlessInput> input_)
+    : input(std::move(input_)) {}
 
 std::unique_ptr<Input::ButtonDevice> HeadlessButtonFactory::Create(
     const Common::ParamPackage& params) {
     const u32 button = params.Get("button", 0);
-    return std::make_unique<HeadlessButton>(callback, button);
+    return std::make_unique<HeadlessButton>(input, button);
 }
@@ -13,12 +13,12 @@ namespace Headless {
 
 class HeadlessButtonFactory final : public Input::Factory<Input::ButtonDevice> {
 public:
-    explicit HeadlessButtonFactory(InputCallbackInterface& input_interface);
+    explicit HeadlessButtonFactory(std::shared_ptr<const HeadlessInput> input);
 
     std::unique_ptr<Input::ButtonDevice> Create(const Common::ParamPackage& params) override;
 
 private:
-    GetButtonCallback callback;
+    std::shared_ptr<const HeadlessInput> input;
 };
 
 } // namespace Headless
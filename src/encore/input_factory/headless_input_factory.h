@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <optional>
 #include "common/common_types.h"
+#include "common/vector_math.h"
 
 namespace Headless {
 
@@ -20,4 +22,76 @@ struct InputCallbackInterface {
     GetMotionCallback GetMotion;
 };
 
+// Input state of a single frame, as passed through the C interface
+struct InputSnapshot {
+    u32 buttons;      // bit N is set if button N is pressed
+    float axes[2][2]; // x and y of the circle pad and the c-stick
+    float touch_x;
+    float touch_y;
+    u32 touching;
+    float accel[3];
+    float gyro[3];
+};
+// the frontend relies on this layout
+static_assert(sizeof(InputSnapshot) == 56);
+
+// Where the headless input devices get their state from
+// Queries call back into the frontend, unless the frontend has pushed a snapshot
+// Reading a snapshot doesn't leave the core, which is much cheaper for managed frontends
+class HeadlessInput {
+public:
+    explicit HeadlessInput(const InputCallbackInterface& callbacks_) : callbacks(callbacks_) {}
+
+    // sets the state returned from now on, or goes back to the callbacks if empty
+    void SetSnapshot(const std::optional<InputSnapshot>& snapshot_) {
+        snapshot = snapshot_;
+    }
+
+    const std::optional<InputSnapshot>& GetSnapshot() const {
+        return snapshot;
+    }
+
+    bool GetButton(u32 button) const {
+        if (snapshot) {
+            return button < 32 && (snapshot->buttons >> button) & 1;
+        }
+
+        return callbacks.GetButton(button);
+    }
+
+    void GetAxis(u32 axis, float* x, float* y) const {
+        if (snapshot) {
+            *x = axis < 2 ? snapshot->axes[axis][0] : 0.0f;
+            *y = axis < 2 ? snapshot->axes[axis][1] : 0.0f;
+            return;
+        }
+
+        callbacks.GetAxis(axis, x, y);
+    }
+
+    bool GetTouch(float* x, float* y) const {
+        if (snapshot) {
+            *x = snapshot->touch_x;
+            *y = snapshot->touch_y;
+            return snapshot->touching != 0;
+        }
+
+        return callbacks.GetTouch(x, y);
+    }
+
+    void GetMotion(Common::Vec3<float>& accel, Common::Vec3<float>& gyro) const {
+        if (snapshot) {
+            accel = Common::MakeVec(snapshot->accel[0], snapshot->accel[1], snapshot->accel[2]);
+            gyro = Common::MakeVec(snapshot->gyro[0], snapshot->gyro[1], snapshot->gyro[2]);
+            return;
+        }
+
+        callbacks.GetMotion(&accel.x, &accel.y, &accel.z, &gyro.x, &gyro.y, &gyro.z);
+    }
+
+private:
+    InputCallbackInterface callbacks;
+    std::optional<InputSnapshot> snapshot;
+};
+
 } // namespace Headless
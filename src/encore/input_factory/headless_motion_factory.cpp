@@ -10,26 +10,27 @@ class HeadlessMotion;
 
 class HeadlessMotion final : public Input::MotionDevice {
 public:
-    explicit HeadlessMotion(GetMotionCallback callback_) : callback(callback_) {}
+    explicit HeadlessMotion(std::shared_ptr<const HeadlessInput> input_)
+        : input(std::move(input_)) {}
 
     std::tuple<Common::Vec3<float>, Common::Vec3<float>> GetStatus() const override {
         Common::Vec3<float> accel, gyro;
-        callback(&accel.x, &accel.y, &accel.z, &gyro.x, &gyro.y, &gyro.z);
+        input->GetMotion(accel, gyro);
         return std::make_tuple(accel, gyro);
     }
 
 private:
-    GetMotionCallback callback;
+    std::shared_ptr<const HeadlessInput> input;
 };
 
 } // namespace Headless
 
 using namespace Headless;
 
-HeadlessMotionFactory::HeadlessMotionFactory(InputCallbackInterface& input_interface)
-    : callback(input_interface.GetMotion) {}
+HeadlessMotionFactory::HeadlessMotionFactory(std::shared_ptr<const HeadlessInput> input_)
+    : input(std::move(input_)) {}
 
 std::unique_ptr<Input::MotionDevice> HeadlessMotionFactory::Create(
     const Common::ParamPackage& params) {
-    return std::make_unique<HeadlessMotion>(callback);
+    return std::make_unique<HeadlessMotion>(input);
 }
@@ -13,12 +13,12 @@ namespace Headless {
 
 class HeadlessMotionFactory final : public Input::Factory<Input::MotionDevice> {
 public:
-    explicit HeadlessMotionFactory(InputCallbackInterface& input_interface);
+    explicit HeadlessMotionFactory(std::shared_ptr<const HeadlessInput> input);
 
     std::unique_ptr<Input::MotionDevice> Create(const Common::ParamPackage& params) override;
 
 private:
-    GetMotionCallback callback;
+    std::shared_ptr<const HeadlessInput> input;
 };
 
 } // namespace Headless
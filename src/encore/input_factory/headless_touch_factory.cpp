@@ -10,26 +10,27 @@ class HeadlessTouch;
 
 class HeadlessTouch final : public Input::TouchDevice {
 public:
-    explicit HeadlessTouch(GetTouchCallback callback_) : callback(callback_) {}
+    explicit HeadlessTouch(std::shared_ptr<const HeadlessInput> input_)
+        : input(std::move(input_)) {}
 
     std::tuple<float, float, bool> GetStatus() const override {
         float x, y;
-        const auto touching = callback(&x, &y);
+        const auto touching = input->GetTouch(&x, &y);
         return std::make_tuple(x, y, touching);
     }
 
 private:
-    GetTouchCallback callback;
+    std::shared_ptr<const HeadlessInput> input;
 };
 
 } // namespace Headless
 
 using namespace Headless;
 
-HeadlessTouchFactory::HeadlessTouchFactory(InputCallbackInterface& input_interface)
-    : callback(input_interface.GetTouch) {}
+HeadlessTouchFactory::HeadlessTouchFactory(std::shared_ptr<const HeadlessInput> input_)
+    : input(std::move(input_)) {}
 
 std::unique_ptr<Input::TouchDevice> HeadlessTouchFactory::Create(
     const Common::ParamPackage& params) {
-    return std::make_unique<HeadlessTouch>(callback);
+    return std::make_unique<HeadlessTouch>(input);
 }
@@ -13,12 +13,12 @@ namespace Headless {
 
 class HeadlessTouchFactory final : public Input::Factory<Input::TouchDevice> {
 public:
-    explicit HeadlessTouchFactory(InputCallbackInterface& input_interface);
+    explicit HeadlessTouchFactory(std::shared_ptr<const HeadlessInput> input);
 
     std::unique_ptr<Input::TouchDevice> Create(const Common::ParamPackage& params) override;
 
 private:
-    GetTouchCallback callback;
+    std::shared_ptr<const HeadlessInput> input;
 };
 
 } // namespace Headless
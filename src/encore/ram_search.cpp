@@ -0,0 +1,278 @@
+// Copyright 2024 Encore Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+#include "common/assert.h"
+#include "common/logging/log.h"
+
+#include "ram_search.h"
+
+namespace Headless {
+
+namespace {
+
+constexpr std::size_t SLOTS_PER_WORD = 64;
+
+// Splitting smaller searches over workers costs more than it saves
+constexpr std::size_t MIN_WORDS_PER_TASK = 4096;
+
+// Filters the candidates of a range of words, returns the number of candidates left in it
+// The stride is a constant and the inner loop has no branches, so it can be vectorized
+template <typename T, typename Op, bool ToPrevious, bool Aligned>
+std::size_t FilterWords(std::span<u64> words, std::size_t first_word, const u8* current,
+                        const u8* previous, std::size_t num_slots, T value) {
+    constexpr std::size_t step = Aligned ? sizeof(T) : 1;
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < words.size(); i++) {
+        u64& word = words[i];
+        if (word == 0) {
+            continue;
+        }
+
+        const std::size_t first_slot = (first_word + i) * SLOTS_PER_WORD;
+        const std::size_t num = std::min(SLOTS_PER_WORD, num_slots - first_slot);
+        const u8* current_word = current + first_slot * step;
+        const u8* previous_word = previous + first_slot * step;
+        std::array<u8, SLOTS_PER_WORD> results{};
+        for (std::size_t slot = 0; slot < num; slot++) {
+            T lhs;
+            std::memcpy(&lhs, current_word + slot * step, sizeof(T));
+            T rhs = value;
+            if constexpr (ToPrevious) {
+                std::memcpy(&rhs, previous_word + slot * step, sizeof(T));
+            }
+            results[slot] = Op{}(lhs, rhs);
+        }
+
+        // Gather the lowest bit of each group of 8 bytes into a single byte
+        u64 mask = 0;
+        for (std::size_t group = 0; group < SLOTS_PER_WORD / 8; group++) {
+            u64 bytes;
+            std::memcpy(&bytes, results.data() + group * 8, sizeof(bytes));
+            mask |= ((bytes * 0x0102040810204080ULL) >> 56) << (group * 8);
+        }
+
+        word &= mask;
+        count += std::popcount(word);
+    }
+    return count;
+}
+
+using FilterFunc = std::size_t (*)(std::span<u64>, std::size_t, const u8*, const u8*,
+                                   std::size_t, u32);
+
+template <typename T, typename Op, bool ToPrevious, bool Aligned>
+std::size_t FilterWordsRaw(std::span<u64> words, std::size_t first_word, const u8* current,
+                           const u8* previous, std::size_t num_slots, u32 value) {
+    T typed_value;
+    if constexpr (sizeof(T) == sizeof(u32)) {
+        typed_value = std::bit_cast<T>(value);
+    } else {
+        typed_value = static_cast<T>(value);
+    }
+    return FilterWords<T, Op, ToPrevious, Aligned>(words, first_word, current, previous, num_slots,
+                                                   typed_value);
+}
+
+template <typename T, typename Op>
+FilterFunc GetFilterFunc(bool to_previous, bool aligned) {
+    if (aligned) {
+        return to_previous ? &FilterWordsRaw<T, Op, true, true>
+                           : &FilterWordsRaw<T, Op, false, true>;
+    }
+    return to_previous ? &FilterWordsRaw<T, Op, true, false>
+                       : &FilterWordsRaw<T, Op, false, false>;
+}
+
+template <typename T>
+FilterFunc GetFilterFunc(RamSearch::Compare compare, bool to_previous, bool aligned) {
+    switch (compare) {
+    case RamSearch::Compare::Equal:
+        return GetFilterFunc<T, std::equal_to<T>>(to_previous, aligned);
+    case RamSearch::Compare::NotEqual:
+        return GetFilterFunc<T, std::not_equal_to<T>>(to_previous, aligned);
+    case RamSearch::Compare::Less:
+        return GetFilterFunc<T, std::less<T>>(to_previous, aligned);
+    case RamSearch::Compare::Greater:
+        return GetFilterFunc<T, std::greater<T>>(to_previous, aligned);
+    case RamSearch::Compare::LessEqual:
+        return GetFilterFunc<T, std::less_equal<T>>(to_previous, aligned);
+    case RamSearch::Compare::GreaterEqual:
+        return GetFilterFunc<T, std::greater_equal<T>>(to_previous, aligned);
+    default:
+        return nullptr;
+    }
+}
+
+FilterFunc GetFilterFunc(u32 value_size, RamSearch::ValueType type, RamSearch::Compare compare,
+                         bool to_previous, bool aligned) {
+    switch (type) {
+    case RamSearch::ValueType::Unsigned:
+        switch (value_size) {
+        case 1:
+            return GetFilterFunc<u8>(compare, to_previous, aligned);
+        case 2:
+            return GetFilterFunc<u16>(compare, to_previous, aligned);
+        case 4:
+            return GetFilterFunc<u32>(compare, to_previous, aligned);
+        }
+        break;
+    case RamSearch::ValueType::Signed:
+        switch (value_size) {
+        case 1:
+            return GetFilterFunc<s8>(compare, to_previous, aligned);
+        case 2:
+            return GetFilterFunc<s16>(compare, to_previous, aligned);
+        case 4:
+            return GetFilterFunc<s32>(compare, to_previous, aligned);
+        }
+        break;
+    case RamSearch::ValueType::Float:
+        if (value_size == 4) {
+            return GetFilterFunc<float>(compare, to_previous, aligned);
+        }
+        break;
+    }
+    return nullptr;
+}
+
+} // Anonymous namespace
+
+RamSearch::RamSearch(u32 value_size_, bool aligned)
+    : value_size(value_size_), step(aligned ? value_size_ : 1) {
+    ASSERT(value_size == 1 || value_size == 2 || value_size == 4);
+}
+
+void RamSearch::Reset(std::span<const u8> memory) {
+    memory_size = memory.size();
+    num_slots = memory_size >= value_size ? (memory_size - value_size) / step + 1 : 0;
+    count = num_slots;
+
+    candidates.assign((num_slots + SLOTS_PER_WORD - 1) / SLOTS_PER_WORD, ~u64{0});
+    if (num_slots % SLOTS_PER_WORD != 0) {
+        candidates.back() = (u64{1} << (num_slots % SLOTS_PER_WORD)) - 1;
+    }
+
+    previous.assign(memory.begin(), memory.end());
+}
+
+std::size_t RamSearch::Filter(std::span<const u8> memory, ValueType type, Compare compare,
+                              bool to_previous, u32 value) {
+    if (memory.size() != memory_size) {
+        // The region changed size, e.g. after switching between Old and New 3DS
+        Reset(memory);
+    }
+
+    const FilterFunc filter = GetFilterFunc(value_size, type, compare, to_previous, step != 1);
+    if (!filter) {
+        LOG_ERROR(Frontend, "Invalid RAM search filter, size {} type {} compare {}", value_size,
+                  static_cast<u32>(type), static_cast<u32>(compare));
+        return count;
+    }
+
+    const std::size_t num_words = candidates.size();
+    const std::size_t num_tasks =
+        std::clamp<std::size_t>(num_words / MIN_WORDS_PER_TASK, 1,
+                                std::max(std::thread::hardware_concurrency(), 1U));
+    std::vector<std::size_t> task_counts(num_tasks);
+    const auto run_task = [&](std::size_t task) {
+        const std::size_t first_word = task * num_words / num_tasks;
+        const std::size_t last_word = (task + 1) * num_words / num_tasks;
+        task_counts[task] =
+            filter(std::span{candidates}.subspan(first_word, last_word - first_word), first_word,
+                   memory.data(), previous.data(), num_slots, value);
+    };
+
+    if (num_tasks == 1) {
+        run_task(0);
+    } else {
+        if (!workers) {
+            workers = std::make_unique<Common::ThreadWorker>(
+                std::max(std::thread::hardware_concurrency(), 1U), "RAM search");
+        }
+        for (std::size_t task = 0; task < num_tasks; task++) {
+            workers->QueueWork([&run_task, task] { run_task(task); });
+        }
+        workers->WaitForRequests();
+    }
+
+    count = 0;
+    for (const std::size_t task_count : task_counts) {
+        count += task_count;
+    }
+
+    // Only the values of remaining candidates are compared again later. Values of neighbouring
+    // slots can overlap, so this is done once all tasks are done reading the previous values.
+    for (std::size_t word = 0; word < num_words; word++) {
+        if (candidates[word] == 0) {
+            continue;
+        }
+        const std::size_t first_slot = word * SLOTS_PER_WORD;
+        const std::size_t last_slot = std::min(first_slot + SLOTS_PER_WORD, num_slots) - 1;
+        const std::size_t begin = first_slot * step;
+        const std::size_t end = last_slot * step + value_size;
+        std::memcpy(previous.data() + begin, memory.data() + begin, end - begin);
+    }
+
+    return count;
+}
+
+std::size_t RamSearch::GetResults(std::span<const u8> memory, std::size_t first,
+                                  std::span<u32> offsets, std::span<u32> values) const {
+    if (memory.size() != memory_size) {
+        return 0;
+    }
+
+    const std::size_t max_results = std::min(offsets.size(), values.size());
+    std::size_t skipped = 0;
+    std::size_t written = 0;
+    for (std::size_t word = 0; word < candidates.size() && written < max_results; word++) {
+        u64 bits = candidates[word];
+        const std::size_t word_count = std::popcount(bits);
+        if (skipped + word_count <= first) {
+            skipped += word_count;
+            continue;
+        }
+
+        while (bits != 0 && written < max_results) {
+            const std::size_t slot = word * SLOTS_PER_WORD + std::countr_zero(bits);
+            bits &= bits - 1;
+            if (skipped++ < first) {
+                continue;
+            }
+            const std::size_t offset = slot * step;
+            offsets[written] = static_cast<u32>(offset);
+            values[written] = ReadValue(memory.data(), offset);
+            written++;
+        }
+    }
+    return written;
+}
+
+u32 RamSearch::ReadValue(const u8* data, std::size_t offset) const {
+    switch (value_size) {
+    case 1:
+        return data[offset];
+    case 2: {
+        u16 value;
+        std::memcpy(&value, data + offset, sizeof(value));
+        return value;
+    }
+    case 4: {
+        u32 value;
+        std::memcpy(&value, data + offset, sizeof(value));
+        return value;
+    }
+    default:
+        UNREACHABLE();
+    }
+}
+
+} // namespace Headless
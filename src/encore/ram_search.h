@@ -0,0 +1,69 @@
+// Copyright 2024 Encore Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/thread_worker.h"
+
+namespace Headless {
+
+// A RAM search session over one memory region
+// Candidates are kept as a bitmap with one bit per possible value location, together with the
+// values they had after the previous step, so a step only touches memory around candidates
+class RamSearch {
+public:
+    enum class ValueType : u32 {
+        Unsigned,
+        Signed,
+        Float,
+    };
+
+    enum class Compare : u32 {
+        Equal,
+        NotEqual,
+        Less,
+        Greater,
+        LessEqual,
+        GreaterEqual,
+    };
+
+    // value_size is 1, 2 or 4 bytes, aligned searches only consider multiples of it
+    RamSearch(u32 value_size, bool aligned);
+
+    // makes every location a candidate again, and remembers the current values
+    void Reset(std::span<const u8> memory);
+
+    // keeps the candidates whose current value compares true against either their previous
+    // value or the provided one, returns the number of candidates left
+    std::size_t Filter(std::span<const u8> memory, ValueType type, Compare compare,
+                       bool to_previous, u32 value);
+
+    std::size_t GetCount() const {
+        return count;
+    }
+
+    // writes the offsets and current values of candidates, starting with the first-th one
+    // returns the number of candidates written
+    std::size_t GetResults(std::span<const u8> memory, std::size_t first, std::span<u32> offsets,
+                           std::span<u32> values) const;
+
+private:
+    u32 ReadValue(const u8* data, std::size_t offset) const;
+
+    u32 value_size;
+    u32 step;
+    std::size_t memory_size{0};
+    std::size_t num_slots{0};
+    std::size_t count{0};
+    std::vector<u64> candidates;
+    std::vector<u8> previous;
+    std::unique_ptr<Common::ThreadWorker> workers;
+};
+
+} // namespace Headless
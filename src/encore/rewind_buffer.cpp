@@ -0,0 +1,269 @@
+// Copyright 2024 Encore Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+
+#include "common/archives.h"
+#include "common/scope_exit.h"
+#include "common/zstd_compression.h"
+#include "core/memory.h"
+#include "video_core/gpu.h"
+
+#include "rewind_buffer.h"
+#include "state_buffers.h"
+
+using namespace Headless;
+
+// a new keyframe is taken every 2 seconds of captures at 60 fps
+constexpr u32 KEYFRAME_INTERVAL = 120;
+// if the compression thread falls this far behind, the oldest waiting delta is dropped
+constexpr std::size_t MAX_PENDING_CAPTURES = 4;
+constexpr std::size_t MAX_FREE_BUFFERS = MAX_PENDING_CAPTURES;
+// deltas are mostly zeroes, so the fastest level already compresses them well
+constexpr s32 REWIND_COMPRESSION_LEVEL = 1;
+
+static void XorStates(u8* dest, const u8* a, const u8* b, std::size_t size) {
+    std::size_t i = 0;
+    for (; i + sizeof(u64) <= size; i += sizeof(u64)) {
+        u64 x, y;
+        std::memcpy(&x, a + i, sizeof(u64));
+        std::memcpy(&y, b + i, sizeof(u64));
+        x ^= y;
+        std::memcpy(dest + i, &x, sizeof(u64));
+    }
+    for (; i < size; i++) {
+        dest[i] = a[i] ^ b[i];
+    }
+}
+
+RewindBuffer::RewindBuffer(Core::System& system_)
+    : system(system_), compression_worker(1, "Rewind Compression") {}
+
+RewindBuffer::~RewindBuffer() = default;
+
+void RewindBuffer::SetBudget(std::size_t budget_bytes) {
+    compression_worker.WaitForRequests();
+    if (budget_bytes == 0) {
+        Clear();
+    }
+
+    std::scoped_lock lock{entries_mutex};
+    budget = budget_bytes;
+    while (used_bytes > budget && !entries.empty()) {
+        PopOldest();
+    }
+}
+
+void RewindBuffer::Capture() {
+    {
+        std::scoped_lock lock{entries_mutex};
+        if (budget == 0) {
+            return;
+        }
+    }
+
+    auto& memory = system.Memory();
+    const std::size_t ram_size = memory.GetRamSize();
+    auto state = TakeFreeBuffer();
+    state.resize(ram_size);
+    {
+        memory.SetSerializeRam(false);
+        SCOPE_EXIT({ memory.SetSerializeRam(true); });
+
+        StateSaveBuf save_buf(state);
+        oarchive oa{save_buf, boost::archive::archive_flags::no_header |
+                                  boost::archive::archive_flags::no_codecvt};
+        oa & system;
+    }
+    // saving wrote back the rasterizer surfaces, so the RAM is up to date
+    memory.ReadRam(state.data());
+
+    PendingCapture capture;
+    if (!current_keyframe || captures_since_keyframe >= KEYFRAME_INTERVAL ||
+        current_keyframe->ram_size != ram_size) {
+        auto keyframe = std::make_shared<Keyframe>();
+        keyframe->state = std::move(state);
+        keyframe->ram_size = ram_size;
+        capture = PendingCapture{
+            .keyframe = keyframe,
+            .state = {},
+            .previous_keyframe = std::move(current_keyframe),
+        };
+        current_keyframe = std::move(keyframe);
+        captures_since_keyframe = 0;
+    } else {
+        capture = PendingCapture{
+            .keyframe = current_keyframe,
+            .state = std::move(state),
+            .previous_keyframe = nullptr,
+        };
+        captures_since_keyframe++;
+    }
+
+    {
+        // the frame loop never waits for compression, when it falls behind the oldest delta is
+        // dropped instead; keyframes are kept as later deltas depend on them
+        std::scoped_lock lock{entries_mutex};
+        if (pending_captures.size() >= MAX_PENDING_CAPTURES) {
+            const auto oldest_delta =
+                std::find_if(pending_captures.begin(), pending_captures.end(),
+                             [](const PendingCapture& pending) { return !pending.state.empty(); });
+            if (oldest_delta != pending_captures.end()) {
+                if (free_buffers.size() < MAX_FREE_BUFFERS) {
+                    free_buffers.push_back(std::move(oldest_delta->state));
+                }
+                pending_captures.erase(oldest_delta);
+            }
+        }
+        pending_captures.push_back(std::move(capture));
+    }
+    compression_worker.QueueWork([this] { CompressPending(); });
+}
+
+bool RewindBuffer::Step() {
+    compression_worker.WaitForRequests();
+
+    std::unique_lock lock{entries_mutex};
+    if (entries.empty()) {
+        return false;
+    }
+
+    Entry entry = std::move(entries.back());
+    entries.pop_back();
+    used_bytes -= entry.compressed.size();
+    if (entries.empty() || entries.back().keyframe != entry.keyframe) {
+        used_bytes -= entry.keyframe->compressed.size();
+    }
+    lock.unlock();
+
+    const auto& keyframe = *entry.keyframe;
+    auto& memory = system.Memory();
+    if (keyframe.ram_size != memory.GetRamSize()) {
+        throw std::runtime_error("Rewind state was captured on another console model");
+    }
+
+    std::vector<u8> state;
+    if (entry.compressed.empty()) {
+        state = keyframe.state.empty()
+                    ? Common::Compression::DecompressDataZSTD(keyframe.compressed)
+                    : keyframe.state;
+    } else {
+        state = Common::Compression::DecompressDataZSTD(entry.compressed);
+        std::vector<u8> decompressed_keyframe;
+        if (keyframe.state.empty()) {
+            decompressed_keyframe = Common::Compression::DecompressDataZSTD(keyframe.compressed);
+        }
+        const auto& key = keyframe.state.empty() ? decompressed_keyframe : keyframe.state;
+        XorStates(state.data(), state.data(), key.data(), std::min(state.size(), key.size()));
+    }
+    if (state.size() < keyframe.ram_size) {
+        throw std::runtime_error("Rewind state is truncated");
+    }
+
+    StateLoadBuf load_buf(std::span{state}.subspan(keyframe.ram_size));
+    iarchive ia{load_buf, boost::archive::archive_flags::no_header |
+                              boost::archive::archive_flags::no_codecvt};
+    ia & system;
+
+    // loading reinitializes the services, which clear their shared memory in the RAM, so the RAM
+    // is written afterwards and nothing the rasterizer cached in between may be used
+    memory.WriteRam(state.data());
+    system.GPU().ClearAll(false);
+    return true;
+}
+
+void RewindBuffer::Clear() {
+    compression_worker.WaitForRequests();
+
+    std::scoped_lock lock{entries_mutex};
+    entries.clear();
+    used_bytes = 0;
+    free_buffers.clear();
+    pending_captures.clear();
+    current_keyframe.reset();
+    captures_since_keyframe = 0;
+}
+
+void RewindBuffer::CompressPending() {
+    PendingCapture capture;
+    {
+        std::scoped_lock lock{entries_mutex};
+        // dropped captures leave work items without a capture behind
+        if (pending_captures.empty()) {
+            return;
+        }
+        capture = std::move(pending_captures.front());
+        pending_captures.pop_front();
+    }
+
+    auto& keyframe = *capture.keyframe;
+    if (capture.state.empty()) {
+        // captures are compressed in order, so the deltas of the previous keyframe are done
+        if (capture.previous_keyframe) {
+            capture.previous_keyframe->state = {};
+        }
+        keyframe.compressed =
+            Common::Compression::CompressDataZSTD(keyframe.state, REWIND_COMPRESSION_LEVEL);
+        AddEntry(Entry{
+            .keyframe = std::move(capture.keyframe),
+            .compressed = {},
+        });
+        return;
+    }
+
+    // states past the end of the keyframe are XORed against zeroes, i.e. stored as is
+    auto& state = capture.state;
+    XorStates(state.data(), state.data(), keyframe.state.data(),
+              std::min(state.size(), keyframe.state.size()));
+    auto compressed = Common::Compression::CompressDataZSTD(state, REWIND_COMPRESSION_LEVEL);
+    {
+        std::scoped_lock lock{entries_mutex};
+        if (free_buffers.size() < MAX_FREE_BUFFERS) {
+            free_buffers.push_back(std::move(state));
+        }
+    }
+
+    AddEntry(Entry{
+        .keyframe = std::move(capture.keyframe),
+        .compressed = std::move(compressed),
+    });
+}
+
+void RewindBuffer::AddEntry(Entry&& entry) {
+    std::scoped_lock lock{entries_mutex};
+    // keyframes are accounted for as long as any entry still refers to them
+    if (entries.empty() || entries.back().keyframe != entry.keyframe) {
+        used_bytes += entry.keyframe->compressed.size();
+    }
+    used_bytes += entry.compressed.size();
+    entries.push_back(std::move(entry));
+
+    // always keep the newest entry, even if it alone exceeds the budget
+    while (used_bytes > budget && entries.size() > 1) {
+        PopOldest();
+    }
+}
+
+void RewindBuffer::PopOldest() {
+    const auto keyframe = std::move(entries.front().keyframe);
+    used_bytes -= entries.front().compressed.size();
+    entries.pop_front();
+    if (entries.empty() || entries.front().keyframe != keyframe) {
+        used_bytes -= keyframe->compressed.size();
+    }
+}
+
+std::vector<u8> RewindBuffer::TakeFreeBuffer() {
+    std::scoped_lock lock{entries_mutex};
+    if (free_buffers.empty()) {
+        return {};
+    }
+
+    auto buffer = std::move(free_buffers.back());
+    free_buffers.pop_back();
+    return buffer;
+}
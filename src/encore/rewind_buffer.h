@@ -0,0 +1,70 @@
+// Copyright 2024 Encore Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/thread_worker.h"
+#include "core/core.h"
+
+namespace Headless {
+
+class RewindBuffer {
+public:
+    explicit RewindBuffer(Core::System& system);
+    ~RewindBuffer();
+
+    void SetBudget(std::size_t budget_bytes);
+    void Capture();
+    bool Step();
+    void Clear();
+
+private:
+    // States are the emulated RAM followed by the rest of the system serialized without it, so the
+    // RAM stays at the same offsets. They're XORed against the most recent keyframe, so the deltas
+    // are mostly zeroes and compress to a fraction of a full state
+    struct Keyframe {
+        std::vector<u8> state; // only kept while this is the current keyframe
+        std::vector<u8> compressed;
+        std::size_t ram_size{};
+    };
+
+    struct Entry {
+        std::shared_ptr<Keyframe> keyframe;
+        std::vector<u8> compressed; // empty if this entry is the keyframe itself
+    };
+
+    // A capture waiting for the compression thread
+    struct PendingCapture {
+        std::shared_ptr<Keyframe> keyframe;
+        std::vector<u8> state; // empty if this is the keyframe itself
+        // the keyframe replaced by this one, its state is dropped once its deltas are compressed
+        std::shared_ptr<Keyframe> previous_keyframe;
+    };
+
+    void CompressPending();
+    void AddEntry(Entry&& entry);
+    void PopOldest();
+    std::vector<u8> TakeFreeBuffer();
+
+    Core::System& system;
+
+    std::mutex entries_mutex;
+    std::deque<Entry> entries;
+    std::size_t used_bytes{0};
+    std::size_t budget{0};
+    std::vector<std::vector<u8>> free_buffers;
+    std::deque<PendingCapture> pending_captures;
+
+    std::shared_ptr<Keyframe> current_keyframe;
+    u32 captures_since_keyframe{0};
+
+    Common::ThreadWorker compression_worker;
+};
+
+} // namespace Headless
@@ -2,135 +2,292 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+
 #include "common/archives.h"
+#include "common/assert.h"
 
 #include "savestate_mt.h"
 
 namespace Headless {
 
+constexpr std::size_t ONE_MiB = 0x100000;
+constexpr std::size_t FOUR_MiB = ONE_MiB * 4;
+// states are written as independent zstd frames of (at most) this size, which are streamed
+// through a small ring of blocks rather than being staged in full
+constexpr std::size_t BLOCK_SIZE = ONE_MiB * 2;
+constexpr std::size_t NUM_BLOCKS = 8;
+constexpr s32 COMPRESSION_LEVEL = 1;
+
+static u64 NanosecondsSince(std::chrono::steady_clock::time_point start) {
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+}
+
+struct BlockRing {
+    explicit BlockRing(u8* pool_) : pool(pool_) {}
+
+    static std::size_t Slot(std::size_t index) {
+        return index % NUM_BLOCKS;
+    }
+
+    u8* Block(std::size_t index) const {
+        return pool + Slot(index) * BLOCK_SIZE;
+    }
+
+    // Waits until the block may be written to, returns false if the ring was stopped
+    bool AcquireBlock(std::size_t index) {
+        std::unique_lock lock{mutex};
+        Wait(lock, producer_stall_ns, [&] { return stopped || index - released < NUM_BLOCKS; });
+        return !stopped;
+    }
+
+    void FillBlock(std::size_t index, std::size_t size) {
+        {
+            std::scoped_lock lock{mutex};
+            sizes[Slot(index)] = size;
+            filled[Slot(index)] = index + 1;
+        }
+        cv.notify_all();
+    }
+
+    // Waits until the block has been filled, returns false if it never will be
+    bool WaitForBlock(std::size_t index, std::size_t& size) {
+        std::unique_lock lock{mutex};
+        const auto slot = Slot(index);
+        Wait(lock, consumer_stall_ns,
+             [&] { return stopped || index >= num_blocks || filled[slot] == index + 1; });
+        if (stopped || filled[slot] != index + 1) {
+            return false;
+        }
+
+        size = sizes[slot];
+        return true;
+    }
+
+    void ReleaseBlock(std::size_t index) {
+        {
+            std::scoped_lock lock{mutex};
+            released = index + 1;
+        }
+        cv.notify_all();
+        if (on_release) {
+            on_release(index);
+        }
+    }
+
+    void SetNumBlocks(std::size_t count) {
+        {
+            std::scoped_lock lock{mutex};
+            num_blocks = count;
+        }
+        cv.notify_all();
+    }
+
+    void Stop() {
+        {
+            std::scoped_lock lock{mutex};
+            stopped = true;
+        }
+        cv.notify_all();
+    }
+
+    template <typename Pred>
+    void Wait(std::unique_lock<std::mutex>& lock, u64& stall_ns, Pred&& pred) {
+        if (pred()) {
+            return;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        cv.wait(lock, pred);
+        stall_ns += NanosecondsSince(start);
+    }
+
+    u8* pool;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::array<std::size_t, NUM_BLOCKS> sizes{};
+    // index + 1 of the block last filled in each slot
+    std::array<std::size_t, NUM_BLOCKS> filled{};
+    std::size_t released{0};
+    std::size_t num_blocks{std::numeric_limits<std::size_t>::max()};
+    bool stopped{false};
+    u64 producer_stall_ns{0};
+    u64 consumer_stall_ns{0};
+    std::function<void(std::size_t)> on_release;
+};
+
 class SaveBuf : public std::streambuf {
 public:
-    std::atomic_size_t buffer_pos{0};
+    using SubmitBlock = std::function<void(std::size_t index, std::size_t size)>;
 
-    explicit SaveBuf(std::shared_ptr<u8[]> buffer_) : buffer(std::move(buffer_)) {}
+    SaveBuf(BlockRing& ring_, SubmitBlock submit_block_)
+        : ring(ring_), submit_block(std::move(submit_block_)) {}
+
+    // Submits the last partial block, returns the total number of blocks
+    std::size_t Flush() {
+        if (block_pos != 0) {
+            Submit();
+        }
+        return block_index;
+    }
 
 protected:
     std::streamsize xsputn(const char_type* s, std::streamsize count) override {
-        const auto pos = buffer_pos.load(std::memory_order_relaxed);
-        std::memcpy(&buffer[pos], s, count);
-        buffer_pos.store(pos + count, std::memory_order_relaxed);
+        std::size_t written = 0;
+        while (written < static_cast<std::size_t>(count)) {
+            if (block_pos == BLOCK_SIZE) [[unlikely]] {
+                Submit();
+                ring.AcquireBlock(block_index);
+            }
+
+            const auto n = std::min(BLOCK_SIZE - block_pos, count - written);
+            std::memcpy(ring.Block(block_index) + block_pos, s + written, n);
+            block_pos += n;
+            written += n;
+        }
         return count;
     }
 
 private:
-    std::shared_ptr<u8[]> buffer;
+    void Submit() {
+        submit_block(block_index++, block_pos);
+        block_pos = 0;
+    }
+
+    BlockRing& ring;
+    SubmitBlock submit_block;
+    std::size_t block_index{0};
+    std::size_t block_pos{0};
 };
 
 class LoadBuf : public std::streambuf {
 public:
-    std::atomic_size_t buffer_filled{0};
-    std::atomic_bool buffer_full{false};
-
-    explicit LoadBuf(std::shared_ptr<u8[]> buffer_) : buffer(std::move(buffer_)) {}
+    explicit LoadBuf(BlockRing& ring_) : ring(ring_) {}
 
 protected:
     std::streamsize xsgetn(char_type* s, std::streamsize count) override {
-        while (!buffer_full.load(std::memory_order_relaxed)) [[unlikely]] {
-            const auto filled = buffer_filled.load(std::memory_order_relaxed);
-            const auto buffer_avail = filled - buffer_pos;
-            if (buffer_avail >= static_cast<std::size_t>(count)) {
-                std::memcpy(s, &buffer[buffer_pos], count);
-                buffer_pos += count;
-                return count;
+        std::size_t read = 0;
+        while (read < static_cast<std::size_t>(count)) {
+            if (block_pos == block_size) [[unlikely]] {
+                if (has_block) {
+                    ring.ReleaseBlock(block_index++);
+                    has_block = false;
+                }
+
+                if (!ring.WaitForBlock(block_index, block_size)) {
+                    break;
+                }
+
+                has_block = true;
+                block_pos = 0;
+                continue;
             }
-        }
 
-        const std::streamsize buffer_avail =
-            buffer_filled.load(std::memory_order_relaxed) - buffer_pos;
-        count = std::min(buffer_avail, count);
-        std::memcpy(s, &buffer[buffer_pos], count);
-        buffer_pos += count;
-        return count;
+            const auto n = std::min(block_size - block_pos, count - read);
+            std::memcpy(s + read, ring.Block(block_index) + block_pos, n);
+            block_pos += n;
+            read += n;
+        }
+        return static_cast<std::streamsize>(read);
     }
 
 private:
-    std::shared_ptr<u8[]> buffer;
-    std::size_t buffer_pos{0};
+    BlockRing& ring;
+    std::size_t block_index{0};
+    std::size_t block_pos{0};
+    std::size_t block_size{0};
+    bool has_block{false};
 };
 
 } // namespace Headless
 
 using namespace Headless;
 
-constexpr auto ONE_MiB = 0x100000u;
-constexpr auto FOUR_MiB = ONE_MiB * 4;
-// (uncompressed) states should never be more than 512 MiB
-constexpr auto MAX_UNCOMPRESSED_STATE_SIZE = ONE_MiB * 512;
-// (compressed) states are usually a bit less than 32MiB, but never can be sure...
-constexpr auto STARTING_COMPRESSED_STATE_SIZE = ONE_MiB * 32;
-
-Savestate_MT::Savestate_MT(Core::System& system_) : system(system_) {
-    state_buffer = std::shared_ptr<u8[]>(new u8[MAX_UNCOMPRESSED_STATE_SIZE]);
-    cur_state.reserve(STARTING_COMPRESSED_STATE_SIZE);
-    cstream = ZSTD_createCStream();
-    dstream = ZSTD_createDStream();
+static std::size_t NumWorkers() {
+    return std::clamp<std::size_t>(std::thread::hardware_concurrency() / 2, 1, NUM_BLOCKS);
 }
 
-Savestate_MT::~Savestate_MT() {
-    ZSTD_freeCStream(cstream);
-    ZSTD_freeDStream(dstream);
+Savestate_MT::Savestate_MT(Core::System& system_)
+    : system(system_), workers(NumWorkers(), "Savestate Worker",
+                               [](std::size_t) { return WorkerState{}; }) {
+    block_pool = std::make_unique<u8[]>(BLOCK_SIZE * NUM_BLOCKS);
+    compressed_blocks.resize(NUM_BLOCKS);
 }
 
+Savestate_MT::~Savestate_MT() = default;
+
 std::size_t Savestate_MT::StartSaveState() {
-    SaveBuf save_buf(state_buffer);
-    std::atomic_bool state_done{false};
+    if (!system.IsPoweredOn()) {
+        // an empty state, which fails to load
+        cur_state.clear();
+        return 0;
+    }
 
-    std::thread compression_thread([&]() {
-        ZSTD_initCStream(cstream, ZSTD_fast);
-        ZSTD_CCtx_setParameter(cstream, ZSTD_c_nbWorkers, std::thread::hardware_concurrency() / 2);
+    const auto start = std::chrono::steady_clock::now();
+    std::atomic<u64> compress_ns{0};
+    BlockRing ring(block_pool.get());
 
-        ZSTD_inBuffer in_buf = {
-            .src = state_buffer.get(),
-            .size = 0,
-            .pos = 0,
-        };
+    // the previous state's allocation is reused, only growing if needed
+    cur_state.clear();
+    cur_state.reserve(FOUR_MiB);
 
-        cur_state.resize(STARTING_COMPRESSED_STATE_SIZE);
-        ZSTD_outBuffer out_buf = {
-            .dst = cur_state.data(),
-            .size = STARTING_COMPRESSED_STATE_SIZE,
-            .pos = 0,
-        };
+    SaveBuf save_buf(ring, [&](std::size_t index, std::size_t size) {
+        workers.QueueWork([&, index, size](WorkerState* state) {
+            const auto compress_start = std::chrono::steady_clock::now();
+            if (state->scratch.empty()) {
+                state->scratch.resize(ZSTD_compressBound(BLOCK_SIZE));
+            }
 
-        while (!state_done.load(std::memory_order_relaxed)) {
-            const auto pos = save_buf.buffer_pos.load(std::memory_order_relaxed);
-            if (in_buf.pos < pos) {
-                in_buf.size = pos;
-                ZSTD_compressStream2(cstream, &out_buf, &in_buf, ZSTD_e_continue);
-                if (out_buf.pos == out_buf.size) {
-                    out_buf.size += FOUR_MiB;
-                    cur_state.resize(out_buf.size);
-                    out_buf.dst = cur_state.data();
+            const auto compressed_size =
+                ZSTD_compressCCtx(state->cctx.get(), state->scratch.data(), state->scratch.size(),
+                                  ring.Block(index), size, COMPRESSION_LEVEL);
+            ASSERT(!ZSTD_isError(compressed_size));
+            compressed_blocks[BlockRing::Slot(index)].assign(
+                state->scratch.begin(), state->scratch.begin() + compressed_size);
+            compress_ns.fetch_add(NanosecondsSince(compress_start), std::memory_order_relaxed);
+
+            {
+                // frames are appended in order by whichever worker completes the next one
+                std::scoped_lock lock{ring.mutex};
+                ring.filled[BlockRing::Slot(index)] = index + 1;
+                while (ring.filled[BlockRing::Slot(ring.released)] == ring.released + 1) {
+                    const auto& frame = compressed_blocks[BlockRing::Slot(ring.released)];
+                    cur_state.insert(cur_state.end(), frame.begin(), frame.end());
+                    ring.released++;
                 }
             }
-        }
-
-        in_buf.size = save_buf.buffer_pos.load(std::memory_order_relaxed);
-        while (ZSTD_compressStream2(cstream, &out_buf, &in_buf, ZSTD_e_end) != 0) {
-            out_buf.size += FOUR_MiB;
-            cur_state.resize(out_buf.size);
-            out_buf.dst = cur_state.data();
-        }
-
-        cur_state.resize(out_buf.pos);
+            ring.cv.notify_all();
+        });
     });
 
-    oarchive oa{save_buf, boost::archive::archive_flags::no_header |
-                              boost::archive::archive_flags::no_codecvt};
-    oa & system;
+    try {
+        oarchive oa{save_buf, boost::archive::archive_flags::no_header |
+                                  boost::archive::archive_flags::no_codecvt};
+        oa & system;
+    } catch (...) {
+        workers.WaitForRequests();
+        throw;
+    }
 
-    state_done.store(true, std::memory_order_relaxed);
-    compression_thread.join();
+    const auto num_blocks = save_buf.Flush();
+    stage_times.serialize_ns = NanosecondsSince(start);
+    {
+        std::unique_lock lock{ring.mutex};
+        ring.Wait(lock, ring.producer_stall_ns, [&] { return ring.released == num_blocks; });
+    }
+
+    stage_times.compress_ns = compress_ns.load(std::memory_order_relaxed);
+    stage_times.save_stall_ns = ring.producer_stall_ns;
     return cur_state.size();
 }
 
@@ -139,44 +296,109 @@ void Savestate_MT::FinishSaveState(void* dest_buffer) {
 }
 
 void Savestate_MT::LoadState(void* src_buffer, std::size_t buffer_len) {
-    LoadBuf load_buf(state_buffer);
+    const auto start = std::chrono::steady_clock::now();
+    const auto src = static_cast<const u8*>(src_buffer);
+    std::atomic<u64> decompress_ns{0};
+    BlockRing ring(block_pool.get());
+    LoadBuf load_buf(ring);
+
+    // states from StartSaveState are made of frames that fit in a block, which can be
+    // decompressed in parallel; anything else (e.g. older states) is decompressed as one stream
+    std::vector<std::pair<std::size_t, std::size_t>> frames;
+    bool independent_frames = true;
+    for (std::size_t pos = 0; pos < buffer_len;) {
+        const auto frame_size = ZSTD_findFrameCompressedSize(src + pos, buffer_len - pos);
+        const auto content_size = ZSTD_getFrameContentSize(src + pos, buffer_len - pos);
+        if (ZSTD_isError(frame_size) || content_size > BLOCK_SIZE) {
+            independent_frames = false;
+            break;
+        }
 
-    ZSTD_initDStream(dstream);
-    ZSTD_outBuffer out_buf = {
-        .dst = state_buffer.get(),
-        .size = MAX_UNCOMPRESSED_STATE_SIZE,
-        .pos = 0,
-    };
+        frames.emplace_back(pos, frame_size);
+        pos += frame_size;
+    }
+
+    const auto decompress_frame = [&](std::size_t index) {
+        workers.QueueWork([&, index](WorkerState* state) {
+            const auto decompress_start = std::chrono::steady_clock::now();
+            const auto [offset, size] = frames[index];
+            const auto result = ZSTD_decompressDCtx(state->dctx.get(), ring.Block(index),
+                                                    BLOCK_SIZE, src + offset, size);
+            decompress_ns.fetch_add(NanosecondsSince(decompress_start),
+                                    std::memory_order_relaxed);
+            if (ZSTD_isError(result)) {
+                ring.Stop();
+                return;
+            }
 
-    ZSTD_inBuffer in_buf = {
-        .src = src_buffer,
-        .size = std::min(ZSTD_DStreamInSize(), buffer_len),
-        .pos = 0,
+            ring.FillBlock(index, result);
+        });
     };
 
-    ZSTD_decompressStream(dstream, &out_buf, &in_buf);
-    load_buf.buffer_filled.store(out_buf.pos, std::memory_order_relaxed);
-    in_buf.size = std::min(in_buf.size + FOUR_MiB, buffer_len);
+    if (independent_frames) {
+        ring.SetNumBlocks(frames.size());
+        ring.on_release = [&](std::size_t index) {
+            if (index + NUM_BLOCKS < frames.size()) {
+                decompress_frame(index + NUM_BLOCKS);
+            }
+        };
 
-    std::thread decompression_thread([&]() {
-        while (in_buf.size != buffer_len) {
-            ZSTD_decompressStream(dstream, &out_buf, &in_buf);
-            load_buf.buffer_filled.store(out_buf.pos, std::memory_order_relaxed);
-            in_buf.size = std::min(in_buf.size + FOUR_MiB, buffer_len);
+        for (std::size_t i = 0; i < std::min(NUM_BLOCKS, frames.size()); i++) {
+            decompress_frame(i);
         }
+    } else {
+        workers.QueueWork([&](WorkerState* state) {
+            const auto decompress_start = std::chrono::steady_clock::now();
+            ZSTD_DCtx_reset(state->dctx.get(), ZSTD_reset_session_only);
+            ZSTD_inBuffer in_buf = {
+                .src = src,
+                .size = buffer_len,
+                .pos = 0,
+            };
+
+            std::size_t block_index = 0;
+            bool finished = false;
+            while (!finished && ring.AcquireBlock(block_index)) {
+                ZSTD_outBuffer out_buf = {
+                    .dst = ring.Block(block_index),
+                    .size = BLOCK_SIZE,
+                    .pos = 0,
+                };
+
+                while (out_buf.pos != out_buf.size) {
+                    const auto ret = ZSTD_decompressStream(state->dctx.get(), &out_buf, &in_buf);
+                    // a partially filled block means all input has been consumed and flushed
+                    if (ZSTD_isError(ret) ||
+                        (in_buf.pos == in_buf.size && out_buf.pos != out_buf.size)) {
+                        finished = true;
+                        break;
+                    }
+                }
 
-        while (in_buf.pos != buffer_len) {
-            ZSTD_decompressStream(dstream, &out_buf, &in_buf);
-            load_buf.buffer_filled.store(out_buf.pos, std::memory_order_relaxed);
-        }
+                ring.FillBlock(block_index++, out_buf.pos);
+            }
 
-        load_buf.buffer_filled.store(out_buf.pos, std::memory_order_relaxed);
-        load_buf.buffer_full.store(true, std::memory_order_relaxed);
-    });
+            ring.SetNumBlocks(block_index);
+            decompress_ns.fetch_add(NanosecondsSince(decompress_start),
+                                    std::memory_order_relaxed);
+        });
+    }
+
+    try {
+        iarchive ia{load_buf, boost::archive::archive_flags::no_header |
+                                  boost::archive::archive_flags::no_codecvt};
+        ia & system;
+    } catch (...) {
+        ring.Stop();
+        workers.WaitForRequests();
+        throw;
+    }
 
-    iarchive ia{load_buf, boost::archive::archive_flags::no_header |
-                              boost::archive::archive_flags::no_codecvt};
-    ia & system;
+    stage_times.deserialize_ns = NanosecondsSince(start);
+    // the stream decompressor might still be waiting to publish an empty trailing block
+    ring.Stop();
+    workers.WaitForRequests();
 
-    decompression_thread.join(); // should be a no-op in practice
+    stage_times.decompress_ns = decompress_ns.load(std::memory_order_relaxed);
+    stage_times.load_stall_ns = ring.consumer_stall_ns;
 }
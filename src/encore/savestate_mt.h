@@ -5,13 +5,26 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <zstd.h>
 
+#include "common/thread_worker.h"
 #include "core/core.h"
 
 namespace Headless {
 
+// Time spent in each stage of the most recent save and load, in nanoseconds.
+// Compression and decompression are summed over all workers.
+struct SavestateStageTimes {
+    u64 serialize_ns;
+    u64 compress_ns;
+    u64 save_stall_ns;
+    u64 deserialize_ns;
+    u64 decompress_ns;
+    u64 load_stall_ns;
+};
+
 class Savestate_MT {
 public:
     explicit Savestate_MT(Core::System& system);
@@ -21,12 +34,26 @@ public:
     void FinishSaveState(void* dest_buffer);
     void LoadState(void* src_buffer, std::size_t buffer_len);
 
+    const SavestateStageTimes& GetStageTimes() const {
+        return stage_times;
+    }
+
 private:
+    struct WorkerState {
+        std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> cctx{ZSTD_createCCtx(),
+                                                                   ZSTD_freeCCtx};
+        std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> dctx{ZSTD_createDCtx(),
+                                                                   ZSTD_freeDCtx};
+        std::vector<u8> scratch;
+    };
+
     Core::System& system;
-    std::shared_ptr<u8[]> state_buffer;
+    std::unique_ptr<u8[]> block_pool;
+    std::vector<std::vector<u8>> compressed_blocks;
     std::vector<u8> cur_state;
-    ZSTD_CStream* cstream;
-    ZSTD_DStream* dstream;
+    SavestateStageTimes stage_times{};
+
+    Common::StatefulThreadWorker<WorkerState> workers;
 };
 
 } // namespace Headless
@@ -0,0 +1,51 @@
+// Copyright 2024 Encore Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <streambuf>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Headless {
+
+// Appends serialized states to a vector, which keeps its capacity across states
+class StateSaveBuf : public std::streambuf {
+public:
+    explicit StateSaveBuf(std::vector<u8>& buffer_) : buffer(buffer_) {}
+
+protected:
+    std::streamsize xsputn(const char_type* s, std::streamsize count) override {
+        const auto pos = buffer.size();
+        buffer.resize(pos + count);
+        std::memcpy(&buffer[pos], s, count);
+        return count;
+    }
+
+private:
+    std::vector<u8>& buffer;
+};
+
+class StateLoadBuf : public std::streambuf {
+public:
+    explicit StateLoadBuf(std::span<const u8> buffer_) : buffer(buffer_) {}
+
+protected:
+    std::streamsize xsgetn(char_type* s, std::streamsize count) override {
+        count = std::min(static_cast<std::streamsize>(buffer.size() - buffer_pos), count);
+        std::memcpy(s, &buffer[buffer_pos], count);
+        buffer_pos += count;
+        return count;
+    }
+
+private:
+    std::span<const u8> buffer;
+    std::size_t buffer_pos{0};
+};
+
+} // namespace Headless
@@ -0,0 +1,86 @@
+// Copyright 2024 Encore Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "common/archives.h"
+#include "common/assert.h"
+#include "common/scope_exit.h"
+#include "core/memory.h"
+#include "video_core/gpu.h"
+
+#include "state_buffers.h"
+#include "state_fork.h"
+
+namespace Headless {
+
+StateFork::StateFork(Core::System& system_) : system(system_) {}
+
+StateFork::~StateFork() = default;
+
+bool StateFork::Fork() {
+    if (!system.IsPoweredOn()) {
+        return false;
+    }
+
+    // Saving writes back the rasterizer surfaces, so this has to happen before forking the RAM
+    state.clear();
+    {
+        auto& memory = system.Memory();
+        memory.SetSerializeRam(false);
+        SCOPE_EXIT({ memory.SetSerializeRam(true); });
+
+        StateSaveBuf save_buf(state);
+        oarchive oa{save_buf, boost::archive::archive_flags::no_header |
+                                  boost::archive::archive_flags::no_codecvt};
+        oa & system;
+    }
+
+    if (!system.Memory().ForkRam()) {
+        state.clear();
+        return false;
+    }
+#ifdef _DEBUG
+    forked_ram.resize(system.Memory().GetRamSize());
+    system.Memory().ReadRam(forked_ram.data());
+#endif
+    return true;
+}
+
+bool StateFork::Restore() {
+    // Reloading the system creates a new memory system, which isn't forked
+    if (state.empty() || !system.IsPoweredOn() || !system.Memory().IsRamForked()) {
+        return false;
+    }
+
+    // Loading reinitializes the kernel and services, which clear the shared memory blocks they
+    // create in the RAM, so the RAM is reverted after the rest of the system
+    StateLoadBuf load_buf(state);
+    iarchive ia{load_buf, boost::archive::archive_flags::no_header |
+                              boost::archive::archive_flags::no_codecvt};
+    ia & system;
+
+    auto& memory = system.Memory();
+    const bool restored = memory.RestoreRamFork();
+    ASSERT(restored);
+    // Nothing the rasterizer cached from the cleared RAM may be used
+    system.GPU().ClearAll(false);
+
+#ifdef _DEBUG
+    std::vector<u8> restored_ram(memory.GetRamSize());
+    memory.ReadRam(restored_ram.data());
+    ASSERT_MSG(restored_ram == forked_ram, "Restored RAM differs from the fork");
+#endif
+    return true;
+}
+
+void StateFork::Drop() {
+    state.clear();
+#ifdef _DEBUG
+    forked_ram = {};
+#endif
+    if (system.IsPoweredOn()) {
+        system.Memory().DropRamFork();
+    }
+}
+
+} // namespace Headless
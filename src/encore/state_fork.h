@@ -0,0 +1,38 @@
+// Copyright 2024 Encore Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <vector>
+
+#include "core/core.h"
+
+namespace Headless {
+
+// An in-memory snapshot which can be returned to any number of times, e.g. to explore several
+// input branches from the same state. The RAM is forked copy-on-write, see MemorySystem::ForkRam,
+// while the rest of the system is kept as an uncompressed state without RAM, so both forking and
+// restoring cost the size of that state plus the RAM pages written in between.
+class StateFork {
+public:
+    explicit StateFork(Core::System& system);
+    ~StateFork();
+
+    // Returns false if the host can't fork the RAM
+    bool Fork();
+    // Returns false if there is no fork, or the emulated system was reloaded since
+    bool Restore();
+    // Ends the fork, which maps the RAM into the fastmem arenas again
+    void Drop();
+
+private:
+    Core::System& system;
+    std::vector<u8> state;
+#ifdef _DEBUG
+    // Copy of the forked RAM, which restoring is checked against
+    std::vector<u8> forked_ram;
+#endif
+};
+
+} // namespace Headless
@@ -13,7 +13,7 @@ public:
     TouchFromButtonDevice() {
         for (const auto& config_entry :
              Settings::values
-                 .touch_from_button_maps[Settings::values.current_input_profile
+                 .touch_from_button_maps[Settings::values().current_input_profile
                                              .touch_from_button_map_index]
                  .buttons) {
 
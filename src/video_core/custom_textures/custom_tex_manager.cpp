@@ -56,7 +56,7 @@ MapType MakeMapType(std::string_view ext) {
 
 CustomTexManager::CustomTexManager(Core::System& system_)
     : system{system_}, image_interface{*system.GetImageInterface()},
-      async_custom_loading{Settings::values.async_custom_loading.GetValue()} {}
+      async_custom_loading{Settings::values().async_custom_loading.GetValue()} {}
 
 CustomTexManager::~CustomTexManager() = default;
 
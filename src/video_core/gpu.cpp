@@ -52,9 +52,7 @@ struct GPU::Impl {
 GPU::GPU(Core::System& system, Frontend::EmuWindow& emu_window,
          Frontend::EmuWindow* secondary_window)
     : impl{std::make_unique<Impl>(system, emu_window, secondary_window)} {
-    impl->vblank_event = impl->timing.RegisterEvent(
-        "GPU::VBlankCallback",
-        [this](uintptr_t user_data, s64 cycles_late) { VBlankCallback(user_data, cycles_late); });
+    RegisterVBlankEvent();
     impl->timing.ScheduleEvent(FRAME_TICKS, impl->vblank_event);
 
     // Bind the rasterizer to the PICA GPU
@@ -63,6 +61,12 @@ GPU::GPU(Core::System& system, Frontend::EmuWindow& emu_window,
 
 GPU::~GPU() = default;
 
+void GPU::RegisterVBlankEvent() {
+    impl->vblank_event = impl->timing.RegisterEvent(
+        "GPU::VBlankCallback",
+        [this](uintptr_t user_data, s64 cycles_late) { VBlankCallback(user_data, cycles_late); });
+}
+
 PAddr GPU::VirtualToPhysicalAddress(VAddr addr) {
     if (addr == 0) {
         return 0;
@@ -431,6 +435,10 @@ void GPU::VBlankCallback(std::uintptr_t user_data, s64 cycles_late) {
 template <class Archive>
 void GPU::serialize(Archive& ar, const u32 file_version) {
     ar & impl->pica;
+    if (Archive::is_loading::value) {
+        // The GPU outlives in-place state loads, which drop all timing callbacks
+        RegisterVBlankEvent();
+    }
 }
 
 SERIALIZE_IMPL(GPU)
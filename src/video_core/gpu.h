@@ -105,6 +105,8 @@ private:
 
     void MemoryTransfer();
 
+    void RegisterVBlankEvent();
+
     void VBlankCallback(uintptr_t user_data, s64 cycles_late);
 
     friend class boost::serialization::access;
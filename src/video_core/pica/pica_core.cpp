@@ -2,6 +2,9 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <cstring>
+#include <thread>
 #include "common/arch.h"
 #include "common/archives.h"
 #include "common/microprofile.h"
@@ -33,7 +36,7 @@ static_assert(sizeof(CommandHeader) == sizeof(u32), "CommandHeader has incorrect
 PicaCore::PicaCore(Memory::MemorySystem& memory_, std::shared_ptr<DebugContext> debug_context_)
     : memory{memory_}, debug_context{std::move(debug_context_)},
       geometry_pipeline{regs.internal, gs_unit, gs_setup},
-      shader_engine{CreateEngine(Settings::values.use_shader_jit.GetValue())} {
+      shader_engine{CreateEngine(Settings::values().use_shader_jit.GetValue())} {
     InitializeRegs();
 
     const auto submit_vertex = [this](const AttributeBuffer& buffer) {
@@ -507,7 +510,7 @@ void PicaCore::DrawArrays(bool is_indexed) {
         // this, so this is left unimplemented for now. Revisit this when an issue is found in
         // games.
 
-        bool accelerate_draw = Settings::values.use_hw_shader && primitive_assembler.IsEmpty();
+        bool accelerate_draw = Settings::values().use_hw_shader && primitive_assembler.IsEmpty();
         const auto topology = primitive_assembler.GetTopology();
         if (topology == PipelineRegs::TriangleTopology::Shader ||
             topology == PipelineRegs::TriangleTopology::List) {
@@ -550,7 +553,6 @@ void PicaCore::LoadVertices(bool is_indexed) {
 
     // Compile the vertex shader for this batch.
     ShaderUnit shader_unit;
-    AttributeBuffer vs_output;
     shader_engine->SetupBatch(vs_setup, regs.internal.vs.main_offset);
 
     // Setup geometry pipeline in case we are using a geometry shader.
@@ -558,56 +560,186 @@ void PicaCore::LoadVertices(bool is_indexed) {
     geometry_pipeline.Setup(shader_engine.get());
     ASSERT(!geometry_pipeline.NeedIndexInput() || is_indexed);
 
-    for (u32 index = 0; index < pipeline.num_vertices; ++index) {
+    const auto get_vertex = [&](u32 index) -> u32 {
         // Indexed rendering doesn't use the start offset
-        const u32 vertex = is_indexed
-                               ? (index_u16 ? index_address_16[index] : index_address_8[index])
-                               : (index + pipeline.vertex_offset);
-
-        bool vertex_cache_hit = false;
-        if (is_indexed) {
-            if (geometry_pipeline.NeedIndexInput()) {
-                geometry_pipeline.SubmitIndex(vertex);
-                continue;
-            }
+        return is_indexed ? (index_u16 ? index_address_16[index] : index_address_8[index])
+                          : (index + pipeline.vertex_offset);
+    };
 
-            for (u32 i = 0; i < VERTEX_CACHE_SIZE; ++i) {
-                if (vertex_cache_valid[i] && vertex == vertex_cache_ids[i]) {
-                    vs_output = vertex_cache[i];
-                    vertex_cache_hit = true;
-                    break;
-                }
-            }
+    if (is_indexed && geometry_pipeline.NeedIndexInput()) {
+        for (u32 index = 0; index < pipeline.num_vertices; ++index) {
+            geometry_pipeline.SubmitIndex(get_vertex(index));
         }
+        return;
+    }
 
-        if (!vertex_cache_hit) {
-            // Initialize data for the current vertex
-            AttributeBuffer input;
-            loader.LoadVertex(base_address, index, vertex, input, input_default_attributes);
-
-            // Record vertex processing to the debugger.
-            if (debug_context) {
-                debug_context->OnEvent(DebugContext::Event::VertexShaderInvocation,
-                                       std::addressof(input));
+    // Vertices are loaded and shaded in batches. The vertex cache is first replayed over the
+    // indices of the batch to find the ones which need shading, so that hits and misses are the
+    // same as when processing the vertices one by one.
+    constexpr u32 VERTEX_BATCH_SIZE = 1024;
+    struct BatchEntry {
+        bool cache_hit;
+        u32 cache_slot;
+        u32 shaded_index;
+    };
+    std::array<BatchEntry, VERTEX_BATCH_SIZE> batch;
+    std::array<u32, VERTEX_BATCH_SIZE> shaded_vertices;
+    vs_input.resize(VERTEX_BATCH_SIZE);
+    vs_output.resize(VERTEX_BATCH_SIZE);
+
+    for (u32 batch_start = 0; batch_start < pipeline.num_vertices;
+         batch_start += VERTEX_BATCH_SIZE) {
+        const u32 batch_size =
+            std::min<u32>(VERTEX_BATCH_SIZE, pipeline.num_vertices - batch_start);
+
+        u32 num_shaded = 0;
+        for (u32 i = 0; i < batch_size; ++i) {
+            const u32 vertex = get_vertex(batch_start + i);
+            auto& entry = batch[i];
+            entry.cache_hit = false;
+            if (is_indexed) {
+                for (u32 slot = 0; slot < VERTEX_CACHE_SIZE; ++slot) {
+                    if (vertex_cache_valid[slot] && vertex == vertex_cache_ids[slot]) {
+                        entry.cache_hit = true;
+                        entry.cache_slot = slot;
+                        break;
+                    }
+                }
+            }
+            if (entry.cache_hit) {
+                continue;
             }
 
-            // Invoke the vertex shader for this vertex.
-            shader_unit.LoadInput(regs.internal.vs, input);
-            shader_engine->Run(vs_setup, shader_unit);
-            shader_unit.WriteOutput(regs.internal.vs, vs_output);
+            entry.shaded_index = num_shaded;
+            shaded_vertices[num_shaded++] = vertex;
 
             // Cache the vertex when doing indexed rendering.
             if (is_indexed) {
-                vertex_cache[vertex_cache_pos] = vs_output;
+                entry.cache_slot = vertex_cache_pos;
                 vertex_cache_valid[vertex_cache_pos] = true;
                 vertex_cache_ids[vertex_cache_pos] = vertex;
                 vertex_cache_pos = (vertex_cache_pos + 1) % VERTEX_CACHE_SIZE;
             }
         }
 
-        // Send to geometry pipeline
-        geometry_pipeline.SubmitVertex(vs_output);
+        ShadeVertices(loader, std::span{shaded_vertices}.first(num_shaded), shader_unit);
+
+        // Send to geometry pipeline in the original order. Cache slots are written and read in
+        // the same order as they were assigned above, so hits always see the right vertex.
+        for (u32 i = 0; i < batch_size; ++i) {
+            const auto& entry = batch[i];
+            if (entry.cache_hit) {
+                geometry_pipeline.SubmitVertex(vertex_cache[entry.cache_slot]);
+                continue;
+            }
+            if (is_indexed) {
+                vertex_cache[entry.cache_slot] = vs_output[entry.shaded_index];
+            }
+            geometry_pipeline.SubmitVertex(vs_output[entry.shaded_index]);
+        }
+    }
+}
+
+void PicaCore::ShadeVertices(const VertexLoader& loader, std::span<const u32> vertices,
+                             ShaderUnit& shader_unit) {
+    // Small groups are shaded on the emulation thread, waking up workers costs more than it saves.
+    // Vertices are still loaded and shaded a few at a time, to keep the buffers in cache.
+    constexpr std::size_t SERIAL_BATCH_SIZE = 16;
+    constexpr std::size_t MIN_VERTICES_PER_RANGE = 128;
+    constexpr std::size_t MAX_VERTEX_RANGES = 16;
+
+    const auto& vs_config = regs.internal.vs;
+    const auto inputs = std::span{vs_input}.first(vertices.size());
+    const auto outputs = std::span{vs_output}.first(vertices.size());
+
+    const std::size_t max_ranges = std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1,
+                                                           MAX_VERTEX_RANGES);
+    const std::size_t num_ranges =
+        std::min(vertices.size() / MIN_VERTICES_PER_RANGE, max_ranges);
+    if (debug_context || num_ranges < 2) {
+        for (std::size_t start = 0; start < vertices.size(); start += SERIAL_BATCH_SIZE) {
+            const std::size_t count = std::min(SERIAL_BATCH_SIZE, vertices.size() - start);
+            const auto batch_inputs = inputs.subspan(start, count);
+            loader.LoadVertices(vertices.subspan(start, count), batch_inputs,
+                                input_default_attributes);
+
+            // Record vertex processing to the debugger.
+            if (debug_context) {
+                for (const auto& input : batch_inputs) {
+                    debug_context->OnEvent(DebugContext::Event::VertexShaderInvocation,
+                                           std::addressof(input));
+                }
+            }
+
+            shader_engine->RunBatch(vs_setup, shader_unit, vs_config, batch_inputs,
+                                    outputs.subspan(start, count));
+        }
+        return;
+    }
+
+    if (!vertex_workers) {
+        vertex_workers =
+            std::make_unique<Common::ThreadWorker>(max_ranges - 1, "Pica vertex workers");
+    }
+
+    // The shader unit keeps its registers from one vertex to the next, and a vertex may read
+    // registers the previous one left behind. Every range but the first starts by shading the
+    // vertex before it, guessing the state the previous range will end with. The guess is checked
+    // once all ranges are done and ranges which started from the wrong state are shaded again, so
+    // the outputs are always the same as when shading the vertices in order.
+    std::array<ShaderUnit, MAX_VERTEX_RANGES> start_units;
+    std::array<ShaderUnit, MAX_VERTEX_RANGES> end_units;
+    const auto range_bounds = [&](std::size_t range) {
+        return std::make_pair(range * vertices.size() / num_ranges,
+                              (range + 1) * vertices.size() / num_ranges);
+    };
+    const auto shade_range = [&](std::size_t range) {
+        const auto [start, end] = range_bounds(range);
+        auto& unit = end_units[range];
+        unit = shader_unit;
+        if (range != 0) {
+            AttributeBuffer input;
+            AttributeBuffer output;
+            loader.LoadVertices(vertices.subspan(start - 1, 1), std::span{&input, 1},
+                                input_default_attributes);
+            shader_engine->RunBatch(vs_setup, unit, vs_config, std::span{&input, 1},
+                                    std::span{&output, 1});
+            start_units[range] = unit;
+        }
+        const auto range_inputs = inputs.subspan(start, end - start);
+        loader.LoadVertices(vertices.subspan(start, end - start), range_inputs,
+                            input_default_attributes);
+        shader_engine->RunBatch(vs_setup, unit, vs_config, range_inputs,
+                                outputs.subspan(start, end - start));
+    };
+
+    for (std::size_t range = 1; range < num_ranges; ++range) {
+        vertex_workers->QueueWork([&shade_range, range] { shade_range(range); });
+    }
+    shade_range(0);
+    vertex_workers->WaitForRequests();
+
+    // Registers are compared bitwise, as f24 comparisons treat zeros of either sign as equal
+    const auto same_state = [](const ShaderUnit& a, const ShaderUnit& b) {
+        return std::memcmp(a.address_registers, b.address_registers,
+                           sizeof(a.address_registers)) == 0 &&
+               std::memcmp(a.conditional_code, b.conditional_code,
+                           sizeof(a.conditional_code)) == 0 &&
+               std::memcmp(a.input.data(), b.input.data(), sizeof(a.input)) == 0 &&
+               std::memcmp(a.temporary.data(), b.temporary.data(), sizeof(a.temporary)) == 0 &&
+               std::memcmp(a.output.data(), b.output.data(), sizeof(a.output)) == 0;
+    };
+    for (std::size_t range = 1; range < num_ranges; ++range) {
+        if (same_state(end_units[range - 1], start_units[range])) {
+            continue;
+        }
+        const auto [start, end] = range_bounds(range);
+        end_units[range] = end_units[range - 1];
+        shader_engine->RunBatch(vs_setup, end_units[range], vs_config,
+                                inputs.subspan(start, end - start),
+                                outputs.subspan(start, end - start));
     }
+    shader_unit = end_units[num_ranges - 1];
 }
 
 template <class Archive>
@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <span>
+#include <vector>
+#include "common/thread_worker.h"
 #include "core/hle/service/gsp/gsp_interrupt.h"
 #include "video_core/pica/geometry_pipeline.h"
 #include "video_core/pica/packed_attribute.h"
@@ -26,6 +29,7 @@ namespace Pica {
 
 class DebugContext;
 class ShaderEngine;
+class VertexLoader;
 
 class PicaCore {
 public:
@@ -51,6 +55,9 @@ private:
 
     void LoadVertices(bool is_indexed);
 
+    void ShadeVertices(const VertexLoader& loader, std::span<const u32> vertices,
+                       ShaderUnit& shader_unit);
+
 public:
     union Regs {
         static constexpr std::size_t NUM_REGS = 0x732;
@@ -280,6 +287,9 @@ private:
     PrimitiveAssembler primitive_assembler;
     CommandList cmd_list;
     std::unique_ptr<ShaderEngine> shader_engine;
+    std::unique_ptr<Common::ThreadWorker> vertex_workers;
+    std::vector<AttributeBuffer> vs_input;
+    std::vector<AttributeBuffer> vs_output;
 };
 
 #define GPU_REG_INDEX(field_name) (offsetof(Pica::PicaCore::Regs, field_name) / sizeof(u32))
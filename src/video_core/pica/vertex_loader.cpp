@@ -57,16 +57,29 @@ VertexLoader::VertexLoader(Memory::MemorySystem& memory_, const PipelineRegs& re
             }
         }
     }
+
+    // Resolve the arrays once, so loading a vertex is only pointer arithmetic
+    const PAddr base_address = attribute_config.GetPhysicalBaseAddress();
+    for (u32 i = 0; i < 12; i++) {
+        if (vertex_attribute_elements[i] != 0) {
+            vertex_attribute_pointers[i] =
+                memory.GetPhysicalPointer(base_address + vertex_attribute_sources[i]);
+        }
+    }
 }
 
 VertexLoader::~VertexLoader() = default;
 
-void VertexLoader::LoadVertex(PAddr base_address, u32 index, u32 vertex, AttributeBuffer& input,
-                              AttributeBuffer& input_default_attributes) const {
+void VertexLoader::LoadVertices(std::span<const u32> vertices, std::span<AttributeBuffer> inputs,
+                                const AttributeBuffer& input_default_attributes) const {
+    ASSERT(inputs.size() >= vertices.size());
+
     for (s32 i = 0; i < num_total_attributes; ++i) {
         // Load the default attribute if we're configured to do so
         if (vertex_attribute_is_default[i]) {
-            input[i] = input_default_attributes[i];
+            for (std::size_t v = 0; v < vertices.size(); ++v) {
+                inputs[v][i] = input_default_attributes[i];
+            }
             continue;
         }
 
@@ -79,29 +92,28 @@ void VertexLoader::LoadVertex(PAddr base_address, u32 index, u32 vertex, Attribu
         }
 
         // Load per-vertex data from the loader arrays
-        const PAddr source_addr =
-            base_address + vertex_attribute_sources[i] + vertex_attribute_strides[i] * vertex;
-
         switch (vertex_attribute_formats[i]) {
         case PipelineRegs::VertexAttributeFormat::BYTE:
-            LoadAttribute<s8>(source_addr, i, input);
+            LoadAttribute<s8>(vertices, i, inputs);
             break;
         case PipelineRegs::VertexAttributeFormat::UBYTE:
-            LoadAttribute<u8>(source_addr, i, input);
+            LoadAttribute<u8>(vertices, i, inputs);
             break;
         case PipelineRegs::VertexAttributeFormat::SHORT:
-            LoadAttribute<s16>(source_addr, i, input);
+            LoadAttribute<s16>(vertices, i, inputs);
             break;
         case PipelineRegs::VertexAttributeFormat::FLOAT:
-            LoadAttribute<f32>(source_addr, i, input);
+            LoadAttribute<f32>(vertices, i, inputs);
             break;
         }
 
         // Default attribute values set if array elements have < 4 components. This
         // is *not* carried over from the default attribute settings even if they're
         // enabled for this attribute.
-        for (u32 comp = vertex_attribute_elements[i]; comp < 4; comp++) {
-            input[i][comp] = comp == 3 ? f24::One() : f24::Zero();
+        for (std::size_t v = 0; v < vertices.size(); ++v) {
+            for (u32 comp = vertex_attribute_elements[i]; comp < 4; comp++) {
+                inputs[v][i][comp] = comp == 3 ? f24::One() : f24::Zero();
+            }
         }
     }
 }
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <span>
 #include "core/memory.h"
 #include "video_core/pica/output_vertex.h"
 #include "video_core/pica/regs_pipeline.h"
@@ -19,14 +20,25 @@ public:
     explicit VertexLoader(Memory::MemorySystem& memory_, const PipelineRegs& regs);
     ~VertexLoader();
 
-    void LoadVertex(PAddr base_address, u32 index, u32 vertex, AttributeBuffer& input,
-                    AttributeBuffer& input_default_attributes) const;
+    /**
+     * Loads the attributes of a batch of vertices.
+     * @param vertices Indices of the vertices to load.
+     * @param inputs Attribute buffers receiving the data, must be as large as `vertices`.
+     * @param input_default_attributes Values of the attributes configured as default.
+     */
+    void LoadVertices(std::span<const u32> vertices, std::span<AttributeBuffer> inputs,
+                      const AttributeBuffer& input_default_attributes) const;
 
     template <typename T>
-    void LoadAttribute(PAddr source_addr, u32 attrib, AttributeBuffer& out) const {
-        const T* data = reinterpret_cast<const T*>(memory.GetPhysicalPointer(source_addr));
-        for (u32 comp = 0; comp < vertex_attribute_elements[attrib]; ++comp) {
-            out[attrib][comp] = f24::FromFloat32(data[comp]);
+    void LoadAttribute(std::span<const u32> vertices, u32 attrib,
+                       std::span<AttributeBuffer> inputs) const {
+        const u8* source = vertex_attribute_pointers[attrib];
+        const u32 stride = vertex_attribute_strides[attrib];
+        for (std::size_t i = 0; i < vertices.size(); ++i) {
+            const T* data = reinterpret_cast<const T*>(source + stride * vertices[i]);
+            for (u32 comp = 0; comp < vertex_attribute_elements[attrib]; ++comp) {
+                inputs[i][attrib][comp] = f24::FromFloat32(data[comp]);
+            }
         }
     }
 
@@ -37,6 +49,7 @@ public:
 private:
     Memory::MemorySystem& memory;
     std::array<u32, 16> vertex_attribute_sources;
+    std::array<const u8*, 16> vertex_attribute_pointers{};
     std::array<u32, 16> vertex_attribute_strides{};
     std::array<PipelineRegs::VertexAttributeFormat, 16> vertex_attribute_formats;
     std::array<u32, 16> vertex_attribute_elements{};
@@ -38,9 +38,9 @@ RasterizerCache<T>::RasterizerCache(Memory::MemorySystem& memory_,
                                     Pica::RegsInternal& regs_, RendererBase& renderer_)
     : memory{memory_}, custom_tex_manager{custom_tex_manager_}, runtime{runtime_}, regs{regs_},
       renderer{renderer_}, resolution_scale_factor{renderer.GetResolutionScaleFactor()},
-      filter{Settings::values.texture_filter.GetValue()},
-      dump_textures{Settings::values.dump_textures.GetValue()},
-      use_custom_textures{Settings::values.custom_textures.GetValue()} {
+      filter{Settings::values().texture_filter.GetValue()},
+      dump_textures{Settings::values().dump_textures.GetValue()},
+      use_custom_textures{Settings::values().custom_textures.GetValue()} {
     using TextureConfig = Pica::TexturingRegs::TextureConfig;
 
     // Create null handles for all cached resources
@@ -89,7 +89,7 @@ void RasterizerCache<T>::TickFrame() {
     custom_tex_manager.TickFrame();
     RunGarbageCollector();
 
-    const auto new_filter = Settings::values.texture_filter.GetValue();
+    const auto new_filter = Settings::values().texture_filter.GetValue();
     if (filter != new_filter) [[unlikely]] {
         filter = new_filter;
         UnregisterAll();
@@ -98,11 +98,11 @@ void RasterizerCache<T>::TickFrame() {
     const u32 scale_factor = renderer.GetResolutionScaleFactor();
     const bool resolution_scale_changed = resolution_scale_factor != scale_factor;
     const bool use_custom_texture_changed =
-        Settings::values.custom_textures.GetValue() != use_custom_textures;
+        Settings::values().custom_textures.GetValue() != use_custom_textures;
 
     if (resolution_scale_changed || use_custom_texture_changed) {
         resolution_scale_factor = scale_factor;
-        use_custom_textures = Settings::values.custom_textures.GetValue();
+        use_custom_textures = Settings::values().custom_textures.GetValue();
         if (use_custom_textures) {
             custom_tex_manager.FindCustomTextures();
         }
@@ -374,7 +374,7 @@ typename T::Sampler& RasterizerCache<T>::GetSampler(
     using TextureFilter = Pica::TexturingRegs::TextureConfig::TextureFilter;
 
     const auto get_filter = [](TextureFilter filter) {
-        switch (Settings::values.texture_sampling.GetValue()) {
+        switch (Settings::values().texture_sampling.GetValue()) {
         case Settings::TextureSampling::GameControlled:
             return filter;
         case Settings::TextureSampling::NearestNeighbor:
@@ -156,7 +156,7 @@ bool BlitHelper::ConvertRGBA4ToRGB5A1(Surface& source, Surface& dest,
 }
 
 bool BlitHelper::Filter(Surface& surface, const VideoCore::TextureBlit& blit) {
-    const auto filter = Settings::values.texture_filter.GetValue();
+    const auto filter = Settings::values().texture_filter.GetValue();
     const bool is_depth =
         surface.type == SurfaceType::Depth || surface.type == SurfaceType::DepthStencil;
     if (filter == Settings::TextureFilter::None || is_depth) {
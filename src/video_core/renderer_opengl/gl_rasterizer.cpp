@@ -443,6 +443,10 @@ bool RasterizerOpenGL::Draw(bool accelerate, bool is_indexed) {
     // Sync the uniform data
     UploadUniforms(accelerate);
 
+    // A fragment shader compiled asynchronously is waited for as late as possible. Draws are never
+    // skipped, they may end up in emulated memory.
+    shader_manager.WaitFragmentShader();
+
     // Draw the vertex batch
     bool succeeded = true;
     if (accelerate) {
@@ -110,7 +110,7 @@ ShaderDiskCache::ShaderDiskCache(bool separable)
 
 std::optional<std::vector<ShaderDiskCacheRaw>> ShaderDiskCache::LoadTransferable() {
     const bool has_title_id = GetProgramID() != 0;
-    if (!Settings::values.use_hw_shader || !Settings::values.use_disk_shader_cache ||
+    if (!Settings::values().use_hw_shader || !Settings::values().use_disk_shader_cache ||
         !has_title_id) {
         return std::nullopt;
     }
@@ -445,7 +445,7 @@ void ShaderDiskCache::SaveDumpToFile(u64 unique_identifier, GLuint program, bool
 }
 
 bool ShaderDiskCache::IsUsable() const {
-    return tried_to_load && Settings::values.use_disk_shader_cache;
+    return tried_to_load && Settings::values().use_disk_shader_cache;
 }
 
 FileUtil::IOFile ShaderDiskCache::AppendTransferableFile() {
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
 #include <mutex>
 #include <set>
 #include <span>
@@ -10,6 +11,7 @@
 #include <unordered_map>
 #include <variant>
 #include "common/settings.h"
+#include "common/thread_worker.h"
 #include "core/frontend/emu_window.h"
 #include "video_core/pica/shader_setup.h"
 #include "video_core/renderer_opengl/gl_driver.h"
@@ -100,6 +102,16 @@ static std::tuple<PicaVSConfig, Pica::ShaderSetup> BuildVSConfigFromRaw(
             setup};
 }
 
+/// Builds shader stages in the background, each worker has its own context shared with the
+/// emulation thread's one
+using ShaderWorker = Common::StatefulThreadWorker<Frontend::GraphicsContext*>;
+
+/// A separable program built by a ShaderWorker, it may only be used once done is set
+struct PendingProgram {
+    OGLProgram program;
+    std::atomic_bool done{false};
+};
+
 /**
  * An object representing a shader program staging. It can be either a shader object or a program
  * object, depending on whether separable program is used.
@@ -125,7 +137,34 @@ public:
         }
     }
 
+    /// Builds the stage on a worker, only supported for separable programs. Until it's built the
+    /// handle is 0.
+    void CreateAsync(std::string source, GLenum type, ShaderWorker& worker) {
+        ASSERT(shader_or_program.index() == 1);
+        pending = std::make_shared<PendingProgram>();
+        worker.QueueWork([pending = pending, source = std::move(source),
+                          type](Frontend::GraphicsContext** context) {
+            const auto scope = (*context)->Acquire();
+            OGLShader shader;
+            shader.Create(source.c_str(), type);
+            pending->program.Create(true, std::array{shader.handle});
+            // The program must be complete before the emulation thread's context uses it
+            glFinish();
+            pending->done = true;
+            pending->done.notify_all();
+        });
+    }
+
+    void WaitBuilt() const {
+        if (pending) {
+            pending->done.wait(false);
+        }
+    }
+
     GLuint GetHandle() const {
+        if (pending) {
+            return pending->done ? pending->program.handle : 0;
+        }
         if (shader_or_program.index() == 0) {
             return std::get<OGLShader>(shader_or_program).handle;
         } else {
@@ -139,6 +178,7 @@ public:
 
 private:
     std::variant<OGLShader, OGLProgram> shader_or_program;
+    std::shared_ptr<PendingProgram> pending;
 };
 
 class TrivialVertexShader {
@@ -159,20 +199,25 @@ private:
 template <typename KeyConfigType, auto CodeGenerator, GLenum ShaderType>
 class ShaderCache {
 public:
-    explicit ShaderCache(bool separable_) : separable{separable_} {}
+    explicit ShaderCache(bool separable_, ShaderWorker* worker_ = nullptr)
+        : separable{separable_}, worker{worker_} {}
     ~ShaderCache() = default;
 
     template <typename... Args>
-    std::tuple<GLuint, std::optional<std::string>> Get(const KeyConfigType& config,
-                                                       Args&&... args) {
+    std::tuple<const OGLShaderStage&, std::optional<std::string>> Get(const KeyConfigType& config,
+                                                                      Args&&... args) {
         auto [iter, new_shader] = shaders.emplace(config, OGLShaderStage{separable});
         OGLShaderStage& cached_shader = iter->second;
         std::optional<std::string> result{};
         if (new_shader) {
             result = CodeGenerator(config, args...);
-            cached_shader.Create(result->c_str(), ShaderType);
+            if (worker) {
+                cached_shader.CreateAsync(*result, ShaderType, *worker);
+            } else {
+                cached_shader.Create(result->c_str(), ShaderType);
+            }
         }
-        return {cached_shader.GetHandle(), std::move(result)};
+        return {cached_shader, std::move(result)};
     }
 
     void Inject(const KeyConfigType& key, OGLProgram&& program) {
@@ -187,6 +232,7 @@ public:
 
 private:
     bool separable;
+    ShaderWorker* worker;
     std::unordered_map<KeyConfigType, OGLShaderStage> shaders;
 };
 
@@ -257,12 +303,41 @@ using FixedGeometryShaders =
 
 using FragmentShaders = ShaderCache<FSConfig, &GLSL::GenerateFragmentShader, GL_FRAGMENT_SHADER>;
 
+using GraphicsContexts = std::vector<std::unique_ptr<Frontend::GraphicsContext>>;
+
+static std::unique_ptr<ShaderWorker> CreateShaderWorker(Frontend::EmuWindow& emu_window,
+                                                        GraphicsContexts& contexts,
+                                                        bool separable) {
+    // Only separable stages can be built on their own, otherwise the emulation thread links them
+    if (!Settings::values().async_shader_compilation.GetValue() || !separable ||
+        emu_window.StrictContextRequired()) {
+        return nullptr;
+    }
+
+    // Every worker needs its own context, so there are fewer of them than for the disk cache
+    const std::size_t num_workers = std::clamp(std::thread::hardware_concurrency() / 2, 1U, 4U);
+    emu_window.SaveContext();
+    for (std::size_t i = 0; i < num_workers; ++i) {
+        // On some platforms the shared context has to be created from the GUI thread
+        contexts.push_back(emu_window.CreateSharedContext());
+        contexts.back()->DoneCurrent();
+    }
+    emu_window.RestoreContext();
+
+    return std::make_unique<ShaderWorker>(num_workers, "GLShaderBuilder",
+                                          [&contexts](std::size_t index) {
+                                              return contexts[index].get();
+                                          });
+}
+
 class ShaderProgramManager::Impl {
 public:
-    explicit Impl(const Driver& driver, bool separable)
-        : separable(separable), programmable_vertex_shaders(separable),
+    explicit Impl(Frontend::EmuWindow& emu_window, const Driver& driver, bool separable)
+        : separable(separable),
+          worker(CreateShaderWorker(emu_window, worker_contexts, separable)),
+          programmable_vertex_shaders(separable),
           trivial_vertex_shader(driver, separable), fixed_geometry_shaders(separable),
-          fragment_shaders(separable), disk_cache(separable) {
+          fragment_shaders(separable, worker.get()), disk_cache(separable) {
         if (separable) {
             pipeline.Create();
         }
@@ -287,6 +362,11 @@ public:
         };
     }
 
+    ~Impl() {
+        // Stop the workers before the stages they build are destroyed
+        worker.reset();
+    }
+
     struct ShaderTuple {
         std::size_t vs_hash = 0;
         std::size_t gs_hash = 0;
@@ -316,6 +396,10 @@ public:
     bool separable;
     Pica::Shader::Profile profile{};
     ShaderTuple current;
+    const OGLShaderStage* current_fs_stage = nullptr;
+
+    GraphicsContexts worker_contexts;
+    std::unique_ptr<ShaderWorker> worker;
 
     ProgrammableVertexShaders programmable_vertex_shaders;
     TrivialVertexShader trivial_vertex_shader;
@@ -332,7 +416,7 @@ ShaderProgramManager::ShaderProgramManager(Frontend::EmuWindow& emu_window_, con
                                            bool separable)
     : emu_window{emu_window_}, driver{driver_},
       strict_context_required{emu_window.StrictContextRequired()},
-      impl{std::make_unique<Impl>(driver_, separable)} {}
+      impl{std::make_unique<Impl>(emu_window_, driver_, separable)} {}
 
 ShaderProgramManager::~ShaderProgramManager() = default;
 
@@ -358,7 +442,7 @@ bool ShaderProgramManager::UseProgrammableVertexShader(const Pica::RegsInternal&
         const u64 unique_identifier = GetUniqueIdentifier(regs, program_code);
         const ShaderDiskCacheRaw raw{unique_identifier, ProgramType::VS, regs,
                                      std::move(program_code)};
-        const bool sanitize_mul = Settings::values.shaders_accurate_mul.GetValue();
+        const bool sanitize_mul = Settings::values().shaders_accurate_mul.GetValue();
         disk_cache.SaveRaw(raw);
         disk_cache.SaveDecompiled(unique_identifier, *result, sanitize_mul);
     }
@@ -372,8 +456,8 @@ void ShaderProgramManager::UseTrivialVertexShader() {
 
 void ShaderProgramManager::UseFixedGeometryShader(const Pica::RegsInternal& regs) {
     PicaFixedGSConfig gs_config(regs, driver.HasClipCullDistance());
-    auto [handle, _] = impl->fixed_geometry_shaders.Get(gs_config, impl->separable);
-    impl->current.gs = handle;
+    const auto& [stage, _] = impl->fixed_geometry_shaders.Get(gs_config, impl->separable);
+    impl->current.gs = stage.GetHandle();
     impl->current.gs_hash = gs_config.Hash();
 }
 
@@ -385,8 +469,9 @@ void ShaderProgramManager::UseTrivialGeometryShader() {
 void ShaderProgramManager::UseFragmentShader(const Pica::RegsInternal& regs,
                                              const Pica::Shader::UserConfig& user) {
     const FSConfig fs_config{regs, user, impl->profile};
-    auto [handle, result] = impl->fragment_shaders.Get(fs_config, impl->profile);
-    impl->current.fs = handle;
+    const auto& [stage, result] = impl->fragment_shaders.Get(fs_config, impl->profile);
+    impl->current_fs_stage = &stage;
+    impl->current.fs = stage.GetHandle();
     impl->current.fs_hash = fs_config.Hash();
     // Save FS to the disk cache if its a new shader
     if (result) {
@@ -398,6 +483,15 @@ void ShaderProgramManager::UseFragmentShader(const Pica::RegsInternal& regs,
     }
 }
 
+void ShaderProgramManager::WaitFragmentShader() {
+    const OGLShaderStage* stage = impl->current_fs_stage;
+    if (stage == nullptr) {
+        return;
+    }
+    stage->WaitBuilt();
+    impl->current.fs = stage->GetHandle();
+}
+
 void ShaderProgramManager::ApplyTo(OpenGLState& state) {
     if (impl->separable) {
         if (driver.HasBug(DriverBug::ShaderStageChangeFreeze)) {
@@ -418,7 +512,7 @@ void ShaderProgramManager::ApplyTo(OpenGLState& state) {
             cached_program.Create(false,
                                   std::array{impl->current.vs, impl->current.gs, impl->current.fs});
             auto& disk_cache = impl->disk_cache;
-            const bool sanitize_mul = Settings::values.shaders_accurate_mul.GetValue();
+            const bool sanitize_mul = Settings::values().shaders_accurate_mul.GetValue();
             disk_cache.SaveDumpToFile(unique_identifier, cached_program.handle, sanitize_mul);
         }
         state.draw.shader_program = cached_program.handle;
@@ -484,7 +578,7 @@ void ShaderProgramManager::LoadDiskCache(const std::atomic_bool& stop_loading,
 
             if (dump != dump_map.end() && decomp != decompiled_map.end()) {
                 // Only load the vertex shader if its sanitize_mul setting matches
-                const bool sanitize_mul = Settings::values.shaders_accurate_mul.GetValue();
+                const bool sanitize_mul = Settings::values().shaders_accurate_mul.GetValue();
                 if (raw.GetProgramType() == ProgramType::VS &&
                     decomp->second.sanitize_mul != sanitize_mul) {
                     continue;
@@ -541,7 +635,7 @@ void ShaderProgramManager::LoadDiskCache(const std::atomic_bool& stop_loading,
             const auto decomp{decompiled_map.find(unique_identifier)};
 
             // Only load the program if its sanitize_mul setting matches
-            const bool sanitize_mul = Settings::values.shaders_accurate_mul.GetValue();
+            const bool sanitize_mul = Settings::values().shaders_accurate_mul.GetValue();
             if (decomp->second.sanitize_mul != sanitize_mul) {
                 continue;
             }
@@ -592,8 +686,11 @@ void ShaderProgramManager::LoadDiskCache(const std::atomic_bool& stop_loading,
     compilation_failed = false;
 
     std::size_t built_shaders = 0; // It doesn't have be atomic since it's used behind a mutex
+    Settings::Values& settings = Settings::values();
     const auto LoadRawSepareble = [&](std::size_t begin, std::size_t end,
                                       Frontend::GraphicsContext* context = nullptr) {
+        // Shader configs read the settings of the emulator instance, which may be on another thread
+        const Settings::ScopedValues settings_scope{settings};
         const auto scope = context->Acquire();
         for (std::size_t i = begin; i < end; ++i) {
             if (stop_loading || compilation_failed) {
@@ -50,6 +50,10 @@ public:
 
     void UseFragmentShader(const Pica::RegsInternal& config, const Pica::Shader::UserConfig& user);
 
+    /// Waits until the fragment shader is built, with async shader compilation it may still be
+    /// compiling.
+    void WaitFragmentShader();
+
     void ApplyTo(OpenGLState& state);
 
 private:
@@ -677,7 +677,7 @@ Sampler::~Sampler() = default;
 
 DebugScope::DebugScope(TextureRuntime& runtime, Common::Vec4f, std::string_view label)
     : local_scope_depth{global_scope_depth++} {
-    if (!Settings::values.renderer_debug) {
+    if (!Settings::values().renderer_debug) {
         return;
     }
     glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, local_scope_depth,
@@ -685,7 +685,7 @@ DebugScope::DebugScope(TextureRuntime& runtime, Common::Vec4f, std::string_view
 }
 
 DebugScope::~DebugScope() {
-    if (!Settings::values.renderer_debug) {
+    if (!Settings::values().renderer_debug) {
         return;
     }
     glPopDebugGroup();
@@ -100,7 +100,7 @@ void RendererOpenGL::SwapBuffers() {
     const auto& main_layout = render_window.GetFramebufferLayout();
     RenderToMailbox(main_layout, render_window.mailbox, false);
 
-    if (Settings::values.layout_option.GetValue() == Settings::LayoutOption::SeparateWindows) {
+    if (Settings::values().layout_option.GetValue() == Settings::LayoutOption::SeparateWindows) {
         ASSERT(secondary_window);
         const auto& secondary_layout = secondary_window->GetFramebufferLayout();
         RenderToMailbox(secondary_layout, secondary_window->mailbox, false);
@@ -306,8 +306,8 @@ void RendererOpenGL::FillScreen(Common::Vec3<u8> color, TextureInfo& texture) {
  * Initializes the OpenGL state and creates persistent objects.
  */
 void RendererOpenGL::InitOpenGLObjects() {
-    glClearColor(Settings::values.bg_red.GetValue(), Settings::values.bg_green.GetValue(),
-                 Settings::values.bg_blue.GetValue(), 0.0f);
+    glClearColor(Settings::values().bg_red.GetValue(), Settings::values().bg_green.GetValue(),
+                 Settings::values().bg_blue.GetValue(), 0.0f);
 
     for (std::size_t i = 0; i < samplers.size(); i++) {
         samplers[i].Create();
@@ -368,12 +368,12 @@ void RendererOpenGL::InitOpenGLObjects() {
 void RendererOpenGL::ReloadShader() {
     // Link shaders and get variable locations
     std::string shader_data = fragment_shader_precision_OES;
-    if (Settings::values.render_3d.GetValue() == Settings::StereoRenderOption::Anaglyph) {
-        if (Settings::values.anaglyph_shader_name.GetValue() == "dubois (builtin)") {
+    if (Settings::values().render_3d.GetValue() == Settings::StereoRenderOption::Anaglyph) {
+        if (Settings::values().anaglyph_shader_name.GetValue() == "dubois (builtin)") {
             shader_data += HostShaders::OPENGL_PRESENT_ANAGLYPH_FRAG;
         } else {
             std::string shader_text = OpenGL::GetPostProcessingShaderCode(
-                true, Settings::values.anaglyph_shader_name.GetValue());
+                true, Settings::values().anaglyph_shader_name.GetValue());
             if (shader_text.empty()) {
                 // Should probably provide some information that the shader couldn't load
                 shader_data += HostShaders::OPENGL_PRESENT_ANAGLYPH_FRAG;
@@ -381,16 +381,17 @@ void RendererOpenGL::ReloadShader() {
                 shader_data += shader_text;
             }
         }
-    } else if (Settings::values.render_3d.GetValue() == Settings::StereoRenderOption::Interlaced ||
-               Settings::values.render_3d.GetValue() ==
+    } else if (Settings::values().render_3d.GetValue() ==
+                   Settings::StereoRenderOption::Interlaced ||
+               Settings::values().render_3d.GetValue() ==
                    Settings::StereoRenderOption::ReverseInterlaced) {
         shader_data += HostShaders::OPENGL_PRESENT_INTERLACED_FRAG;
     } else {
-        if (Settings::values.pp_shader_name.GetValue() == "none (builtin)") {
+        if (Settings::values().pp_shader_name.GetValue() == "none (builtin)") {
             shader_data += HostShaders::OPENGL_PRESENT_FRAG;
         } else {
             std::string shader_text = OpenGL::GetPostProcessingShaderCode(
-                false, Settings::values.pp_shader_name.GetValue());
+                false, Settings::values().pp_shader_name.GetValue());
             if (shader_text.empty()) {
                 // Should probably provide some information that the shader couldn't load
                 shader_data += HostShaders::OPENGL_PRESENT_FRAG;
@@ -404,16 +405,18 @@ void RendererOpenGL::ReloadShader() {
     state.Apply();
     uniform_modelview_matrix = glGetUniformLocation(shader.handle, "modelview_matrix");
     uniform_color_texture = glGetUniformLocation(shader.handle, "color_texture");
-    if (Settings::values.render_3d.GetValue() == Settings::StereoRenderOption::Anaglyph ||
-        Settings::values.render_3d.GetValue() == Settings::StereoRenderOption::Interlaced ||
-        Settings::values.render_3d.GetValue() == Settings::StereoRenderOption::ReverseInterlaced) {
+    if (Settings::values().render_3d.GetValue() == Settings::StereoRenderOption::Anaglyph ||
+        Settings::values().render_3d.GetValue() == Settings::StereoRenderOption::Interlaced ||
+        Settings::values().render_3d.GetValue() ==
+            Settings::StereoRenderOption::ReverseInterlaced) {
         uniform_color_texture_r = glGetUniformLocation(shader.handle, "color_texture_r");
     }
-    if (Settings::values.render_3d.GetValue() == Settings::StereoRenderOption::Interlaced ||
-        Settings::values.render_3d.GetValue() == Settings::StereoRenderOption::ReverseInterlaced) {
+    if (Settings::values().render_3d.GetValue() == Settings::StereoRenderOption::Interlaced ||
+        Settings::values().render_3d.GetValue() ==
+            Settings::StereoRenderOption::ReverseInterlaced) {
         GLuint uniform_reverse_interlaced =
             glGetUniformLocation(shader.handle, "reverse_interlaced");
-        if (Settings::values.render_3d.GetValue() ==
+        if (Settings::values().render_3d.GetValue() ==
             Settings::StereoRenderOption::ReverseInterlaced)
             glUniform1i(uniform_reverse_interlaced, 1);
         else
@@ -537,7 +540,7 @@ void RendererOpenGL::DrawSingleScreen(const ScreenInfo& screen_info, float x, fl
     }
 
     const u32 scale_factor = GetResolutionScaleFactor();
-    const GLuint sampler = samplers[Settings::values.filter_mode.GetValue()].handle;
+    const GLuint sampler = samplers[Settings::values().filter_mode.GetValue()].handle;
     glUniform4f(uniform_i_resolution, static_cast<float>(screen_info.texture.width * scale_factor),
                 static_cast<float>(screen_info.texture.height * scale_factor),
                 1.0f / static_cast<float>(screen_info.texture.width * scale_factor),
@@ -607,7 +610,7 @@ void RendererOpenGL::DrawSingleScreenStereo(const ScreenInfo& screen_info_l,
     }
 
     const u32 scale_factor = GetResolutionScaleFactor();
-    const GLuint sampler = samplers[Settings::values.filter_mode.GetValue()].handle;
+    const GLuint sampler = samplers[Settings::values().filter_mode.GetValue()].handle;
     glUniform4f(uniform_i_resolution,
                 static_cast<float>(screen_info_l.texture.width * scale_factor),
                 static_cast<float>(screen_info_l.texture.height * scale_factor),
@@ -636,8 +639,8 @@ void RendererOpenGL::DrawSingleScreenStereo(const ScreenInfo& screen_info_l,
 void RendererOpenGL::DrawScreens(const Layout::FramebufferLayout& layout, bool flipped) {
     if (settings.bg_color_update_requested.exchange(false)) {
         // Update background color before drawing
-        glClearColor(Settings::values.bg_red.GetValue(), Settings::values.bg_green.GetValue(),
-                     Settings::values.bg_blue.GetValue(), 0.0f);
+        glClearColor(Settings::values().bg_red.GetValue(), Settings::values().bg_green.GetValue(),
+                     Settings::values().bg_blue.GetValue(), 0.0f);
     }
 
     if (settings.shader_update_requested.exchange(false)) {
@@ -662,9 +665,9 @@ void RendererOpenGL::DrawScreens(const Layout::FramebufferLayout& layout, bool f
     glUniform1i(uniform_color_texture, 0);
 
     const bool stereo_single_screen =
-        Settings::values.render_3d.GetValue() == Settings::StereoRenderOption::Anaglyph ||
-        Settings::values.render_3d.GetValue() == Settings::StereoRenderOption::Interlaced ||
-        Settings::values.render_3d.GetValue() == Settings::StereoRenderOption::ReverseInterlaced;
+        Settings::values().render_3d.GetValue() == Settings::StereoRenderOption::Anaglyph ||
+        Settings::values().render_3d.GetValue() == Settings::StereoRenderOption::Interlaced ||
+        Settings::values().render_3d.GetValue() == Settings::StereoRenderOption::ReverseInterlaced;
 
     // Bind a second texture for the right eye if in Anaglyph mode
     if (stereo_single_screen) {
@@ -672,7 +675,7 @@ void RendererOpenGL::DrawScreens(const Layout::FramebufferLayout& layout, bool f
     }
 
     glUniform1i(uniform_layer, 0);
-    if (!Settings::values.swap_screen.GetValue()) {
+    if (!Settings::values().swap_screen.GetValue()) {
         DrawTopScreen(layout, top_screen);
         glUniform1i(uniform_layer, 0);
         ApplySecondLayerOpacity();
@@ -686,7 +689,7 @@ void RendererOpenGL::DrawScreens(const Layout::FramebufferLayout& layout, bool f
 
     if (layout.additional_screen_enabled) {
         const auto& additional_screen = layout.additional_screen;
-        if (!Settings::values.swap_screen.GetValue()) {
+        if (!Settings::values().swap_screen.GetValue()) {
             DrawTopScreen(layout, additional_screen);
         } else {
             DrawBottomScreen(layout, additional_screen);
@@ -696,19 +699,20 @@ void RendererOpenGL::DrawScreens(const Layout::FramebufferLayout& layout, bool f
 }
 
 void RendererOpenGL::ApplySecondLayerOpacity() {
-    if (Settings::values.custom_layout &&
-        Settings::values.custom_second_layer_opacity.GetValue() < 100) {
+    if (Settings::values().custom_layout &&
+        Settings::values().custom_second_layer_opacity.GetValue() < 100) {
         state.blend.src_rgb_func = GL_CONSTANT_ALPHA;
         state.blend.src_a_func = GL_CONSTANT_ALPHA;
         state.blend.dst_a_func = GL_ONE_MINUS_CONSTANT_ALPHA;
         state.blend.dst_rgb_func = GL_ONE_MINUS_CONSTANT_ALPHA;
-        state.blend.color.alpha = Settings::values.custom_second_layer_opacity.GetValue() / 100.0f;
+        state.blend.color.alpha =
+            Settings::values().custom_second_layer_opacity.GetValue() / 100.0f;
     }
 }
 
 void RendererOpenGL::ResetSecondLayerOpacity() {
-    if (Settings::values.custom_layout &&
-        Settings::values.custom_second_layer_opacity.GetValue() < 100) {
+    if (Settings::values().custom_layout &&
+        Settings::values().custom_second_layer_opacity.GetValue() < 100) {
         state.blend.src_rgb_func = GL_ONE;
         state.blend.dst_rgb_func = GL_ZERO;
         state.blend.src_a_func = GL_ONE;
@@ -730,9 +734,9 @@ void RendererOpenGL::DrawTopScreen(const Layout::FramebufferLayout& layout,
 
     const auto orientation = layout.is_rotated ? Layout::DisplayOrientation::Landscape
                                                : Layout::DisplayOrientation::Portrait;
-    switch (Settings::values.render_3d.GetValue()) {
+    switch (Settings::values().render_3d.GetValue()) {
     case Settings::StereoRenderOption::Off: {
-        const int eye = static_cast<int>(Settings::values.mono_render_option.GetValue());
+        const int eye = static_cast<int>(Settings::values().mono_render_option.GetValue());
         DrawSingleScreen(screen_infos[eye], top_screen_left, top_screen_top, top_screen_width,
                          top_screen_height, orientation);
         break;
@@ -780,7 +784,7 @@ void RendererOpenGL::DrawBottomScreen(const Layout::FramebufferLayout& layout,
     const auto orientation = layout.is_rotated ? Layout::DisplayOrientation::Landscape
                                                : Layout::DisplayOrientation::Portrait;
 
-    switch (Settings::values.render_3d.GetValue()) {
+    switch (Settings::values().render_3d.GetValue()) {
     case Settings::StereoRenderOption::Off: {
         DrawSingleScreen(screen_infos[2], bottom_screen_left, bottom_screen_top,
                          bottom_screen_width, bottom_screen_height, orientation);
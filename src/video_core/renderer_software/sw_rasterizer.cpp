@@ -2,7 +2,11 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
 #include <boost/container/static_vector.hpp>
+#include "common/hash.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
 #include "common/quaternion.h"
@@ -14,6 +18,7 @@
 #include "video_core/renderer_software/sw_lighting.h"
 #include "video_core/renderer_software/sw_proctex.h"
 #include "video_core/renderer_software/sw_rasterizer.h"
+#include "video_core/renderer_software/sw_simd.h"
 #include "video_core/renderer_software/sw_texturing.h"
 #include "video_core/texture/texture_decode.h"
 
@@ -100,10 +105,42 @@ private:
 
 } // Anonymous namespace
 
+/// Screen tiles are TILE_SIZE x TILE_SIZE pixels, in 12.4 fixed point this is TILE_SIZE << 4.
+constexpr u32 TILE_SIZE = 32;
+constexpr u32 TILE_SIZE_FIX = TILE_SIZE << 4;
+
+/// A triangle which has been set up for rasterization, but not yet drawn.
+struct RasterizerSoftware::Triangle {
+    Vertex v0;
+    Vertex v1;
+    Vertex v2;
+    std::array<Common::Vec3<Fix12P4>, 3> vtxpos;
+    std::array<int, 3> bias;
+    u16 min_x;
+    u16 min_y;
+    u16 max_x;
+    u16 max_y;
+};
+
 RasterizerSoftware::RasterizerSoftware(Memory::MemorySystem& memory_, Pica::PicaCore& pica_)
     : memory{memory_}, pica{pica_}, regs{pica.regs.internal},
       num_sw_threads{std::max(std::thread::hardware_concurrency(), 2U)},
-      sw_workers{num_sw_threads, "SwRenderer workers"}, fb{memory, regs.framebuffer} {}
+      sw_workers{num_sw_threads, "SwRenderer workers"}, fb{memory, regs.framebuffer},
+      texture_cache{memory} {}
+
+RasterizerSoftware::~RasterizerSoftware() = default;
+
+void RasterizerSoftware::InvalidateRegion(PAddr addr, u32 size) {
+    texture_cache.InvalidateRegion(addr, size);
+}
+
+void RasterizerSoftware::FlushAndInvalidateRegion(PAddr addr, u32 size) {
+    texture_cache.InvalidateRegion(addr, size);
+}
+
+void RasterizerSoftware::ClearAll(bool flush) {
+    texture_cache.Clear();
+}
 
 void RasterizerSoftware::AddTriangle(const Pica::OutputVertex& v0, const Pica::OutputVertex& v1,
                                      const Pica::OutputVertex& v2) {
@@ -229,8 +266,6 @@ void RasterizerSoftware::MakeScreenCoords(Vertex& vtx) {
 
 void RasterizerSoftware::ProcessTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2,
                                          bool reversed) {
-    MICROPROFILE_SCOPE(GPU_Rasterization);
-
     // Vertex positions in rasterizer coordinates
     static auto screen_to_rasterizer_coords = [](const Common::Vec3<f24>& vec) {
         return Common::Vec3{Fix12P4::FromFloat24(vec.x), Fix12P4::FromFloat24(vec.y),
@@ -293,144 +328,368 @@ void RasterizerSoftware::ProcessTriangle(const Vertex& v0, const Vertex& v1, con
     const int bias2 =
         IsRightSideOrFlatBottomEdge(vtxpos[2].xy(), vtxpos[0].xy(), vtxpos[1].xy()) ? -1 : 0;
 
-    const auto w_inverse = Common::MakeVec(v0.pos.w, v1.pos.w, v2.pos.w);
+    // Pixels outside of the bounding box are never covered, skip binning empty triangles
+    if (min_x >= max_x || min_y >= max_y) {
+        return;
+    }
+
+    triangles.push_back(Triangle{
+        .v0 = v0,
+        .v1 = v1,
+        .v2 = v2,
+        .vtxpos = vtxpos,
+        .bias = {bias0, bias1, bias2},
+        .min_x = min_x,
+        .min_y = min_y,
+        .max_x = max_x,
+        .max_y = max_y,
+    });
+}
 
-    const auto textures = regs.texturing.GetTextures();
-    const auto tev_stages = regs.texturing.GetTevStages();
+void RasterizerSoftware::DrawTriangles() {
+    if (triangles.empty()) {
+        return;
+    }
 
+    MICROPROFILE_SCOPE(GPU_Rasterization);
+
+    // Bin the triangles of the batch into the screen tiles they overlap. Registers cannot change
+    // within a batch, and each tile is owned by a single worker which draws its triangles in
+    // submission order, so the output matches drawing the triangles one by one.
+    u32 tile_x_min = std::numeric_limits<u32>::max();
+    u32 tile_y_min = std::numeric_limits<u32>::max();
+    u32 tile_x_max = 0;
+    u32 tile_y_max = 0;
+    for (const auto& tri : triangles) {
+        tile_x_min = std::min<u32>(tile_x_min, tri.min_x / TILE_SIZE_FIX);
+        tile_y_min = std::min<u32>(tile_y_min, tri.min_y / TILE_SIZE_FIX);
+        tile_x_max = std::max<u32>(tile_x_max, (tri.max_x - 1) / TILE_SIZE_FIX);
+        tile_y_max = std::max<u32>(tile_y_max, (tri.max_y - 1) / TILE_SIZE_FIX);
+    }
+
+    const u32 tiles_x = tile_x_max - tile_x_min + 1;
+    const u32 tiles_y = tile_y_max - tile_y_min + 1;
+    if (tile_bins.size() < tiles_x * tiles_y) {
+        tile_bins.resize(tiles_x * tiles_y);
+    }
+    for (u32 i = 0; i < tiles_x * tiles_y; i++) {
+        tile_bins[i].clear();
+    }
+
+    for (u32 i = 0; i < static_cast<u32>(triangles.size()); i++) {
+        const auto& tri = triangles[i];
+        const u32 x0 = tri.min_x / TILE_SIZE_FIX - tile_x_min;
+        const u32 y0 = tri.min_y / TILE_SIZE_FIX - tile_y_min;
+        const u32 x1 = (tri.max_x - 1) / TILE_SIZE_FIX - tile_x_min;
+        const u32 y1 = (tri.max_y - 1) / TILE_SIZE_FIX - tile_y_min;
+        for (u32 tile_y = y0; tile_y <= y1; tile_y++) {
+            for (u32 tile_x = x0; tile_x <= x1; tile_x++) {
+                tile_bins[tile_y * tiles_x + tile_x].push_back(i);
+            }
+        }
+    }
+
+    active_tiles.clear();
+    for (u32 i = 0; i < tiles_x * tiles_y; i++) {
+        if (!tile_bins[i].empty()) {
+            active_tiles.push_back(i);
+        }
+    }
+
+    PrepareTextures();
+    PrepareTevPipeline();
     fb.Bind();
 
+    const auto draw_tile = [this, tiles_x, tile_x_min, tile_y_min](u32 tile) {
+        const u32 tile_x = tile % tiles_x + tile_x_min;
+        const u32 tile_y = tile / tiles_x + tile_y_min;
+        for (const u32 index : tile_bins[tile]) {
+            RasterizeTriangle(triangles[index], tile_x * TILE_SIZE_FIX, tile_y * TILE_SIZE_FIX,
+                              (tile_x + 1) * TILE_SIZE_FIX, (tile_y + 1) * TILE_SIZE_FIX);
+        }
+    };
+
+    // Avoid the thread pool round trip for batches which only touch a single tile
+    if (active_tiles.size() == 1) {
+        draw_tile(active_tiles[0]);
+    } else {
+        std::atomic<std::size_t> next_tile{0};
+        const std::size_t num_tasks = std::min(num_sw_threads, active_tiles.size());
+        for (std::size_t i = 0; i < num_tasks; i++) {
+            sw_workers.QueueWork([this, &next_tile, &draw_tile] {
+                for (std::size_t tile = next_tile++; tile < active_tiles.size();
+                     tile = next_tile++) {
+                    draw_tile(active_tiles[tile]);
+                }
+            });
+        }
+        sw_workers.WaitForRequests();
+    }
+
+    triangles.clear();
+
+    // The framebuffer is written directly, drop any textures decoded from it
+    const auto& framebuffer = regs.framebuffer.framebuffer;
+    const u32 num_pixels = framebuffer.GetWidth() * framebuffer.GetHeight();
+    texture_cache.InvalidateRegion(
+        framebuffer.GetColorBufferPhysicalAddress(),
+        num_pixels * FramebufferRegs::BytesPerColorPixel(framebuffer.color_format));
+    texture_cache.InvalidateRegion(
+        framebuffer.GetDepthBufferPhysicalAddress(),
+        num_pixels * FramebufferRegs::BytesPerDepthPixel(framebuffer.depth_format));
+}
+
+void RasterizerSoftware::PrepareTextures() {
+    texture_cache.BeginDraw();
+    unit_textures = {};
+    cube_textures = {};
+
+    const auto textures = regs.texturing.GetTextures();
+    for (u32 i = 0; i < 3; ++i) {
+        const auto& texture = textures[i];
+        if (!texture.enabled || texture.config.address == 0) {
+            continue;
+        }
+
+        auto info = TextureInfo::FromPicaRegister(texture.config, texture.format);
+        if (i == 0 && (texture.config.type == TexturingRegs::TextureConfig::TextureCube ||
+                       texture.config.type == TexturingRegs::TextureConfig::ShadowCube)) {
+            for (u32 face = 0; face < 6; ++face) {
+                info.physical_address = regs.texturing.GetCubePhysicalAddress(
+                    static_cast<TexturingRegs::CubeFace>(face));
+                cube_addresses[face] = info.physical_address;
+                cube_textures[face] = texture_cache.GetTexture(info);
+            }
+            continue;
+        }
+
+        unit_textures[i] = texture_cache.GetTexture(info);
+    }
+}
+
+void RasterizerSoftware::PrepareTevPipeline() {
+    const auto config = TevPipeline::GetConfig(regs);
+    const u64 config_hash = Common::ComputeHash64(config.data(), sizeof(config));
+    auto [cached, pipeline] = tev_pipelines.request(config_hash);
+    if (!cached || pipeline.GetConfig() != config) [[unlikely]] {
+        pipeline = TevPipeline{regs};
+    } else {
+        pipeline.UpdateUniforms(regs);
+    }
+    tev_pipeline = &pipeline;
+}
+
+void RasterizerSoftware::RasterizeTriangle(const Triangle& tri, u32 tile_x1, u32 tile_y1,
+                                           u32 tile_x2, u32 tile_y2) {
+    using Simd::F32x4;
+    using Simd::S32x4;
+
+    const Vertex& v0 = tri.v0;
+    const Vertex& v1 = tri.v1;
+    const Vertex& v2 = tri.v2;
+    const auto& vtxpos = tri.vtxpos;
+    const auto [bias0, bias1, bias2] = tri.bias;
+
+    // Convert the scissor box coordinates to 12.4 fixed point
+    const u16 scissor_x1 = static_cast<u16>(regs.rasterizer.scissor_test.x1 << 4);
+    const u16 scissor_y1 = static_cast<u16>(regs.rasterizer.scissor_test.y1 << 4);
+    // x2,y2 have +1 added to cover the entire sub-pixel area
+    const u16 scissor_x2 = static_cast<u16>((regs.rasterizer.scissor_test.x2 + 1) << 4);
+    const u16 scissor_y2 = static_cast<u16>((regs.rasterizer.scissor_test.y2 + 1) << 4);
+    const bool scissor_exclude =
+        regs.rasterizer.scissor_test.mode == RasterizerRegs::ScissorMode::Exclude;
+
+    // Not fully accurate. About 3 bits in precision are missing.
+    // Z-Buffer (z / w * scale + offset)
+    const F32x4 depth_scale =
+        F32x4::Splat(f24::FromRaw(regs.rasterizer.viewport_depth_range).ToFloat32());
+    const F32x4 depth_offset =
+        F32x4::Splat(f24::FromRaw(regs.rasterizer.viewport_depth_near_plane).ToFloat32());
+    const bool w_buffering =
+        regs.rasterizer.depthmap_enable == Pica::RasterizerRegs::DepthBuffering::WBuffering;
+    const bool lighting_enable = !regs.lighting.disable;
+
+    const auto textures = regs.texturing.GetTextures();
+
+    // Only the part of the bounding box within the tile is processed, both are pixel aligned
+    const u16 min_x = static_cast<u16>(std::max<u32>(tri.min_x, tile_x1));
+    const u16 min_y = static_cast<u16>(std::max<u32>(tri.min_y, tile_y1));
+    const u16 max_x = static_cast<u16>(std::min<u32>(tri.max_x, tile_x2));
+    const u16 max_y = static_cast<u16>(std::min<u32>(tri.max_y, tile_y2));
+
+    // The edge functions are linear in x, moving one pixel to the right adds these to them
+    const auto edge_step = [](const Common::Vec3<Fix12P4>& line1,
+                              const Common::Vec3<Fix12P4>& line2) {
+        return -(static_cast<s32>(line2.y) - static_cast<s32>(line1.y)) * 0x10;
+    };
+    const s32 step0 = edge_step(vtxpos[1], vtxpos[2]);
+    const s32 step1 = edge_step(vtxpos[2], vtxpos[0]);
+    const s32 step2 = edge_step(vtxpos[0], vtxpos[1]);
+    const auto advance = [](s32 value, s32 step) {
+        return static_cast<s32>(static_cast<u32>(value) + 4 * static_cast<u32>(step));
+    };
+
+    const F32x4 w_inverse0 = F32x4::Splat(v0.pos.w.ToFloat32());
+    const F32x4 w_inverse1 = F32x4::Splat(v1.pos.w.ToFloat32());
+    const F32x4 w_inverse2 = F32x4::Splat(v2.pos.w.ToFloat32());
+
+    /**
+     * Attributes are interpolated for a span of 4 pixels at once. Everything after interpolation
+     * (texturing, lighting, TEV and the output merger) is done one pixel at a time, as it depends
+     * on too much state to be worth vectorizing.
+     **/
+    struct Span {
+        std::array<float, 4> depth;
+        std::array<std::array<float, 4>, 4> color;
+        std::array<std::array<float, 4>, 6> uv;
+        std::array<float, 4> tc0_w;
+        std::array<std::array<float, 4>, 4> quat;
+        std::array<std::array<float, 4>, 3> view;
+    } span;
+
     // Enter rasterization loop, starting at the center of the topleft bounding box corner.
-    // TODO: Not sure if looping through x first might be faster
     for (u16 y = min_y + 8; y < max_y; y += 0x10) {
-        const auto process_scanline = [&, y] {
-            for (u16 x = min_x + 8; x < max_x; x += 0x10) {
-                // Do not process the pixel if it's inside the scissor box and the scissor mode is
-                // set to Exclude.
-                if (regs.rasterizer.scissor_test.mode == RasterizerRegs::ScissorMode::Exclude) {
-                    if (x >= scissor_x1 && x < scissor_x2 && y >= scissor_y1 && y < scissor_y2) {
-                        continue;
+        const u16 row_x = min_x + 8;
+        s32 w0_start = bias0 + SignedArea(vtxpos[1].xy(), vtxpos[2].xy(), {row_x, y});
+        s32 w1_start = bias1 + SignedArea(vtxpos[2].xy(), vtxpos[0].xy(), {row_x, y});
+        s32 w2_start = bias2 + SignedArea(vtxpos[0].xy(), vtxpos[1].xy(), {row_x, y});
+
+        for (u32 span_x = row_x; span_x < max_x; span_x += 0x40) {
+            // Calculate the barycentric coordinates w0, w1 and w2
+            const S32x4 w0 = S32x4::Ramp(w0_start, step0);
+            const S32x4 w1 = S32x4::Ramp(w1_start, step1);
+            const S32x4 w2 = S32x4::Ramp(w2_start, step2);
+            w0_start = advance(w0_start, step0);
+            w1_start = advance(w1_start, step1);
+            w2_start = advance(w2_start, step2);
+
+            // If current pixel is not covered by the current primitive
+            const u32 num_pixels = std::min<u32>(4, (max_x - span_x + 0xF) >> 4);
+            u32 coverage = Simd::NonNegativeMask(w0, w1, w2) & ((1U << num_pixels) - 1);
+
+            // Do not process the pixel if it's inside the scissor box and the scissor mode is
+            // set to Exclude.
+            if (scissor_exclude && y >= scissor_y1 && y < scissor_y2) {
+                for (u32 i = 0; i < num_pixels; i++) {
+                    const u32 x = span_x + i * 0x10;
+                    if (x >= scissor_x1 && x < scissor_x2) {
+                        coverage &= ~(1U << i);
                     }
                 }
+            }
 
-                // Calculate the barycentric coordinates w0, w1 and w2
-                const s32 w0 = bias0 + SignedArea(vtxpos[1].xy(), vtxpos[2].xy(), {x, y});
-                const s32 w1 = bias1 + SignedArea(vtxpos[2].xy(), vtxpos[0].xy(), {x, y});
-                const s32 w2 = bias2 + SignedArea(vtxpos[0].xy(), vtxpos[1].xy(), {x, y});
-                const s32 wsum = w0 + w1 + w2;
+            if (coverage == 0) {
+                continue;
+            }
 
-                // If current pixel is not covered by the current primitive
-                if (w0 < 0 || w1 < 0 || w2 < 0) {
-                    continue;
+            const F32x4 bary0 = F32x4::FromS32(w0);
+            const F32x4 bary1 = F32x4::FromS32(w1);
+            const F32x4 bary2 = F32x4::FromS32(w2);
+            const F32x4 wsum = F32x4::FromS32(w0 + w1 + w2);
+            const F32x4 interpolated_w_inverse =
+                F32x4::Splat(1.0f) / (Simd::MulF24(w_inverse0, bary0) +
+                                      Simd::MulF24(w_inverse1, bary1) +
+                                      Simd::MulF24(w_inverse2, bary2));
+
+            // interpolated_z = z / w
+            const F32x4 interpolated_z_over_w =
+                (F32x4::Splat(v0.screenpos[2].ToFloat32()) * bary0 +
+                 F32x4::Splat(v1.screenpos[2].ToFloat32()) * bary1 +
+                 F32x4::Splat(v2.screenpos[2].ToFloat32()) * bary2) /
+                wsum;
+            F32x4 depth = interpolated_z_over_w * depth_scale + depth_offset;
+
+            // Potentially switch to W-Buffer
+            if (w_buffering) {
+                // W-Buffer (z * scale + w * offset = (z / w * scale + offset) * w)
+                depth = depth * (interpolated_w_inverse * wsum);
+            }
+            depth.Store(span.depth.data());
+
+            /**
+             * Perspective correct attribute interpolation:
+             * Attribute values cannot be calculated by simple linear interpolation since
+             * they are not linear in screen space. For example, when interpolating a
+             * texture coordinate across two vertices, something simple like
+             *     u = (u0*w0 + u1*w1)/(w0+w1)
+             * will not work. However, the attribute value divided by the
+             * clipspace w-coordinate (u/w) and and the inverse w-coordinate (1/w) are linear
+             * in screenspace. Hence, we can linearly interpolate these two independently and
+             * calculate the interpolated attribute by dividing the results.
+             * I.e.
+             *     u_over_w   = ((u0/v0.pos.w)*w0 + (u1/v1.pos.w)*w1)/(w0+w1)
+             *     one_over_w = (( 1/v0.pos.w)*w0 + ( 1/v1.pos.w)*w1)/(w0+w1)
+             *     u = u_over_w / one_over_w
+             *
+             * The generalization to three vertices is straightforward in baricentric
+             *coordinates.
+             **/
+            const auto interpolate = [&](f24 attr0, f24 attr1, f24 attr2, float* out) {
+                const F32x4 interpolated_attr_over_w =
+                    Simd::MulF24(F32x4::Splat(attr0.ToFloat32()), bary0) +
+                    Simd::MulF24(F32x4::Splat(attr1.ToFloat32()), bary1) +
+                    Simd::MulF24(F32x4::Splat(attr2.ToFloat32()), bary2);
+                Simd::MulF24(interpolated_attr_over_w, interpolated_w_inverse).Store(out);
+            };
+
+            for (u32 i = 0; i < 4; i++) {
+                interpolate(v0.color[i], v1.color[i], v2.color[i], span.color[i].data());
+            }
+            interpolate(v0.tc0.u(), v1.tc0.u(), v2.tc0.u(), span.uv[0].data());
+            interpolate(v0.tc0.v(), v1.tc0.v(), v2.tc0.v(), span.uv[1].data());
+            interpolate(v0.tc1.u(), v1.tc1.u(), v2.tc1.u(), span.uv[2].data());
+            interpolate(v0.tc1.v(), v1.tc1.v(), v2.tc1.v(), span.uv[3].data());
+            interpolate(v0.tc2.u(), v1.tc2.u(), v2.tc2.u(), span.uv[4].data());
+            interpolate(v0.tc2.v(), v1.tc2.v(), v2.tc2.v(), span.uv[5].data());
+            interpolate(v0.tc0_w, v1.tc0_w, v2.tc0_w, span.tc0_w.data());
+            if (lighting_enable) {
+                for (u32 i = 0; i < 4; i++) {
+                    interpolate(v0.quat[i], v1.quat[i], v2.quat[i], span.quat[i].data());
+                }
+                for (u32 i = 0; i < 3; i++) {
+                    interpolate(v0.view[i], v1.view[i], v2.view[i], span.view[i].data());
                 }
+            }
 
-                const auto baricentric_coordinates = Common::MakeVec(
-                    f24::FromFloat32(static_cast<f32>(w0)), f24::FromFloat32(static_cast<f32>(w1)),
-                    f24::FromFloat32(static_cast<f32>(w2)));
-                const f24 interpolated_w_inverse =
-                    f24::One() / Common::Dot(w_inverse, baricentric_coordinates);
-
-                // interpolated_z = z / w
-                const float interpolated_z_over_w =
-                    (v0.screenpos[2].ToFloat32() * w0 + v1.screenpos[2].ToFloat32() * w1 +
-                     v2.screenpos[2].ToFloat32() * w2) /
-                    wsum;
-
-                // Not fully accurate. About 3 bits in precision are missing.
-                // Z-Buffer (z / w * scale + offset)
-                const float depth_scale =
-                    f24::FromRaw(regs.rasterizer.viewport_depth_range).ToFloat32();
-                const float depth_offset =
-                    f24::FromRaw(regs.rasterizer.viewport_depth_near_plane).ToFloat32();
-                float depth = interpolated_z_over_w * depth_scale + depth_offset;
-
-                // Potentially switch to W-Buffer
-                if (regs.rasterizer.depthmap_enable ==
-                    Pica::RasterizerRegs::DepthBuffering::WBuffering) {
-                    // W-Buffer (z * scale + w * offset = (z / w * scale + offset) * w)
-                    depth *= interpolated_w_inverse.ToFloat32() * wsum;
+            for (u32 i = 0; i < num_pixels; i++) {
+                if ((coverage & (1U << i)) == 0) {
+                    continue;
                 }
 
+                const u16 x = static_cast<u16>(span_x + i * 0x10);
+
                 // Clamp the result
-                depth = std::clamp(depth, 0.0f, 1.0f);
-
-                /**
-                 * Perspective correct attribute interpolation:
-                 * Attribute values cannot be calculated by simple linear interpolation since
-                 * they are not linear in screen space. For example, when interpolating a
-                 * texture coordinate across two vertices, something simple like
-                 *     u = (u0*w0 + u1*w1)/(w0+w1)
-                 * will not work. However, the attribute value divided by the
-                 * clipspace w-coordinate (u/w) and and the inverse w-coordinate (1/w) are linear
-                 * in screenspace. Hence, we can linearly interpolate these two independently and
-                 * calculate the interpolated attribute by dividing the results.
-                 * I.e.
-                 *     u_over_w   = ((u0/v0.pos.w)*w0 + (u1/v1.pos.w)*w1)/(w0+w1)
-                 *     one_over_w = (( 1/v0.pos.w)*w0 + ( 1/v1.pos.w)*w1)/(w0+w1)
-                 *     u = u_over_w / one_over_w
-                 *
-                 * The generalization to three vertices is straightforward in baricentric
-                 *coordinates.
-                 **/
-                const auto get_interpolated_attribute = [&](f24 attr0, f24 attr1, f24 attr2) {
-                    auto attr_over_w = Common::MakeVec(attr0, attr1, attr2);
-                    f24 interpolated_attr_over_w =
-                        Common::Dot(attr_over_w, baricentric_coordinates);
-                    return interpolated_attr_over_w * interpolated_w_inverse;
-                };
+                const float depth = std::clamp(span.depth[i], 0.0f, 1.0f);
 
                 const Common::Vec4<u8> primary_color{
-                    static_cast<u8>(
-                        round(get_interpolated_attribute(v0.color.r(), v1.color.r(), v2.color.r())
-                                  .ToFloat32() *
-                              255)),
-                    static_cast<u8>(
-                        round(get_interpolated_attribute(v0.color.g(), v1.color.g(), v2.color.g())
-                                  .ToFloat32() *
-                              255)),
-                    static_cast<u8>(
-                        round(get_interpolated_attribute(v0.color.b(), v1.color.b(), v2.color.b())
-                                  .ToFloat32() *
-                              255)),
-                    static_cast<u8>(
-                        round(get_interpolated_attribute(v0.color.a(), v1.color.a(), v2.color.a())
-                                  .ToFloat32() *
-                              255)),
+                    static_cast<u8>(round(span.color[0][i] * 255)),
+                    static_cast<u8>(round(span.color[1][i] * 255)),
+                    static_cast<u8>(round(span.color[2][i] * 255)),
+                    static_cast<u8>(round(span.color[3][i] * 255)),
                 };
 
                 std::array<Common::Vec2<f24>, 3> uv;
-                uv[0].u() = get_interpolated_attribute(v0.tc0.u(), v1.tc0.u(), v2.tc0.u());
-                uv[0].v() = get_interpolated_attribute(v0.tc0.v(), v1.tc0.v(), v2.tc0.v());
-                uv[1].u() = get_interpolated_attribute(v0.tc1.u(), v1.tc1.u(), v2.tc1.u());
-                uv[1].v() = get_interpolated_attribute(v0.tc1.v(), v1.tc1.v(), v2.tc1.v());
-                uv[2].u() = get_interpolated_attribute(v0.tc2.u(), v1.tc2.u(), v2.tc2.u());
-                uv[2].v() = get_interpolated_attribute(v0.tc2.v(), v1.tc2.v(), v2.tc2.v());
+                for (u32 j = 0; j < 3; j++) {
+                    uv[j].u() = f24::FromFloat32(span.uv[j * 2][i]);
+                    uv[j].v() = f24::FromFloat32(span.uv[j * 2 + 1][i]);
+                }
 
                 // Sample bound texture units.
-                const f24 tc0_w = get_interpolated_attribute(v0.tc0_w, v1.tc0_w, v2.tc0_w);
+                const f24 tc0_w = f24::FromFloat32(span.tc0_w[i]);
                 const auto texture_color = TextureColor(uv, textures, tc0_w);
 
                 Common::Vec4<u8> primary_fragment_color = {0, 0, 0, 0};
                 Common::Vec4<u8> secondary_fragment_color = {0, 0, 0, 0};
 
-                if (!regs.lighting.disable) {
+                if (lighting_enable) {
                     const auto normquat =
                         Common::Quaternion<f32>{
-                            {get_interpolated_attribute(v0.quat.x, v1.quat.x, v2.quat.x)
-                                 .ToFloat32(),
-                             get_interpolated_attribute(v0.quat.y, v1.quat.y, v2.quat.y)
-                                 .ToFloat32(),
-                             get_interpolated_attribute(v0.quat.z, v1.quat.z, v2.quat.z)
-                                 .ToFloat32()},
-                            get_interpolated_attribute(v0.quat.w, v1.quat.w, v2.quat.w).ToFloat32(),
+                            {span.quat[0][i], span.quat[1][i], span.quat[2][i]},
+                            span.quat[3][i],
                         }
                             .Normalized();
 
-                    const Common::Vec3f view{
-                        get_interpolated_attribute(v0.view.x, v1.view.x, v2.view.x).ToFloat32(),
-                        get_interpolated_attribute(v0.view.y, v1.view.y, v2.view.y).ToFloat32(),
-                        get_interpolated_attribute(v0.view.z, v1.view.z, v2.view.z).ToFloat32(),
-                    };
+                    const Common::Vec3f view{span.view[0][i], span.view[1][i], span.view[2][i]};
                     std::tie(primary_fragment_color, secondary_fragment_color) =
                         ComputeFragmentsColors(regs.lighting, pica.lighting, normquat, view,
                                                texture_color);
@@ -438,8 +697,8 @@ void RasterizerSoftware::ProcessTriangle(const Vertex& v0, const Vertex& v1, con
 
                 // Write the TEV stages.
                 auto combiner_output =
-                    WriteTevConfig(texture_color, tev_stages, primary_color, primary_fragment_color,
-                                   secondary_fragment_color);
+                    tev_pipeline->Combine(texture_color, primary_color, primary_fragment_color,
+                                          secondary_fragment_color);
 
                 const auto& output_merger = regs.framebuffer.output_merger;
                 if (output_merger.fragment_operation_mode ==
@@ -453,7 +712,7 @@ void RasterizerSoftware::ProcessTriangle(const Vertex& v0, const Vertex& v1, con
                 }
 
                 // Does alpha testing happen before or after stencil?
-                if (!DoAlphaTest(combiner_output.a())) {
+                if (!tev_pipeline->AlphaTest(combiner_output.a())) {
                     continue;
                 }
                 WriteFog(depth, combiner_output);
@@ -465,10 +724,8 @@ void RasterizerSoftware::ProcessTriangle(const Vertex& v0, const Vertex& v1, con
                     fb.DrawPixel(x >> 4, y >> 4, result);
                 }
             }
-        };
-        sw_workers.QueueWork(std::move(process_scanline));
+        }
     }
-    sw_workers.WaitForRequests();
 }
 
 std::array<Common::Vec4<u8>, 4> RasterizerSoftware::TextureColor(
@@ -557,11 +814,24 @@ std::array<Common::Vec4<u8>, 4> RasterizerSoftware::TextureColor(
             t = texture.config.height - 1 -
                 GetWrappedTexCoord(texture.config.wrap_t, t, texture.config.height);
 
-            const u8* texture_data = memory.GetPhysicalPointer(texture_address);
-            const auto info = TextureInfo::FromPicaRegister(texture.config, texture.format);
+            const Common::Vec4<u8>* texels = unit_textures[i];
+            if (i == 0 && (texture.config.type == TexturingRegs::TextureConfig::TextureCube ||
+                           texture.config.type == TexturingRegs::TextureConfig::ShadowCube)) {
+                const auto face =
+                    std::find(cube_addresses.begin(), cube_addresses.end(), texture_address);
+                texels = face != cube_addresses.end()
+                             ? cube_textures[std::distance(cube_addresses.begin(), face)]
+                             : nullptr;
+            }
 
             // TODO: Apply the min and mag filters to the texture
-            texture_color[i] = LookupTexture(texture_data, s, t, info);
+            if (texels) [[likely]] {
+                texture_color[i] = texels[t * texture.config.width + s];
+            } else {
+                const u8* texture_data = memory.GetPhysicalPointer(texture_address);
+                const auto info = TextureInfo::FromPicaRegister(texture.config, texture.format);
+                texture_color[i] = LookupTexture(texture_data, s, t, info);
+            }
         }
 
         if (i == 0 && (texture.config.type == TexturingRegs::TextureConfig::Shadow2D ||
@@ -682,120 +952,6 @@ Common::Vec4<u8> RasterizerSoftware::PixelColor(u16 x, u16 y,
     return result;
 }
 
-Common::Vec4<u8> RasterizerSoftware::WriteTevConfig(
-    std::span<const Common::Vec4<u8>, 4> texture_color,
-    std::span<const Pica::TexturingRegs::TevStageConfig, 6> tev_stages,
-    Common::Vec4<u8> primary_color, Common::Vec4<u8> primary_fragment_color,
-    Common::Vec4<u8> secondary_fragment_color) {
-    /**
-     * Texture environment - consists of 6 stages of color and alpha combining.
-     * Color combiners take three input color values from some source (e.g. interpolated
-     * vertex color, texture color, previous stage, etc), perform some very simple
-     * operations on each of them (e.g. inversion) and then calculate the output color
-     * with some basic arithmetic. Alpha combiners can be configured separately but work
-     * analogously.
-     **/
-    Common::Vec4<u8> combiner_output = {0, 0, 0, 0};
-    Common::Vec4<u8> combiner_buffer = {0, 0, 0, 0};
-    Common::Vec4<u8> next_combiner_buffer =
-        Common::MakeVec(regs.texturing.tev_combiner_buffer_color.r.Value(),
-                        regs.texturing.tev_combiner_buffer_color.g.Value(),
-                        regs.texturing.tev_combiner_buffer_color.b.Value(),
-                        regs.texturing.tev_combiner_buffer_color.a.Value())
-            .Cast<u8>();
-
-    for (u32 tev_stage_index = 0; tev_stage_index < tev_stages.size(); ++tev_stage_index) {
-        const auto& tev_stage = tev_stages[tev_stage_index];
-        using Source = TexturingRegs::TevStageConfig::Source;
-
-        auto get_source = [&](Source source) -> Common::Vec4<u8> {
-            switch (source) {
-            case Source::PrimaryColor:
-                return primary_color;
-            case Source::PrimaryFragmentColor:
-                return primary_fragment_color;
-            case Source::SecondaryFragmentColor:
-                return secondary_fragment_color;
-            case Source::Texture0:
-                return texture_color[0];
-            case Source::Texture1:
-                return texture_color[1];
-            case Source::Texture2:
-                return texture_color[2];
-            case Source::Texture3:
-                return texture_color[3];
-            case Source::PreviousBuffer:
-                return combiner_buffer;
-            case Source::Constant:
-                return Common::MakeVec(tev_stage.const_r.Value(), tev_stage.const_g.Value(),
-                                       tev_stage.const_b.Value(), tev_stage.const_a.Value())
-                    .Cast<u8>();
-            case Source::Previous:
-                return combiner_output;
-            default:
-                LOG_ERROR(HW_GPU, "Unknown color combiner source {}", (int)source);
-                UNIMPLEMENTED();
-                return {0, 0, 0, 0};
-            }
-        };
-
-        /**
-         * Color combiner
-         * NOTE: Not sure if the alpha combiner might use the color output of the previous
-         *       stage as input. Hence, we currently don't directly write the result to
-         *       combiner_output.rgb(), but instead store it in a temporary variable until
-         *       alpha combining has been done.
-         **/
-        const auto source1 = tev_stage_index == 0 && tev_stage.color_source1 == Source::Previous
-                                 ? tev_stage.color_source3.Value()
-                                 : tev_stage.color_source1.Value();
-        const auto source2 = tev_stage_index == 0 && tev_stage.color_source2 == Source::Previous
-                                 ? tev_stage.color_source3.Value()
-                                 : tev_stage.color_source2.Value();
-        const std::array<Common::Vec3<u8>, 3> color_result = {
-            GetColorModifier(tev_stage.color_modifier1, get_source(source1)),
-            GetColorModifier(tev_stage.color_modifier2, get_source(source2)),
-            GetColorModifier(tev_stage.color_modifier3, get_source(tev_stage.color_source3)),
-        };
-        const Common::Vec3<u8> color_output = ColorCombine(tev_stage.color_op, color_result);
-
-        u8 alpha_output;
-        if (tev_stage.color_op == TexturingRegs::TevStageConfig::Operation::Dot3_RGBA) {
-            // result of Dot3_RGBA operation is also placed to the alpha component
-            alpha_output = color_output.x;
-        } else {
-            // alpha combiner
-            const std::array<u8, 3> alpha_result = {{
-                GetAlphaModifier(tev_stage.alpha_modifier1, get_source(tev_stage.alpha_source1)),
-                GetAlphaModifier(tev_stage.alpha_modifier2, get_source(tev_stage.alpha_source2)),
-                GetAlphaModifier(tev_stage.alpha_modifier3, get_source(tev_stage.alpha_source3)),
-            }};
-            alpha_output = AlphaCombine(tev_stage.alpha_op, alpha_result);
-        }
-
-        combiner_output[0] = std::min(255U, color_output.r() * tev_stage.GetColorMultiplier());
-        combiner_output[1] = std::min(255U, color_output.g() * tev_stage.GetColorMultiplier());
-        combiner_output[2] = std::min(255U, color_output.b() * tev_stage.GetColorMultiplier());
-        combiner_output[3] = std::min(255U, alpha_output * tev_stage.GetAlphaMultiplier());
-
-        combiner_buffer = next_combiner_buffer;
-
-        if (regs.texturing.tev_combiner_buffer_input.TevStageUpdatesCombinerBufferColor(
-                tev_stage_index)) {
-            next_combiner_buffer.r() = combiner_output.r();
-            next_combiner_buffer.g() = combiner_output.g();
-            next_combiner_buffer.b() = combiner_output.b();
-        }
-
-        if (regs.texturing.tev_combiner_buffer_input.TevStageUpdatesCombinerBufferAlpha(
-                tev_stage_index)) {
-            next_combiner_buffer.a() = combiner_output.a();
-        }
-    }
-
-    return combiner_output;
-}
-
 void RasterizerSoftware::WriteFog(float depth, Common::Vec4<u8>& combiner_output) const {
     /**
      * Apply fog combiner. Not fully accurate. We'd have to know what data type is used to
@@ -827,35 +983,6 @@ void RasterizerSoftware::WriteFog(float depth, Common::Vec4<u8>& combiner_output
     }
 }
 
-bool RasterizerSoftware::DoAlphaTest(u8 alpha) const {
-    const auto& output_merger = regs.framebuffer.output_merger;
-    if (!output_merger.alpha_test.enable) {
-        return true;
-    }
-    switch (output_merger.alpha_test.func) {
-    case FramebufferRegs::CompareFunc::Never:
-        return false;
-    case FramebufferRegs::CompareFunc::Always:
-        return true;
-    case FramebufferRegs::CompareFunc::Equal:
-        return alpha == output_merger.alpha_test.ref;
-    case FramebufferRegs::CompareFunc::NotEqual:
-        return alpha != output_merger.alpha_test.ref;
-    case FramebufferRegs::CompareFunc::LessThan:
-        return alpha < output_merger.alpha_test.ref;
-    case FramebufferRegs::CompareFunc::LessThanOrEqual:
-        return alpha <= output_merger.alpha_test.ref;
-    case FramebufferRegs::CompareFunc::GreaterThan:
-        return alpha > output_merger.alpha_test.ref;
-    case FramebufferRegs::CompareFunc::GreaterThanOrEqual:
-        return alpha >= output_merger.alpha_test.ref;
-    default:
-        LOG_CRITICAL(Render_Software, "Unknown alpha test condition {}",
-                     output_merger.alpha_test.func.Value());
-        return false;
-    }
-}
-
 bool RasterizerSoftware::DoDepthStencilTest(u16 x, u16 y, float depth) const {
     const auto& framebuffer = regs.framebuffer.framebuffer;
     const auto stencil_test = regs.framebuffer.output_merger.stencil_test;
@@ -5,11 +5,15 @@
 #pragma once
 
 #include <span>
+#include <vector>
+#include "common/static_lru_cache.h"
 #include "common/thread_worker.h"
 #include "video_core/pica/regs_texturing.h"
 #include "video_core/rasterizer_interface.h"
 #include "video_core/renderer_software/sw_clipper.h"
 #include "video_core/renderer_software/sw_framebuffer.h"
+#include "video_core/renderer_software/sw_tev.h"
+#include "video_core/renderer_software/sw_texture_cache.h"
 
 namespace Pica {
 struct RegsInternal;
@@ -23,25 +27,38 @@ struct Vertex;
 class RasterizerSoftware : public VideoCore::RasterizerInterface {
 public:
     explicit RasterizerSoftware(Memory::MemorySystem& memory, Pica::PicaCore& pica);
+    ~RasterizerSoftware() override;
 
     void AddTriangle(const Pica::OutputVertex& v0, const Pica::OutputVertex& v1,
                      const Pica::OutputVertex& v2) override;
-    void DrawTriangles() override {}
+    void DrawTriangles() override;
     void NotifyPicaRegisterChanged(u32 id) override {}
     void FlushAll() override {}
     void FlushRegion(PAddr addr, u32 size) override {}
-    void InvalidateRegion(PAddr addr, u32 size) override {}
-    void FlushAndInvalidateRegion(PAddr addr, u32 size) override {}
-    void ClearAll(bool flush) override {}
+    void InvalidateRegion(PAddr addr, u32 size) override;
+    void FlushAndInvalidateRegion(PAddr addr, u32 size) override;
+    void ClearAll(bool flush) override;
 
 private:
     /// Computes the screen coordinates of the provided vertex.
     void MakeScreenCoords(Vertex& vtx);
 
-    /// Processes the triangle defined by the provided vertices.
+    struct Triangle;
+
+    /// Sets up the triangle defined by the provided vertices and adds it to the current batch.
     void ProcessTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2,
                          bool reversed = false);
 
+    /// Looks up the decoded textures sampled by the current draw in the texture cache.
+    void PrepareTextures();
+
+    /// Looks up the combiner pipeline of the current draw, building it if it is not cached yet.
+    void PrepareTevPipeline();
+
+    /// Rasterizes the part of the triangle within the provided tile bounds (12.4 fixed point).
+    void RasterizeTriangle(const Triangle& tri, u32 tile_x1, u32 tile_y1, u32 tile_x2,
+                           u32 tile_y2);
+
     /// Returns the texture color of the currently processed pixel.
     std::array<Common::Vec4<u8>, 4> TextureColor(
         std::span<const Common::Vec2<f24>, 3> uv,
@@ -50,19 +67,9 @@ private:
     /// Returns the final pixel color with blending or logic ops applied.
     Common::Vec4<u8> PixelColor(u16 x, u16 y, Common::Vec4<u8> combiner_output) const;
 
-    /// Emulates the TEV configuration and returns the combiner output.
-    Common::Vec4<u8> WriteTevConfig(
-        std::span<const Common::Vec4<u8>, 4> texture_color,
-        std::span<const Pica::TexturingRegs::TevStageConfig, 6> tev_stages,
-        Common::Vec4<u8> primary_color, Common::Vec4<u8> primary_fragment_color,
-        Common::Vec4<u8> secondary_fragment_color);
-
     /// Blends fog to the combiner output if enabled.
     void WriteFog(float depth, Common::Vec4<u8>& combiner_output) const;
 
-    /// Performs the alpha test. Returns false if the test failed.
-    bool DoAlphaTest(u8 alpha) const;
-
     /// Performs the depth stencil test. Returns false if the test failed.
     bool DoDepthStencilTest(u16 x, u16 y, float depth) const;
 
@@ -73,6 +80,16 @@ private:
     std::size_t num_sw_threads;
     Common::ThreadWorker sw_workers;
     Framebuffer fb;
+    TextureCache texture_cache;
+    std::array<const Common::Vec4<u8>*, 3> unit_textures{};
+    std::array<PAddr, 6> cube_addresses{};
+    std::array<const Common::Vec4<u8>*, 6> cube_textures{};
+    /// Games use a few dozen TEV configurations at most, older ones are evicted
+    Common::StaticLRUCache<u64, TevPipeline, 64> tev_pipelines;
+    const TevPipeline* tev_pipeline{};
+    std::vector<Triangle> triangles;
+    std::vector<std::vector<u32>> tile_bins;
+    std::vector<u32> active_tiles;
 };
 
 } // namespace SwRenderer
@@ -0,0 +1,233 @@
+// Copyright 2024 Encore Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include "common/arch.h"
+#include "common/common_types.h"
+
+#if ENCORE_ARCH(x86_64)
+#include <emmintrin.h>
+#elif ENCORE_ARCH(arm64)
+#include <arm_neon.h>
+#endif
+
+namespace SwRenderer::Simd {
+
+/**
+ * Minimal 4-lane vector types used by the rasterizer to process spans of pixels.
+ * Every operation maps to a single IEEE operation per lane (no fused multiply-add), so lane
+ * results match the equivalent scalar code. SSE2 is part of the x86-64 baseline, so no runtime
+ * dispatch is needed; other architectures fall back to plain arrays.
+ **/
+#if ENCORE_ARCH(x86_64)
+
+struct S32x4 {
+    __m128i v;
+
+    /// Returns {base, base + step, base + 2 * step, base + 3 * step}, wrapping on overflow.
+    static S32x4 Ramp(s32 base, s32 step) {
+        const u32 b = static_cast<u32>(base);
+        const u32 s = static_cast<u32>(step);
+        return {_mm_setr_epi32(static_cast<s32>(b), static_cast<s32>(b + s),
+                               static_cast<s32>(b + 2 * s), static_cast<s32>(b + 3 * s))};
+    }
+
+    friend S32x4 operator+(S32x4 a, S32x4 b) {
+        return {_mm_add_epi32(a.v, b.v)};
+    }
+};
+
+/// Returns a mask with bit i set if lane i of all three vectors is non-negative.
+inline u32 NonNegativeMask(S32x4 a, S32x4 b, S32x4 c) {
+    const __m128i any = _mm_or_si128(_mm_or_si128(a.v, b.v), c.v);
+    return ~static_cast<u32>(_mm_movemask_ps(_mm_castsi128_ps(any))) & 0xF;
+}
+
+struct F32x4 {
+    __m128 v;
+
+    static F32x4 Splat(float value) {
+        return {_mm_set1_ps(value)};
+    }
+
+    static F32x4 FromS32(S32x4 value) {
+        return {_mm_cvtepi32_ps(value.v)};
+    }
+
+    void Store(float* out) const {
+        _mm_storeu_ps(out, v);
+    }
+
+    friend F32x4 operator+(F32x4 a, F32x4 b) {
+        return {_mm_add_ps(a.v, b.v)};
+    }
+
+    friend F32x4 operator*(F32x4 a, F32x4 b) {
+        return {_mm_mul_ps(a.v, b.v)};
+    }
+
+    friend F32x4 operator/(F32x4 a, F32x4 b) {
+        return {_mm_div_ps(a.v, b.v)};
+    }
+};
+
+/// Multiplies like Pica::f24, which gives 0 instead of NaN when multiplying by inf.
+inline F32x4 MulF24(F32x4 a, F32x4 b) {
+    const __m128 result = _mm_mul_ps(a.v, b.v);
+    const __m128 nan_result = _mm_cmpunord_ps(result, result);
+    const __m128 nan_input = _mm_or_ps(_mm_cmpunord_ps(a.v, a.v), _mm_cmpunord_ps(b.v, b.v));
+    return {_mm_andnot_ps(_mm_andnot_ps(nan_input, nan_result), result)};
+}
+
+#elif ENCORE_ARCH(arm64)
+
+struct S32x4 {
+    int32x4_t v;
+
+    /// Returns {base, base + step, base + 2 * step, base + 3 * step}, wrapping on overflow.
+    static S32x4 Ramp(s32 base, s32 step) {
+        static constexpr std::array<s32, 4> lanes = {0, 1, 2, 3};
+        return {vmlaq_s32(vdupq_n_s32(base), vld1q_s32(lanes.data()), vdupq_n_s32(step))};
+    }
+
+    friend S32x4 operator+(S32x4 a, S32x4 b) {
+        return {vaddq_s32(a.v, b.v)};
+    }
+};
+
+/// Returns a mask with bit i set if lane i of all three vectors is non-negative.
+inline u32 NonNegativeMask(S32x4 a, S32x4 b, S32x4 c) {
+    static constexpr std::array<u32, 4> bits = {1, 2, 4, 8};
+    const int32x4_t any = vorrq_s32(vorrq_s32(a.v, b.v), c.v);
+    const uint32x4_t non_negative = vcgeq_s32(any, vdupq_n_s32(0));
+    return vaddvq_u32(vandq_u32(non_negative, vld1q_u32(bits.data())));
+}
+
+struct F32x4 {
+    float32x4_t v;
+
+    static F32x4 Splat(float value) {
+        return {vdupq_n_f32(value)};
+    }
+
+    static F32x4 FromS32(S32x4 value) {
+        return {vcvtq_f32_s32(value.v)};
+    }
+
+    void Store(float* out) const {
+        vst1q_f32(out, v);
+    }
+
+    friend F32x4 operator+(F32x4 a, F32x4 b) {
+        return {vaddq_f32(a.v, b.v)};
+    }
+
+    friend F32x4 operator*(F32x4 a, F32x4 b) {
+        return {vmulq_f32(a.v, b.v)};
+    }
+
+    friend F32x4 operator/(F32x4 a, F32x4 b) {
+        return {vdivq_f32(a.v, b.v)};
+    }
+};
+
+/// Multiplies like Pica::f24, which gives 0 instead of NaN when multiplying by inf.
+inline F32x4 MulF24(F32x4 a, F32x4 b) {
+    const float32x4_t result = vmulq_f32(a.v, b.v);
+    const uint32x4_t nan_result = vmvnq_u32(vceqq_f32(result, result));
+    const uint32x4_t ordered_input = vandq_u32(vceqq_f32(a.v, a.v), vceqq_f32(b.v, b.v));
+    const uint32x4_t zero_lanes = vandq_u32(nan_result, ordered_input);
+    return {vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(result), zero_lanes))};
+}
+
+#else
+
+struct S32x4 {
+    std::array<s32, 4> v;
+
+    /// Returns {base, base + step, base + 2 * step, base + 3 * step}, wrapping on overflow.
+    static S32x4 Ramp(s32 base, s32 step) {
+        S32x4 ret;
+        for (u32 i = 0; i < 4; i++) {
+            ret.v[i] = static_cast<s32>(static_cast<u32>(base) + i * static_cast<u32>(step));
+        }
+        return ret;
+    }
+
+    friend S32x4 operator+(S32x4 a, S32x4 b) {
+        for (u32 i = 0; i < 4; i++) {
+            a.v[i] = static_cast<s32>(static_cast<u32>(a.v[i]) + static_cast<u32>(b.v[i]));
+        }
+        return a;
+    }
+};
+
+/// Returns a mask with bit i set if lane i of all three vectors is non-negative.
+inline u32 NonNegativeMask(S32x4 a, S32x4 b, S32x4 c) {
+    u32 mask = 0;
+    for (u32 i = 0; i < 4; i++) {
+        mask |= (a.v[i] >= 0 && b.v[i] >= 0 && c.v[i] >= 0) ? (1U << i) : 0;
+    }
+    return mask;
+}
+
+struct F32x4 {
+    std::array<float, 4> v;
+
+    static F32x4 Splat(float value) {
+        return {{value, value, value, value}};
+    }
+
+    static F32x4 FromS32(S32x4 value) {
+        F32x4 ret;
+        for (u32 i = 0; i < 4; i++) {
+            ret.v[i] = static_cast<float>(value.v[i]);
+        }
+        return ret;
+    }
+
+    void Store(float* out) const {
+        for (u32 i = 0; i < 4; i++) {
+            out[i] = v[i];
+        }
+    }
+
+    friend F32x4 operator+(F32x4 a, F32x4 b) {
+        for (u32 i = 0; i < 4; i++) {
+            a.v[i] += b.v[i];
+        }
+        return a;
+    }
+
+    friend F32x4 operator*(F32x4 a, F32x4 b) {
+        for (u32 i = 0; i < 4; i++) {
+            a.v[i] *= b.v[i];
+        }
+        return a;
+    }
+
+    friend F32x4 operator/(F32x4 a, F32x4 b) {
+        for (u32 i = 0; i < 4; i++) {
+            a.v[i] /= b.v[i];
+        }
+        return a;
+    }
+};
+
+/// Multiplies like Pica::f24, which gives 0 instead of NaN when multiplying by inf.
+inline F32x4 MulF24(F32x4 a, F32x4 b) {
+    for (u32 i = 0; i < 4; i++) {
+        const float result = a.v[i] * b.v[i];
+        const bool zero = std::isnan(result) && !std::isnan(a.v[i]) && !std::isnan(b.v[i]);
+        a.v[i] = zero ? 0.f : result;
+    }
+    return a;
+}
+
+#endif
+
+} // namespace SwRenderer::Simd
@@ -0,0 +1,291 @@
+// Copyright 2024 Encore Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include "common/assert.h"
+#include "common/logging/log.h"
+#include "video_core/pica/regs_internal.h"
+#include "video_core/renderer_software/sw_tev.h"
+
+namespace SwRenderer {
+
+using Pica::FramebufferRegs;
+using TevStageConfig = Pica::TexturingRegs::TevStageConfig;
+
+namespace {
+
+constexpr u8 ComponentRed = 0;
+constexpr u8 ComponentAlpha = 3;
+
+bool IsKnownSource(TevStageConfig::Source source) {
+    using Source = TevStageConfig::Source;
+    switch (source) {
+    case Source::PrimaryColor:
+    case Source::PrimaryFragmentColor:
+    case Source::SecondaryFragmentColor:
+    case Source::Texture0:
+    case Source::Texture1:
+    case Source::Texture2:
+    case Source::Texture3:
+    case Source::PreviousBuffer:
+    case Source::Constant:
+    case Source::Previous:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool PassesAlphaTest(FramebufferRegs::CompareFunc func, u8 alpha, u8 ref) {
+    switch (func) {
+    case FramebufferRegs::CompareFunc::Never:
+        return false;
+    case FramebufferRegs::CompareFunc::Always:
+        return true;
+    case FramebufferRegs::CompareFunc::Equal:
+        return alpha == ref;
+    case FramebufferRegs::CompareFunc::NotEqual:
+        return alpha != ref;
+    case FramebufferRegs::CompareFunc::LessThan:
+        return alpha < ref;
+    case FramebufferRegs::CompareFunc::LessThanOrEqual:
+        return alpha <= ref;
+    case FramebufferRegs::CompareFunc::GreaterThan:
+        return alpha > ref;
+    case FramebufferRegs::CompareFunc::GreaterThanOrEqual:
+        return alpha >= ref;
+    }
+    UNREACHABLE();
+    return false;
+}
+
+} // Anonymous namespace
+
+TevPipeline::TevPipeline(const Pica::RegsInternal& regs) : config{GetConfig(regs)} {
+    using Source = TevStageConfig::Source;
+    using ColorModifier = TevStageConfig::ColorModifier;
+    using AlphaModifier = TevStageConfig::AlphaModifier;
+    using Operation = TevStageConfig::Operation;
+
+    const auto check_source = [](Source source) {
+        if (!IsKnownSource(source)) {
+            LOG_ERROR(HW_GPU, "Unknown color combiner source {}", (int)source);
+            UNIMPLEMENTED();
+        }
+        return static_cast<u8>(source);
+    };
+
+    const auto tev_stages = regs.texturing.GetTevStages();
+    for (u32 tev_stage_index = 0; tev_stage_index < tev_stages.size(); ++tev_stage_index) {
+        const auto& tev_stage = tev_stages[tev_stage_index];
+        auto& stage = stages[tev_stage_index];
+
+        // The first stage has no previous output, its first two color sources are replaced with
+        // the third one instead
+        const auto source1 = tev_stage_index == 0 && tev_stage.color_source1 == Source::Previous
+                                 ? tev_stage.color_source3.Value()
+                                 : tev_stage.color_source1.Value();
+        const auto source2 = tev_stage_index == 0 && tev_stage.color_source2 == Source::Previous
+                                 ? tev_stage.color_source3.Value()
+                                 : tev_stage.color_source2.Value();
+        const std::array<Source, 3> color_sources = {source1, source2,
+                                                     tev_stage.color_source3.Value()};
+        const std::array<ColorModifier, 3> color_modifiers = {
+            tev_stage.color_modifier1.Value(),
+            tev_stage.color_modifier2.Value(),
+            tev_stage.color_modifier3.Value(),
+        };
+        for (u32 i = 0; i < 3; ++i) {
+            // Bit 0 selects the inverted modifier, the remaining bits select the swizzle
+            const u32 modifier = static_cast<u32>(color_modifiers[i]);
+            std::array<u8, 3> components;
+            switch (static_cast<ColorModifier>(modifier & ~1U)) {
+            case ColorModifier::SourceColor:
+                components = {0, 1, 2};
+                break;
+            case ColorModifier::SourceAlpha:
+                components = {ComponentAlpha, ComponentAlpha, ComponentAlpha};
+                break;
+            case ColorModifier::SourceRed:
+                components = {0, 0, 0};
+                break;
+            case ColorModifier::SourceGreen:
+                components = {1, 1, 1};
+                break;
+            case ColorModifier::SourceBlue:
+                components = {2, 2, 2};
+                break;
+            default:
+                LOG_ERROR(HW_GPU, "Unknown color modifier {}", modifier);
+                UNIMPLEMENTED();
+                components = {0, 1, 2};
+                break;
+            }
+
+            const u8 source = check_source(color_sources[i]);
+            const u8 invert = (modifier & 1) ? 0xFF : 0;
+            for (u32 component = 0; component < 3; ++component) {
+                stage.color_modifiers[i * 3 + component] = {source, components[component], invert};
+            }
+        }
+
+        const std::array<Source, 3> alpha_sources = {
+            tev_stage.alpha_source1.Value(),
+            tev_stage.alpha_source2.Value(),
+            tev_stage.alpha_source3.Value(),
+        };
+        const std::array<AlphaModifier, 3> alpha_modifiers = {
+            tev_stage.alpha_modifier1.Value(),
+            tev_stage.alpha_modifier2.Value(),
+            tev_stage.alpha_modifier3.Value(),
+        };
+        for (u32 i = 0; i < 3; ++i) {
+            // Alpha modifiers select alpha, red, green and blue in order, bit 0 inverts
+            const u32 modifier = static_cast<u32>(alpha_modifiers[i]);
+            const u32 swizzle = modifier >> 1;
+            stage.alpha_modifiers[i] = {
+                .source = check_source(alpha_sources[i]),
+                .component = static_cast<u8>(swizzle == 0 ? ComponentAlpha
+                                                          : ComponentRed + swizzle - 1),
+                .invert = static_cast<u8>((modifier & 1) ? 0xFF : 0),
+            };
+        }
+
+        stage.color_combine = GetColorCombineFunc(tev_stage.color_op);
+        stage.dot3_rgba = tev_stage.color_op == Operation::Dot3_RGBA;
+        stage.alpha_combine =
+            stage.dot3_rgba ? nullptr : GetAlphaCombineFunc(tev_stage.alpha_op);
+        stage.color_multiplier = tev_stage.GetColorMultiplier();
+        stage.alpha_multiplier = tev_stage.GetAlphaMultiplier();
+
+        // Stages which forward the previous output unchanged only need to update the buffer
+        stage.passthrough =
+            tev_stage.color_op == Operation::Replace && source1 == Source::Previous &&
+            tev_stage.color_modifier1 == ColorModifier::SourceColor &&
+            stage.color_multiplier == 1 && tev_stage.alpha_op == Operation::Replace &&
+            tev_stage.alpha_source1 == Source::Previous &&
+            tev_stage.alpha_modifier1 == AlphaModifier::SourceAlpha && stage.alpha_multiplier == 1;
+
+        const auto& buffer_input = regs.texturing.tev_combiner_buffer_input;
+        stage.update_buffer_color =
+            buffer_input.TevStageUpdatesCombinerBufferColor(tev_stage_index);
+        stage.update_buffer_alpha =
+            buffer_input.TevStageUpdatesCombinerBufferAlpha(tev_stage_index);
+    }
+
+    UpdateUniforms(regs);
+}
+
+void TevPipeline::UpdateUniforms(const Pica::RegsInternal& regs) {
+    const auto tev_stages = regs.texturing.GetTevStages();
+    for (u32 tev_stage_index = 0; tev_stage_index < tev_stages.size(); ++tev_stage_index) {
+        const auto& tev_stage = tev_stages[tev_stage_index];
+        stages[tev_stage_index].constant =
+            Common::MakeVec(tev_stage.const_r.Value(), tev_stage.const_g.Value(),
+                            tev_stage.const_b.Value(), tev_stage.const_a.Value())
+                .Cast<u8>();
+    }
+
+    const auto& buffer_color = regs.texturing.tev_combiner_buffer_color;
+    combiner_buffer_color = Common::MakeVec(buffer_color.r.Value(), buffer_color.g.Value(),
+                                            buffer_color.b.Value(), buffer_color.a.Value())
+                                .Cast<u8>();
+
+    const auto& alpha_test = regs.framebuffer.output_merger.alpha_test;
+    for (u32 alpha = 0; alpha < alpha_test_pass.size(); ++alpha) {
+        alpha_test_pass[alpha] =
+            !alpha_test.enable || PassesAlphaTest(alpha_test.func, static_cast<u8>(alpha),
+                                                  static_cast<u8>(alpha_test.ref));
+    }
+}
+
+TevPipeline::Config TevPipeline::GetConfig(const Pica::RegsInternal& regs) {
+    Config config;
+    auto it = config.begin();
+    for (const auto& tev_stage : regs.texturing.GetTevStages()) {
+        *it++ = tev_stage.sources_raw;
+        *it++ = tev_stage.modifiers_raw;
+        *it++ = tev_stage.ops_raw;
+        *it++ = tev_stage.scales_raw;
+    }
+
+    const auto& buffer_input = regs.texturing.tev_combiner_buffer_input;
+    const auto& alpha_test = regs.framebuffer.output_merger.alpha_test;
+    *it++ = buffer_input.update_mask_rgb | buffer_input.update_mask_a << 4;
+    *it++ = alpha_test.enable | static_cast<u32>(alpha_test.func.Value()) << 4;
+    return config;
+}
+
+Common::Vec4<u8> TevPipeline::Combine(std::span<const Common::Vec4<u8>, 4> texture_color,
+                                      Common::Vec4<u8> primary_color,
+                                      Common::Vec4<u8> primary_fragment_color,
+                                      Common::Vec4<u8> secondary_fragment_color) const {
+    using Source = TevStageConfig::Source;
+
+    // Indexed by source, unknown sources read as zero
+    std::array<Common::Vec4<u8>, 16> sources{};
+    sources[static_cast<u32>(Source::PrimaryColor)] = primary_color;
+    sources[static_cast<u32>(Source::PrimaryFragmentColor)] = primary_fragment_color;
+    sources[static_cast<u32>(Source::SecondaryFragmentColor)] = secondary_fragment_color;
+    for (u32 i = 0; i < 4; ++i) {
+        sources[static_cast<u32>(Source::Texture0) + i] = texture_color[i];
+    }
+
+    Common::Vec4<u8> combiner_output = {0, 0, 0, 0};
+    Common::Vec4<u8> combiner_buffer = {0, 0, 0, 0};
+    Common::Vec4<u8> next_combiner_buffer = combiner_buffer_color;
+
+    for (const auto& stage : stages) {
+        if (!stage.passthrough) {
+            sources[static_cast<u32>(Source::PreviousBuffer)] = combiner_buffer;
+            sources[static_cast<u32>(Source::Constant)] = stage.constant;
+            sources[static_cast<u32>(Source::Previous)] = combiner_output;
+
+            std::array<Common::Vec3<u8>, 3> color_result;
+            for (u32 i = 0; i < 3; ++i) {
+                for (u32 component = 0; component < 3; ++component) {
+                    const auto& modifier = stage.color_modifiers[i * 3 + component];
+                    color_result[i][component] =
+                        sources[modifier.source][modifier.component] ^ modifier.invert;
+                }
+            }
+            const Common::Vec3<u8> color_output = stage.color_combine(color_result);
+
+            u8 alpha_output;
+            if (stage.dot3_rgba) {
+                // result of Dot3_RGBA operation is also placed to the alpha component
+                alpha_output = color_output.x;
+            } else {
+                std::array<u8, 3> alpha_result;
+                for (u32 i = 0; i < 3; ++i) {
+                    const auto& modifier = stage.alpha_modifiers[i];
+                    alpha_result[i] =
+                        sources[modifier.source][modifier.component] ^ modifier.invert;
+                }
+                alpha_output = stage.alpha_combine(alpha_result);
+            }
+
+            combiner_output[0] = std::min(255U, color_output.r() * stage.color_multiplier);
+            combiner_output[1] = std::min(255U, color_output.g() * stage.color_multiplier);
+            combiner_output[2] = std::min(255U, color_output.b() * stage.color_multiplier);
+            combiner_output[3] = std::min(255U, alpha_output * stage.alpha_multiplier);
+        }
+
+        combiner_buffer = next_combiner_buffer;
+
+        if (stage.update_buffer_color) {
+            next_combiner_buffer.r() = combiner_output.r();
+            next_combiner_buffer.g() = combiner_output.g();
+            next_combiner_buffer.b() = combiner_output.b();
+        }
+
+        if (stage.update_buffer_alpha) {
+            next_combiner_buffer.a() = combiner_output.a();
+        }
+    }
+
+    return combiner_output;
+}
+
+} // namespace SwRenderer
@@ -0,0 +1,81 @@
+// Copyright 2024 Encore Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <span>
+#include "common/common_types.h"
+#include "common/vector_math.h"
+#include "video_core/renderer_software/sw_texturing.h"
+
+namespace Pica {
+struct RegsInternal;
+}
+
+namespace SwRenderer {
+
+/**
+ * Texture environment and alpha test configuration decoded ahead of time. Sources are resolved to
+ * indices, modifiers to swizzles and operations to specialized combiner functions, so evaluating
+ * a fragment doesn't need to interpret the stage registers.
+ **/
+class TevPipeline {
+public:
+    /// Raw register words the pipeline is built from, used to look it up in a cache. Constant
+    /// colors and the alpha test reference are not part of it, see UpdateUniforms.
+    using Config = std::array<u32, 6 * 4 + 2>;
+
+    TevPipeline() = default;
+    explicit TevPipeline(const Pica::RegsInternal& regs);
+
+    /// Returns the raw configuration of the provided registers.
+    static Config GetConfig(const Pica::RegsInternal& regs);
+
+    const Config& GetConfig() const {
+        return config;
+    }
+
+    /// Updates the values which don't change the structure of the pipeline.
+    void UpdateUniforms(const Pica::RegsInternal& regs);
+
+    /// Emulates the TEV configuration and returns the combiner output.
+    Common::Vec4<u8> Combine(std::span<const Common::Vec4<u8>, 4> texture_color,
+                             Common::Vec4<u8> primary_color,
+                             Common::Vec4<u8> primary_fragment_color,
+                             Common::Vec4<u8> secondary_fragment_color) const;
+
+    /// Performs the alpha test. Returns false if the test failed.
+    bool AlphaTest(u8 alpha) const {
+        return alpha_test_pass[alpha];
+    }
+
+private:
+    struct Modifier {
+        u8 source;
+        u8 component;
+        u8 invert;
+    };
+
+    struct Stage {
+        std::array<Modifier, 9> color_modifiers; // 3 sources, 3 components each
+        std::array<Modifier, 3> alpha_modifiers;
+        ColorCombineFunc color_combine;
+        AlphaCombineFunc alpha_combine;
+        bool dot3_rgba;
+        bool passthrough;
+        bool update_buffer_color;
+        bool update_buffer_alpha;
+        u32 color_multiplier;
+        u32 alpha_multiplier;
+        Common::Vec4<u8> constant;
+    };
+
+    Config config;
+    std::array<Stage, 6> stages;
+    Common::Vec4<u8> combiner_buffer_color;
+    std::array<bool, 256> alpha_test_pass;
+};
+
+} // namespace SwRenderer
@@ -0,0 +1,171 @@
+// Copyright 2024 Encore Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "common/assert.h"
+#include "common/microprofile.h"
+#include "core/memory.h"
+#include "video_core/renderer_software/sw_texture_cache.h"
+
+namespace SwRenderer {
+
+using Pica::Texture::TextureInfo;
+
+MICROPROFILE_DEFINE(SwRenderer_DecodeTexture, "SwRenderer", "Decode Texture",
+                    MP_RGB(100, 100, 255));
+
+// Decoded texels take up to 8 times the memory of the source texture, keep this bounded
+constexpr std::size_t MAX_CACHED_BYTES = 64 * 1024 * 1024;
+
+namespace {
+
+u64 TextureKey(const TextureInfo& info) {
+    return static_cast<u64>(info.physical_address) | static_cast<u64>(info.format) << 32 |
+           static_cast<u64>(info.width) << 36 | static_cast<u64>(info.height) << 47;
+}
+
+} // Anonymous namespace
+
+TextureCache::TextureCache(Memory::MemorySystem& memory_) : memory{memory_} {}
+
+TextureCache::~TextureCache() {
+    Clear();
+}
+
+void TextureCache::BeginDraw() {
+    draw_tick++;
+}
+
+const Common::Vec4<u8>* TextureCache::GetTexture(const TextureInfo& info) {
+    const u64 key = TextureKey(info);
+    if (const auto it = textures.find(key); it != textures.end()) {
+        it->second.last_draw = draw_tick;
+        return it->second.texels.data();
+    }
+
+    const std::size_t tile_size = Pica::Texture::CalculateTileSize(info.format);
+    if (tile_size == 0 || info.width == 0 || info.height == 0 || info.width % 8 != 0 ||
+        info.height % 8 != 0) [[unlikely]] {
+        return nullptr;
+    }
+
+    const u8* source = memory.GetPhysicalPointer(info.physical_address);
+    if (!source) [[unlikely]] {
+        return nullptr;
+    }
+
+    MICROPROFILE_SCOPE(SwRenderer_DecodeTexture);
+
+    Texture texture{
+        .addr = info.physical_address,
+        .size = static_cast<u32>(info.stride * (info.height / 8)),
+        .last_draw = draw_tick,
+        .texels = std::vector<Common::Vec4<u8>>(info.width * info.height),
+    };
+
+    for (u32 coarse_y = 0; coarse_y < info.height / 8; coarse_y++) {
+        const u8* line = source + coarse_y * info.stride;
+        for (u32 coarse_x = 0; coarse_x < info.width / 8; coarse_x++) {
+            const u8* tile = line + coarse_x * tile_size;
+            for (u32 fine_y = 0; fine_y < 8; fine_y++) {
+                auto* dest = &texture.texels[(coarse_y * 8 + fine_y) * info.width + coarse_x * 8];
+                for (u32 fine_x = 0; fine_x < 8; fine_x++) {
+                    dest[fine_x] =
+                        Pica::Texture::LookupTexelInTile(tile, fine_x, fine_y, info, false);
+                }
+            }
+        }
+    }
+
+    UpdatePagesCachedCount(texture.addr, texture.size, 1);
+    cached_bytes += texture.texels.size() * sizeof(Common::Vec4<u8>);
+    const auto* texels = textures.emplace(key, std::move(texture)).first->second.texels.data();
+
+    RunGarbageCollector();
+    return texels;
+}
+
+void TextureCache::InvalidateRegion(PAddr addr, u32 size) {
+    for (auto it = textures.begin(); it != textures.end();) {
+        const auto& texture = it->second;
+        if (texture.addr < addr + size && addr < texture.addr + texture.size) {
+            UpdatePagesCachedCount(texture.addr, texture.size, -1);
+            cached_bytes -= texture.texels.size() * sizeof(Common::Vec4<u8>);
+            it = textures.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void TextureCache::Clear() {
+    // Unmark all of the marked pages
+    for (const auto& [interval, count] : cached_pages) {
+        const PAddr interval_start_addr = boost::icl::first(interval) << Memory::ENCORE_PAGE_BITS;
+        const PAddr interval_end_addr = boost::icl::last_next(interval) << Memory::ENCORE_PAGE_BITS;
+        memory.RasterizerMarkRegionCached(interval_start_addr,
+                                          interval_end_addr - interval_start_addr, false);
+    }
+
+    cached_pages.clear();
+    textures.clear();
+    cached_bytes = 0;
+}
+
+void TextureCache::RunGarbageCollector() {
+    while (cached_bytes > MAX_CACHED_BYTES) {
+        auto oldest = textures.end();
+        for (auto it = textures.begin(); it != textures.end(); ++it) {
+            if (it->second.last_draw != draw_tick &&
+                (oldest == textures.end() || it->second.last_draw < oldest->second.last_draw)) {
+                oldest = it;
+            }
+        }
+
+        // Everything left is used by the current draw
+        if (oldest == textures.end()) {
+            break;
+        }
+
+        UpdatePagesCachedCount(oldest->second.addr, oldest->second.size, -1);
+        cached_bytes -= oldest->second.texels.size() * sizeof(Common::Vec4<u8>);
+        textures.erase(oldest);
+    }
+}
+
+void TextureCache::UpdatePagesCachedCount(PAddr addr, u32 size, int delta) {
+    const u32 num_pages =
+        ((addr + size - 1) >> Memory::ENCORE_PAGE_BITS) - (addr >> Memory::ENCORE_PAGE_BITS) + 1;
+    const u32 page_start = addr >> Memory::ENCORE_PAGE_BITS;
+    const u32 page_end = page_start + num_pages;
+
+    // Interval maps will erase segments if count reaches 0, so if delta is negative we have to
+    // subtract after iterating
+    const auto pages_interval = decltype(cached_pages)::interval_type::right_open(page_start,
+                                                                                 page_end);
+    if (delta > 0) {
+        cached_pages.add({pages_interval, delta});
+    }
+
+    for (const auto& [page_interval, count] : boost::make_iterator_range(
+             cached_pages.equal_range(pages_interval))) {
+        const auto interval = page_interval & pages_interval;
+        const PAddr interval_start_addr = boost::icl::first(interval) << Memory::ENCORE_PAGE_BITS;
+        const PAddr interval_end_addr = boost::icl::last_next(interval) << Memory::ENCORE_PAGE_BITS;
+        const u32 interval_size = interval_end_addr - interval_start_addr;
+
+        if (delta > 0 && count == delta) {
+            memory.RasterizerMarkRegionCached(interval_start_addr, interval_size, true);
+        } else if (delta < 0 && count == -delta) {
+            memory.RasterizerMarkRegionCached(interval_start_addr, interval_size, false);
+        } else {
+            ASSERT(count >= 0);
+        }
+    }
+
+    if (delta < 0) {
+        cached_pages.add({pages_interval, delta});
+    }
+}
+
+} // namespace SwRenderer
@@ -0,0 +1,68 @@
+// Copyright 2024 Encore Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include <boost/icl/interval_map.hpp>
+#include "common/common_types.h"
+#include "common/vector_math.h"
+#include "video_core/texture/texture_decode.h"
+
+namespace Memory {
+class MemorySystem;
+}
+
+namespace SwRenderer {
+
+/**
+ * Caches textures decoded to linear RGBA8, so the rasterizer doesn't have to decode tiled texels
+ * from emulated memory for every sample. The pages backing cached textures are marked as
+ * rasterizer cached, so that any write to them reaches InvalidateRegion.
+ **/
+class TextureCache {
+public:
+    explicit TextureCache(Memory::MemorySystem& memory);
+    ~TextureCache();
+
+    /// Starts a new draw. Textures returned during the current draw will not be evicted.
+    void BeginDraw();
+
+    /**
+     * Returns the texels of the provided texture, decoding it if it is not cached yet.
+     * Texels are stored row by row, in the same coordinate space as Pica::Texture::LookupTexture.
+     * Returns nullptr if the texture can not be decoded.
+     */
+    const Common::Vec4<u8>* GetTexture(const Pica::Texture::TextureInfo& info);
+
+    /// Removes all textures overlapping the provided region.
+    void InvalidateRegion(PAddr addr, u32 size);
+
+    /// Removes all textures from the cache.
+    void Clear();
+
+private:
+    struct Texture {
+        PAddr addr;
+        u32 size;
+        u64 last_draw;
+        std::vector<Common::Vec4<u8>> texels;
+    };
+
+    /// Removes the least recently used textures until the cache fits in its budget.
+    void RunGarbageCollector();
+
+    /// Increase/decrease the number of textures in pages touching the specified region.
+    void UpdatePagesCachedCount(PAddr addr, u32 size, int delta);
+
+private:
+    Memory::MemorySystem& memory;
+    std::unordered_map<u64, Texture> textures;
+    boost::icl::interval_map<u32, int> cached_pages;
+    std::size_t cached_bytes{};
+    u64 draw_tick{};
+};
+
+} // namespace SwRenderer
@@ -50,63 +50,12 @@ int GetWrappedTexCoord(Pica::TexturingRegs::TextureConfig::WrapMode mode, s32 va
     }
 };
 
-Common::Vec3<u8> GetColorModifier(TevStageConfig::ColorModifier factor,
-                                  const Common::Vec4<u8>& values) {
-    using ColorModifier = TevStageConfig::ColorModifier;
+namespace {
 
-    switch (factor) {
-    case ColorModifier::SourceColor:
-        return values.rgb();
-    case ColorModifier::OneMinusSourceColor:
-        return (Common::Vec3<u8>(255, 255, 255) - values.rgb()).Cast<u8>();
-    case ColorModifier::SourceAlpha:
-        return values.aaa();
-    case ColorModifier::OneMinusSourceAlpha:
-        return (Common::Vec3<u8>(255, 255, 255) - values.aaa()).Cast<u8>();
-    case ColorModifier::SourceRed:
-        return values.rrr();
-    case ColorModifier::OneMinusSourceRed:
-        return (Common::Vec3<u8>(255, 255, 255) - values.rrr()).Cast<u8>();
-    case ColorModifier::SourceGreen:
-        return values.ggg();
-    case ColorModifier::OneMinusSourceGreen:
-        return (Common::Vec3<u8>(255, 255, 255) - values.ggg()).Cast<u8>();
-    case ColorModifier::SourceBlue:
-        return values.bbb();
-    case ColorModifier::OneMinusSourceBlue:
-        return (Common::Vec3<u8>(255, 255, 255) - values.bbb()).Cast<u8>();
-    }
-    UNREACHABLE();
-};
-
-u8 GetAlphaModifier(TevStageConfig::AlphaModifier factor, const Common::Vec4<u8>& values) {
-    using AlphaModifier = TevStageConfig::AlphaModifier;
-
-    switch (factor) {
-    case AlphaModifier::SourceAlpha:
-        return values.a();
-    case AlphaModifier::OneMinusSourceAlpha:
-        return 255 - values.a();
-    case AlphaModifier::SourceRed:
-        return values.r();
-    case AlphaModifier::OneMinusSourceRed:
-        return 255 - values.r();
-    case AlphaModifier::SourceGreen:
-        return values.g();
-    case AlphaModifier::OneMinusSourceGreen:
-        return 255 - values.g();
-    case AlphaModifier::SourceBlue:
-        return values.b();
-    case AlphaModifier::OneMinusSourceBlue:
-        return 255 - values.b();
-    }
-    UNREACHABLE();
-};
-
-Common::Vec3<u8> ColorCombine(TevStageConfig::Operation op,
-                              std::span<const Common::Vec3<u8>, 3> input) {
-    using Operation = TevStageConfig::Operation;
+using Operation = TevStageConfig::Operation;
 
+template <Operation op>
+Common::Vec3<u8> ColorCombine(std::span<const Common::Vec3<u8>, 3> input) {
     switch (op) {
     case Operation::Replace:
         return input[0];
@@ -169,15 +118,14 @@ Common::Vec3<u8> ColorCombine(TevStageConfig::Operation op,
         return Common::Vec3{result, result, result}.Cast<u8>();
     }
     default:
-        LOG_ERROR(HW_GPU, "Unknown color combiner operation {}", (int)op);
-        UNIMPLEMENTED();
+        UNREACHABLE();
         return {0, 0, 0};
     }
-};
+}
 
-u8 AlphaCombine(TevStageConfig::Operation op, const std::array<u8, 3>& input) {
+template <Operation op>
+u8 AlphaCombine(std::span<const u8, 3> input) {
     switch (op) {
-        using Operation = TevStageConfig::Operation;
     case Operation::Replace:
         return input[0];
     case Operation::Modulate:
@@ -197,11 +145,66 @@ u8 AlphaCombine(TevStageConfig::Operation op, const std::array<u8, 3>& input) {
         return std::min(255, (input[0] * input[1] + 255 * input[2]) / 255);
     case Operation::AddThenMultiply:
         return (std::min(255, (input[0] + input[1])) * input[2]) / 255;
+    default:
+        UNREACHABLE();
+        return 0;
+    }
+}
+
+} // Anonymous namespace
+
+ColorCombineFunc GetColorCombineFunc(Operation op) {
+    switch (op) {
+    case Operation::Replace:
+        return &ColorCombine<Operation::Replace>;
+    case Operation::Modulate:
+        return &ColorCombine<Operation::Modulate>;
+    case Operation::Add:
+        return &ColorCombine<Operation::Add>;
+    case Operation::AddSigned:
+        return &ColorCombine<Operation::AddSigned>;
+    case Operation::Lerp:
+        return &ColorCombine<Operation::Lerp>;
+    case Operation::Subtract:
+        return &ColorCombine<Operation::Subtract>;
+    case Operation::Dot3_RGB:
+        return &ColorCombine<Operation::Dot3_RGB>;
+    case Operation::Dot3_RGBA:
+        return &ColorCombine<Operation::Dot3_RGBA>;
+    case Operation::MultiplyThenAdd:
+        return &ColorCombine<Operation::MultiplyThenAdd>;
+    case Operation::AddThenMultiply:
+        return &ColorCombine<Operation::AddThenMultiply>;
+    default:
+        LOG_ERROR(HW_GPU, "Unknown color combiner operation {}", (int)op);
+        UNIMPLEMENTED();
+        return [](std::span<const Common::Vec3<u8>, 3>) { return Common::Vec3<u8>{0, 0, 0}; };
+    }
+}
+
+AlphaCombineFunc GetAlphaCombineFunc(Operation op) {
+    switch (op) {
+    case Operation::Replace:
+        return &AlphaCombine<Operation::Replace>;
+    case Operation::Modulate:
+        return &AlphaCombine<Operation::Modulate>;
+    case Operation::Add:
+        return &AlphaCombine<Operation::Add>;
+    case Operation::AddSigned:
+        return &AlphaCombine<Operation::AddSigned>;
+    case Operation::Lerp:
+        return &AlphaCombine<Operation::Lerp>;
+    case Operation::Subtract:
+        return &AlphaCombine<Operation::Subtract>;
+    case Operation::MultiplyThenAdd:
+        return &AlphaCombine<Operation::MultiplyThenAdd>;
+    case Operation::AddThenMultiply:
+        return &AlphaCombine<Operation::AddThenMultiply>;
     default:
         LOG_ERROR(HW_GPU, "Unknown alpha combiner operation {}", (int)op);
         UNIMPLEMENTED();
-        return 0;
+        return [](std::span<const u8, 3>) -> u8 { return 0; };
     }
-};
+}
 
 } // namespace SwRenderer
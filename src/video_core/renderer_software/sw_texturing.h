@@ -14,15 +14,13 @@ namespace SwRenderer {
 
 int GetWrappedTexCoord(Pica::TexturingRegs::TextureConfig::WrapMode mode, s32 val, u32 size);
 
-Common::Vec3<u8> GetColorModifier(Pica::TexturingRegs::TevStageConfig::ColorModifier factor,
-                                  const Common::Vec4<u8>& values);
+using ColorCombineFunc = Common::Vec3<u8> (*)(std::span<const Common::Vec3<u8>, 3> input);
+using AlphaCombineFunc = u8 (*)(std::span<const u8, 3> input);
 
-u8 GetAlphaModifier(Pica::TexturingRegs::TevStageConfig::AlphaModifier factor,
-                    const Common::Vec4<u8>& values);
+/// Returns the color combiner function specialized for the provided operation.
+ColorCombineFunc GetColorCombineFunc(Pica::TexturingRegs::TevStageConfig::Operation op);
 
-Common::Vec3<u8> ColorCombine(Pica::TexturingRegs::TevStageConfig::Operation op,
-                              std::span<const Common::Vec3<u8>, 3> input);
-
-u8 AlphaCombine(Pica::TexturingRegs::TevStageConfig::Operation op, const std::array<u8, 3>& input);
+/// Returns the alpha combiner function specialized for the provided operation.
+AlphaCombineFunc GetAlphaCombineFunc(Pica::TexturingRegs::TevStageConfig::Operation op);
 
 } // namespace SwRenderer
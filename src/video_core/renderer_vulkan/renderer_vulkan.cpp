@@ -53,7 +53,7 @@ constexpr static std::array<vk::DescriptorSetLayoutBinding, 1> PRESENT_BINDINGS
 RendererVulkan::RendererVulkan(Core::System& system, Pica::PicaCore& pica_,
                                Frontend::EmuWindow& window, Frontend::EmuWindow* secondary_window)
     : RendererBase{system, window, secondary_window}, memory{system.Memory()}, pica{pica_},
-      instance{system.TelemetrySession(), window, Settings::values.physical_device.GetValue()},
+      instance{system.TelemetrySession(), window, Settings::values().physical_device.GetValue()},
       scheduler{instance}, renderpass_cache{instance, scheduler}, pool{instance},
       main_window{window, instance, scheduler},
       vertex_buffer{instance, scheduler, vk::BufferUsageFlagBits::eVertexBuffer,
@@ -126,7 +126,7 @@ void RendererVulkan::PrepareRendertarget() {
 }
 
 void RendererVulkan::PrepareDraw(Frame* frame, const Layout::FramebufferLayout& layout) {
-    const auto sampler = present_samplers[!Settings::values.filter_mode.GetValue()];
+    const auto sampler = present_samplers[!Settings::values().filter_mode.GetValue()];
     std::transform(screen_infos.begin(), screen_infos.end(), present_textures.begin(),
                    [&](auto& info) {
                        return DescriptorData{vk::DescriptorImageInfo{sampler, info.image_view,
@@ -515,7 +515,7 @@ void RendererVulkan::FillScreen(Common::Vec3<u8> color, const TextureInfo& textu
 }
 
 void RendererVulkan::ReloadPipeline() {
-    const Settings::StereoRenderOption render_3d = Settings::values.render_3d.GetValue();
+    const Settings::StereoRenderOption render_3d = Settings::values().render_3d.GetValue();
     switch (render_3d) {
     case Settings::StereoRenderOption::Anaglyph:
         current_pipeline = 1;
@@ -688,9 +688,9 @@ void RendererVulkan::DrawTopScreen(const Layout::FramebufferLayout& layout,
 
     const auto orientation = layout.is_rotated ? Layout::DisplayOrientation::Landscape
                                                : Layout::DisplayOrientation::Portrait;
-    switch (Settings::values.render_3d.GetValue()) {
+    switch (Settings::values().render_3d.GetValue()) {
     case Settings::StereoRenderOption::Off: {
-        const int eye = static_cast<int>(Settings::values.mono_render_option.GetValue());
+        const int eye = static_cast<int>(Settings::values().mono_render_option.GetValue());
         DrawSingleScreen(eye, top_screen_left, top_screen_top, top_screen_width, top_screen_height,
                          orientation);
         break;
@@ -736,7 +736,7 @@ void RendererVulkan::DrawBottomScreen(const Layout::FramebufferLayout& layout,
     const auto orientation = layout.is_rotated ? Layout::DisplayOrientation::Landscape
                                                : Layout::DisplayOrientation::Portrait;
 
-    switch (Settings::values.render_3d.GetValue()) {
+    switch (Settings::values().render_3d.GetValue()) {
     case Settings::StereoRenderOption::Off: {
         DrawSingleScreen(2, bottom_screen_left, bottom_screen_top, bottom_screen_width,
                          bottom_screen_height, orientation);
@@ -773,9 +773,9 @@ void RendererVulkan::DrawBottomScreen(const Layout::FramebufferLayout& layout,
 void RendererVulkan::DrawScreens(Frame* frame, const Layout::FramebufferLayout& layout,
                                  bool flipped) {
     if (settings.bg_color_update_requested.exchange(false)) {
-        clear_color.float32[0] = Settings::values.bg_red.GetValue();
-        clear_color.float32[1] = Settings::values.bg_green.GetValue();
-        clear_color.float32[2] = Settings::values.bg_blue.GetValue();
+        clear_color.float32[0] = Settings::values().bg_red.GetValue();
+        clear_color.float32[1] = Settings::values().bg_green.GetValue();
+        clear_color.float32[2] = Settings::values().bg_blue.GetValue();
     }
     if (settings.shader_update_requested.exchange(false)) {
         ReloadPipeline();
@@ -788,7 +788,7 @@ void RendererVulkan::DrawScreens(Frame* frame, const Layout::FramebufferLayout&
     draw_info.modelview = MakeOrthographicMatrix(layout.width, layout.height);
 
     draw_info.layer = 0;
-    if (!Settings::values.swap_screen.GetValue()) {
+    if (!Settings::values().swap_screen.GetValue()) {
         DrawTopScreen(layout, top_screen);
         draw_info.layer = 0;
         DrawBottomScreen(layout, bottom_screen);
@@ -800,7 +800,7 @@ void RendererVulkan::DrawScreens(Frame* frame, const Layout::FramebufferLayout&
 
     if (layout.additional_screen_enabled) {
         const auto& additional_screen = layout.additional_screen;
-        if (!Settings::values.swap_screen.GetValue()) {
+        if (!Settings::values().swap_screen.GetValue()) {
             DrawTopScreen(layout, additional_screen);
         } else {
             DrawBottomScreen(layout, additional_screen);
@@ -837,7 +837,7 @@ void RendererVulkan::SwapBuffers() {
     PrepareRendertarget();
     RenderScreenshot();
     RenderToWindow(main_window, layout, false);
-    if (Settings::values.layout_option.GetValue() == Settings::LayoutOption::SeparateWindows) {
+    if (Settings::values().layout_option.GetValue() == Settings::LayoutOption::SeparateWindows) {
         ASSERT(secondary_window);
         const auto& secondary_layout = secondary_window->GetFramebufferLayout();
         if (!second_window) {
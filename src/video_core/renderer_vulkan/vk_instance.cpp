@@ -142,8 +142,8 @@ Instance::Instance(Core::TelemetrySession& telemetry, Frontend::EmuWindow& windo
                    u32 physical_device_index)
     : library{OpenLibrary(&window)},
       instance{CreateInstance(*library, window.GetWindowInfo().type,
-                              Settings::values.renderer_debug.GetValue(),
-                              Settings::values.dump_command_buffers.GetValue())},
+                              Settings::values().renderer_debug.GetValue(),
+                              Settings::values().dump_command_buffers.GetValue())},
       debug_callback{CreateDebugCallback(*instance, debug_utils_supported)},
       physical_devices{instance->enumeratePhysicalDevices()} {
     const std::size_t num_physical_devices = static_cast<u16>(physical_devices.size());
@@ -125,7 +125,7 @@ PipelineCache::~PipelineCache() {
 }
 
 void PipelineCache::LoadDiskCache() {
-    if (!Settings::values.use_disk_shader_cache || !EnsureDirectories()) {
+    if (!Settings::values().use_disk_shader_cache || !EnsureDirectories()) {
         return;
     }
 
@@ -168,7 +168,7 @@ void PipelineCache::LoadDiskCache() {
 }
 
 void PipelineCache::SaveDiskCache() {
-    if (!Settings::values.use_disk_shader_cache || !EnsureDirectories() || !pipeline_cache) {
+    if (!Settings::values().use_disk_shader_cache || !EnsureDirectories() || !pipeline_cache) {
         return;
     }
 
@@ -480,7 +480,7 @@ void PipelineCache::UseFragmentShader(const Pica::RegsInternal& regs,
 
     if (new_shader) {
         workers.QueueWork([fs_config, this, &shader]() {
-            const bool use_spirv = Settings::values.spirv_shader_gen.GetValue();
+            const bool use_spirv = Settings::values().spirv_shader_gen.GetValue();
             if (use_spirv && !fs_config.UsesShadowPipeline()) {
                 const std::vector code = SPIRV::GenerateFragmentShader(fs_config, profile);
                 shader.module = CompileSPV(code, instance.GetDevice());
@@ -307,7 +307,7 @@ vk::UniqueInstance CreateInstance(const Common::DynamicLibrary& library,
 #ifdef __APPLE__
     // Use synchronous queue submits if async presentation is enabled, to avoid threading
     // indirection.
-    const auto synchronous_queue_submits = Settings::values.async_presentation.GetValue();
+    const auto synchronous_queue_submits = Settings::values().async_presentation.GetValue();
     // If the device is lost, make an attempt to resume if possible to avoid crashes.
     constexpr auto resume_lost_device = true;
     // Maximize concurrency to improve shader compilation performance.
@@ -368,7 +368,7 @@ vk::UniqueDebugReportCallbackEXT CreateDebugReportCallback(vk::Instance instance
 }
 
 DebugCallback CreateDebugCallback(vk::Instance instance, bool& debug_utils_supported) {
-    if (!Settings::values.renderer_debug) {
+    if (!Settings::values().renderer_debug) {
         return {};
     }
     const auto properties = vk::enumerateInstanceExtensionProperties();
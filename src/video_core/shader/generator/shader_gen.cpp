@@ -44,7 +44,7 @@ void PicaVSConfigState::Init(const Pica::RegsInternal& regs, Pica::ShaderSetup&
     program_hash = setup.GetProgramCodeHash();
     swizzle_hash = setup.GetSwizzleDataHash();
     main_offset = regs.vs.main_offset;
-    sanitize_mul = Settings::values.shaders_accurate_mul.GetValue();
+    sanitize_mul = Settings::values().shaders_accurate_mul.GetValue();
 
     num_outputs = 0;
     load_flags.fill(AttribLoadFlags::Float);
@@ -5,10 +5,13 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include "common/common_types.h"
+#include "video_core/pica/output_vertex.h"
 
 namespace Pica {
 
+struct ShaderRegs;
 struct ShaderSetup;
 struct ShaderUnit;
 
@@ -29,6 +32,21 @@ public:
      * @param state Shader unit state, must be setup with input data before each shader invocation.
      */
     virtual void Run(const ShaderSetup& setup, ShaderUnit& state) const = 0;
+
+    /**
+     * Runs the currently setup shader over a batch of vertices. The vertices are processed in
+     * order on the same shader unit, so any state left over by one vertex is seen by the next,
+     * exactly like loading each input and calling `Run` in turn.
+     *
+     * @param setup Shader engine state, must be setup with SetupBatch on each shader change.
+     * @param state Shader unit state, the inputs and outputs are mapped by `config`.
+     * @param config Shader configuration used to load the inputs and write the outputs.
+     * @param inputs Input attributes of each vertex.
+     * @param outputs Output attributes of each vertex, must be as large as `inputs`.
+     */
+    virtual void RunBatch(const ShaderSetup& setup, ShaderUnit& state, const ShaderRegs& config,
+                          std::span<const AttributeBuffer> inputs,
+                          std::span<AttributeBuffer> outputs) const = 0;
 };
 
 std::unique_ptr<ShaderEngine> CreateEngine(bool use_jit);
@@ -8,6 +8,7 @@
 #include "common/assert.h"
 #include "common/hash.h"
 #include "common/microprofile.h"
+#include "video_core/pica/shader_unit.h"
 #include "video_core/shader/shader.h"
 #include "video_core/shader/shader_jit.h"
 #if ENCORE_ARCH(arm64)
@@ -52,6 +53,22 @@ void JitEngine::Run(const ShaderSetup& setup, ShaderUnit& state) const {
     shader->Run(setup, state, setup.entry_point);
 }
 
+void JitEngine::RunBatch(const ShaderSetup& setup, ShaderUnit& state, const ShaderRegs& config,
+                         std::span<const AttributeBuffer> inputs,
+                         std::span<AttributeBuffer> outputs) const {
+    ASSERT(setup.cached_shader != nullptr);
+    ASSERT(outputs.size() >= inputs.size());
+
+    MICROPROFILE_SCOPE(GPU_Shader);
+
+    const JitShader* shader = static_cast<const JitShader*>(setup.cached_shader);
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        state.LoadInput(config, inputs[i]);
+        shader->Run(setup, state, setup.entry_point);
+        state.WriteOutput(config, outputs[i]);
+    }
+}
+
 } // namespace Pica::Shader
 
 #endif // ENCORE_ARCH(x86_64) || ENCORE_ARCH(arm64)
@@ -23,6 +23,9 @@ public:
 
     void SetupBatch(ShaderSetup& setup, u32 entry_point) override;
     void Run(const ShaderSetup& setup, ShaderUnit& state) const override;
+    void RunBatch(const ShaderSetup& setup, ShaderUnit& state, const ShaderRegs& config,
+                  std::span<const AttributeBuffer> inputs,
+                  std::span<AttributeBuffer> outputs) const override;
 
 private:
     std::unordered_map<u64, std::unique_ptr<JitShader>> cache;